@@ -0,0 +1,187 @@
+// *****************************************************************************
+// Copyright 2024 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+// *****************************************************************************
+// node conversion.js -h
+//
+// Micro-benchmark for the per-record cost of converting records and policies
+// between JavaScript and the C client. Run it once against a build of the
+// baseline and once against a build with the change under test.
+//
+// The end-to-end time of each command is dominated by the network and the
+// server, so the conversion time is reported separately: it is taken from the
+// client's latency histograms (see Client#stats), whose "request" phase covers
+// converting the arguments and whose "response" phase covers converting the
+// result. Only these per-record conversion times are comparable across runs.
+// *****************************************************************************
+
+const Aerospike = require('aerospike')
+const yargs = require('yargs')
+
+const exp = Aerospike.exp
+
+// *****************************************************************************
+// Options Parsing
+// *****************************************************************************
+
+const argp = yargs
+  .usage('$0 [options]')
+  .options({
+    help: {
+      boolean: true,
+      describe: 'Display this message.'
+    },
+    host: {
+      alias: 'h',
+      default: '127.0.0.1',
+      describe: 'Aerospike database address.'
+    },
+    port: {
+      alias: 'p',
+      default: 3000,
+      describe: 'Aerospike database port.'
+    },
+    namespace: {
+      alias: 'n',
+      default: 'test',
+      describe: 'Key namespace.'
+    },
+    set: {
+      alias: 's',
+      default: 'conversion',
+      describe: 'Key set.'
+    },
+    records: {
+      alias: 'r',
+      default: 5000,
+      describe: 'Number of records per batch.'
+    },
+    iterations: {
+      alias: 'i',
+      default: 20,
+      describe: 'Number of timed iterations per benchmark.'
+    },
+    bins: {
+      alias: 'b',
+      default: 10,
+      describe: 'Number of bins per record.'
+    }
+  })
+
+const argv = argp.argv
+
+if (argv.help === true) {
+  argp.showHelp()
+  process.exit()
+}
+
+// *****************************************************************************
+// Functions
+// *****************************************************************************
+
+function generateBins (i) {
+  const bins = {}
+  for (let b = 0; b < argv.bins; b++) {
+    bins['b' + b] = (b % 2 === 0) ? i * b : 'value-' + i + '-' + b
+  }
+  return bins
+}
+
+function generateMixedBins (i) {
+  return {
+    int: i,
+    big: 2 ** 40 + i,
+    float: i + 0.5,
+    double: new Aerospike.Double(i),
+    str: 'value-' + i,
+    blob: Buffer.from([i & 0xff, 1, 2, 3]),
+    geo: new Aerospike.GeoJSON({ type: 'Point', coordinates: [103.9, 1.3] }),
+    list: [i, 'a', 1.5, [1, 2, { x: i }], { y: 'z' }],
+    map: { a: i, b: 'b', c: [1, 2.5, 'c'], d: { e: new Aerospike.Double(1), f: [{ g: i }] } }
+  }
+}
+
+// Returns the total time recorded in a latency histogram, in µs.
+function totalTime (histogram) {
+  return histogram.count > 0 ? histogram.mean * histogram.count : 0
+}
+
+async function measure (client, name, command, count, fn) {
+  await fn() // warm-up
+  client.resetStats()
+  const start = process.hrtime.bigint()
+  for (let i = 0; i < argv.iterations; i++) {
+    await fn()
+  }
+  const elapsed = Number(process.hrtime.bigint() - start) / 1e3
+  const records = argv.iterations * count
+  const latency = client.stats().latency[command]
+  const conversion = totalTime(latency.request) + totalTime(latency.response)
+  console.log('%s: %s µs/record conversion, %s µs/record total',
+    name.padEnd(32), (conversion / records).toFixed(3),
+    (elapsed / records).toFixed(3))
+}
+
+async function run (client) {
+  const keys = []
+  for (let i = 0; i < argv.records; i++) {
+    keys.push(new Aerospike.Key(argv.namespace, argv.set, i))
+  }
+  await Promise.all(keys.map((key, i) => client.put(key, generateBins(i))))
+
+  const batchRecords = keys.map(key => ({ type: Aerospike.batchType.BATCH_READ, key, readAllBins: true }))
+  await measure(client, 'batchRead (all bins)', 'batch', keys.length, () => client.batchRead(batchRecords))
+  await measure(client, 'batchGet (all bins)', 'batch', keys.length, () => client.batchGet(keys))
+
+  const policy = new Aerospike.ReadPolicy({
+    totalTimeout: 1000,
+    socketTimeout: 500,
+    filterExpression: exp.and(exp.ge(exp.binInt('b0'), exp.int(0)), exp.binExists('b1'))
+  })
+  await measure(client, 'get (with filter policy)', 'get', keys.length,
+    () => Promise.all(keys.map(key => client.get(key, policy))))
+
+  const compiledPolicy = new Aerospike.ReadPolicy({
+    totalTimeout: 1000,
+    socketTimeout: 500,
+    filterExpression: exp.compile(policy.filterExpression)
+  })
+  await measure(client, 'get (with compiled filter)', 'get', keys.length,
+    () => Promise.all(keys.map(key => client.get(key, compiledPolicy))))
+
+  const frozenPolicy = Aerospike.policy.freeze('read', compiledPolicy)
+  await measure(client, 'get (with frozen policy)', 'get', keys.length,
+    () => Promise.all(keys.map(key => client.get(key, frozenPolicy))))
+
+  const mixedBins = keys.map((key, i) => generateMixedBins(i))
+  await measure(client, 'put (mixed bins, nested CDTs)', 'put', keys.length,
+    () => Promise.all(keys.map((key, i) => client.put(key, mixedBins[i]))))
+  await measure(client, 'batchRead (mixed bins, nested CDTs)', 'batch', keys.length,
+    () => client.batchRead(batchRecords))
+
+  await Promise.all(keys.map(key => client.remove(key)))
+}
+
+// *****************************************************************************
+// Main
+// *****************************************************************************
+
+Aerospike.connect({ hosts: [{ addr: argv.host, port: argv.port }] })
+  .then(client => run(client).finally(() => client.close()))
+  .catch(error => {
+    console.error('Error:', error)
+    process.exit(1)
+  })
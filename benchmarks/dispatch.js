@@ -0,0 +1,132 @@
+// *****************************************************************************
+// Copyright 2024 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+// *****************************************************************************
+// node dispatch.js -h
+//
+// Micro-benchmark for the native dispatch cost of single-record commands, i.e.
+// the time spent synchronously in client.get / client.put before control
+// returns to JavaScript. Commands are only awaited after the timer is
+// stopped, so network latency is excluded. Run it once against a build of the
+// baseline and once against a build with the change under test.
+// *****************************************************************************
+
+const Aerospike = require('aerospike')
+const yargs = require('yargs')
+
+// *****************************************************************************
+// Options Parsing
+// *****************************************************************************
+
+const argp = yargs
+  .usage('$0 [options]')
+  .options({
+    help: {
+      boolean: true,
+      describe: 'Display this message.'
+    },
+    host: {
+      alias: 'h',
+      default: '127.0.0.1',
+      describe: 'Aerospike database address.'
+    },
+    port: {
+      alias: 'p',
+      default: 3000,
+      describe: 'Aerospike database port.'
+    },
+    namespace: {
+      alias: 'n',
+      default: 'test',
+      describe: 'Key namespace.'
+    },
+    set: {
+      alias: 's',
+      default: 'dispatch',
+      describe: 'Key set.'
+    },
+    records: {
+      alias: 'r',
+      default: 1000,
+      describe: 'Number of commands per iteration.'
+    },
+    iterations: {
+      alias: 'i',
+      default: 50,
+      describe: 'Number of timed iterations per benchmark.'
+    },
+    asyncResources: {
+      boolean: true,
+      default: true,
+      describe: 'Create an async resource per command; use --no-asyncResources to disable.'
+    }
+  })
+
+const argv = argp.argv
+
+if (argv.help === true) {
+  argp.showHelp()
+  process.exit()
+}
+
+// *****************************************************************************
+// Functions
+// *****************************************************************************
+
+async function measure (name, keys, fn) {
+  const pending = new Array(keys.length)
+  let elapsed = 0n
+  for (let i = 0; i <= argv.iterations; i++) {
+    const start = process.hrtime.bigint()
+    for (let k = 0; k < keys.length; k++) {
+      pending[k] = fn(keys[k], k)
+    }
+    const end = process.hrtime.bigint()
+    await Promise.all(pending)
+    if (i > 0) elapsed += end - start // first iteration is the warm-up
+  }
+  const perCommand = Number(elapsed) / (argv.iterations * keys.length)
+  console.log('%s: %s ns/command', name.padEnd(32), perCommand.toFixed(0))
+}
+
+async function run (client) {
+  Aerospike.setAsyncResourcesEnabled(argv.asyncResources)
+
+  const keys = []
+  for (let i = 0; i < argv.records; i++) {
+    keys.push(new Aerospike.Key(argv.namespace, argv.set, i))
+  }
+  const bins = { i: 1, s: 'value' }
+
+  await measure('put (dispatch)', keys, key => client.put(key, bins))
+  await measure('get (dispatch)', keys, key => client.get(key))
+  await measure('get callback (dispatch)', keys,
+    key => new Promise((resolve, reject) =>
+      client.get(key, (error, record) => error ? reject(error) : resolve(record))))
+
+  await Promise.all(keys.map(key => client.remove(key)))
+}
+
+// *****************************************************************************
+// Main
+// *****************************************************************************
+
+Aerospike.connect({ hosts: [{ addr: argv.host, port: argv.port }] })
+  .then(client => run(client).finally(() => client.close()))
+  .catch(error => {
+    console.error('Error:', error)
+    process.exit(1)
+  })
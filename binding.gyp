@@ -68,6 +68,9 @@
         'src/main/aerospike.cc',
         'src/main/client.cc',
         'src/main/transaction.cc',
+        'src/main/compiled_expression.cc',
+        'src/main/frozen_policy.cc',
+        'src/main/prepared_operations.cc',
         'src/main/config.cc',
         'src/main/events.cc',
         'src/main/cdt_ctx.cc',
@@ -92,6 +95,7 @@
         'src/main/commands/batch_get.cc',
         'src/main/commands/batch_select.cc',
         'src/main/commands/batch_read_async.cc',
+        'src/main/commands/batch_read_uniform.cc',
         'src/main/commands/batch_remove.cc',
         'src/main/commands/batch_apply.cc',
         'src/main/commands/batch_write_async.cc',
@@ -164,6 +168,14 @@
         'src/main/util/conversions.cc',
         'src/main/util/conversions_batch.cc',
         'src/main/util/log.cc',
+        'src/main/util/latency.cc',
+        'src/main/util/record_cache.cc',
+        'src/main/util/property_names.cc',
+        'src/main/util/result_classes.cc',
+        'src/main/util/value_classes.cc',
+        'src/main/util/arena.cc',
+        'src/main/util/value_queue.cc',
+        'src/main/util/memory_accounting.cc',
       ],
       'configurations': {
         'Release': {
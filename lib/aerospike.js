@@ -302,6 +302,16 @@ exports.Key = require('./key')
  */
 exports.Record = require('./record')
 
+/**
+ * The result of a single key in a batch command.
+ *
+ * @summary {@link BatchResult} class
+ */
+exports.BatchResult = require('./batch_result')
+
+// Command results are constructed natively as instances of these classes.
+as.register_result_classes(exports.Key, exports.Record, exports.BatchResult)
+
 /**
  * In the Aerospike database, each record (similar to a row in a relational database) stores
  * data using one or more bins (like columns in a relational database).
@@ -310,6 +320,9 @@ exports.Record = require('./record')
  */
 exports.Bin = require('./bin')
 
+// Bin values are checked natively against these classes.
+as.register_value_classes(exports.Double, exports.GeoJSON, exports.Bin)
+
 /**
  * Scan class return by the {@link Client#scan} method.
  *
@@ -713,6 +726,76 @@ exports.setDefaultLogging = function (logInfo) {
   as.setDefaultLogging(logInfo)
 }
 
+/**
+ * @summary Enables or disables asynchronous logging. (Disabled by default.)
+ *
+ * @description While async logging is enabled, log lines of all clients and
+ * of the Aerospike C client SDK are formatted into an in-memory buffer and
+ * written to their log files by a background thread, instead of being
+ * written synchronously by the thread that logs them. This makes verbose
+ * log levels usable under load.
+ *
+ * If the buffer is full, new lines are dropped; the number of dropped lines
+ * is reported by {@link module:aerospike.getAsyncLoggingStats}. Set
+ * <code>block</code> to wait for buffer space instead.
+ *
+ * Lines still in the buffer are written when the process exits.
+ *
+ * @param {Object} [options]
+ * @param {boolean} [options.enabled=true] - Whether to log asynchronously.
+ * @param {number} [options.bufferSize=1024] - Number of log lines the
+ * buffer holds. Only used the first time async logging is enabled.
+ * @param {boolean} [options.block=false] - Wait for space in a full buffer
+ * instead of dropping lines.
+ *
+ * @since v6.4.0
+ *
+ * @example
+ *
+ * const Aerospike = require('aerospike')
+ *
+ * Aerospike.setAsyncLogging({ bufferSize: 8192 })
+ * Aerospike.setDefaultLogging({ level: Aerospike.log.DEBUG })
+ */
+exports.setAsyncLogging = function (options = {}) {
+  const { enabled = true, bufferSize = 1024, block = false } = options
+  as.setAsyncLogging(enabled, bufferSize, block)
+}
+
+/**
+ * @summary Returns statistics about asynchronous logging.
+ *
+ * @returns {Object} An object with a <code>dropped</code> property, the
+ * number of log lines dropped because the async logging buffer was full.
+ *
+ * @since v6.4.0
+ */
+exports.getAsyncLoggingStats = function () {
+  return as.getAsyncLoggingStats()
+}
+
+/**
+ * @summary Enables or disables async resources for client commands. (Enabled
+ * by default.)
+ *
+ * @description By default, every command creates an async resource, so that
+ * <code>async_hooks</code> and <code>AsyncLocalStorage</code> can follow the
+ * command from the call to its callback. Applications that use neither can
+ * turn this off to save the cost of creating the resource and emitting its
+ * init and destroy events for every command. Command callbacks are then
+ * called without async context. Promises returned by client commands are not
+ * affected.
+ *
+ * The setting applies to commands started afterwards on the current thread.
+ *
+ * @param {boolean} enabled - Whether to create an async resource per command.
+ *
+ * @since v6.4.0
+ */
+exports.setAsyncResourcesEnabled = function (enabled) {
+  as.setAsyncResourcesEnabled(enabled)
+}
+
 /**
  * @summary Configures the global command queue. (Disabled by default.)
  *
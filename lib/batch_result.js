@@ -0,0 +1,55 @@
+// *****************************************************************************
+// Copyright 2023 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+'use strict'
+
+/**
+ * @class BatchResult
+ * @classdesc Result of a single key in a batch command.
+ *
+ * @summary Construct a new BatchResult instance.
+ *
+ * @since v6.4.0
+ */
+class BatchResult {
+  /** @private */
+  constructor (status, record, inDoubt) {
+    /**
+     * Result code for this record.
+     *
+     * @member {number} BatchResult#status
+     */
+    this.status = status
+
+    /**
+     * Record result for the requested key. Bins and metadata are only
+     * populated if the status is {@link status.AEROSPIKE_OK|AEROSPIKE_OK}.
+     *
+     * @member {Record} BatchResult#record
+     */
+    this.record = record
+
+    /**
+     * Whether a write command may have completed even though the client
+     * returned an error.
+     *
+     * @member {boolean} BatchResult#inDoubt
+     */
+    this.inDoubt = inDoubt
+  }
+}
+
+module.exports = BatchResult
@@ -33,6 +33,7 @@ const Config = require('./config')
 const EventLoop = require('./event_loop')
 const IndexJob = require('./index_job')
 const Query = require('./query')
+const ReadBatcher = require('./read_batcher')
 const Scan = require('./scan')
 const UdfJob = require('./udf_job')
 const operations = require('./operations')
@@ -155,6 +156,15 @@ function Client (config) {
   /** @private */
   this.connected = false
 
+  /**
+   * Set while the connection is being established; the arguments of a
+   * close() call made in the meantime, once it has been.
+   *
+   * @private
+   */
+  this.connecting = false
+  this.pendingClose = null
+
   /**
    * @name Client#captureStackTraces
    *
@@ -181,6 +191,9 @@ function Client (config) {
    * <code>false</code> otherwise.
    */
   this.captureStackTraces = !!process.env.AEROSPIKE_DEBUG_STACKTRACES
+
+  /** @private */
+  this.readBatcher = this.config.readBatching ? new ReadBatcher(this, this.config.readBatching) : null
 }
 
 util.inherits(Client, EventEmitter)
@@ -1483,6 +1496,190 @@ Client.prototype.batchRead = function (records, policy, callback) {
   return cmd.execute()
 }
 
+/**
+ * @function Client#batchReadStream
+ *
+ * @summary Reads multiple records, delivering the results in parts as they
+ * arrive.
+ *
+ * @description The batch is split into sub-batches of at most
+ * <code>chunkSize</code> records, which are sent concurrently. The results
+ * of each sub-batch are yielded as soon as it completes, so that processing
+ * can start before the whole batch has been read, and a slow sub-batch does
+ * not hold back the results of the others. Sub-batches complete in any
+ * order; the <code>index</code> of each part is the position of its first
+ * result in <code>records</code>.
+ *
+ * At most <code>concurrency</code> sub-batches are in flight or waiting to
+ * be consumed at any time, which bounds the number of results held in
+ * memory. If a sub-batch fails as a whole, iteration ends with its error.
+ *
+ * This method requires server >= 6.0.0.
+ *
+ * @param {object[]} records - List of {@link BatchReadRecord} instances, as
+ * for {@link Client#batchRead}.
+ * @param {BatchPolicy} [policy] - The Batch Policy to use for each sub-batch.
+ * @param {Object} [options] - Streaming options.
+ * @param {number} [options.chunkSize=1000] - Maximum number of records per
+ * sub-batch.
+ * @param {number} [options.concurrency=4] - Maximum number of sub-batches in
+ * flight or awaiting consumption.
+ * @returns {AsyncIterable<{index: number, results: BatchResult[]}>} The
+ * results of the sub-batches, in the order in which they complete.
+ *
+ * @example
+ *
+ * const Aerospike = require('aerospike')
+ *
+ * ;(async () => {
+ *   const client = await Aerospike.connect({ hosts: '192.168.33.10:3000' })
+ *   const records = []
+ *   for (let i = 0; i < 100000; i++) {
+ *     records.push({ key: new Aerospike.Key('test', 'demo', i), readAllBins: true })
+ *   }
+ *   for await (const { index, results } of client.batchReadStream(records)) {
+ *     console.log('received %d results starting at %d', results.length, index)
+ *   }
+ *   await client.close()
+ * })()
+ *
+ * @since v6.4.0
+ */
+Client.prototype.batchReadStream = function (records, policy, options) {
+  options = options || {}
+  const chunkSize = options.chunkSize || 1000
+  const concurrency = options.concurrency || 4
+  if (!Number.isInteger(chunkSize) || chunkSize < 1) {
+    throw new TypeError('chunkSize must be a positive integer')
+  }
+  if (!Number.isInteger(concurrency) || concurrency < 1) {
+    throw new TypeError('concurrency must be a positive integer')
+  }
+
+  const cmd = new Commands.BatchRead(this, [records, policy || null])
+  return cmd.stream(chunkSize, concurrency)
+}
+
+/**
+ * @function Client#batchReadUniform
+ *
+ * @summary Reads the same bins, or executes the same read operations, for a
+ * batch of records.
+ *
+ * @description Unlike {@link Client#batchRead}, which converts the bins,
+ * operations and policy of every batch record separately, this method
+ * converts them once and shares them between all keys. The server receives
+ * them only once per node as well.
+ *
+ * This method requires server >= 6.0.0.
+ *
+ * @param {Key[]} keys - An array of keys, used to locate the records in the cluster.
+ * @param {Object} read - What to read for every key.
+ * @param {string[]} [read.bins] - The bins to read.
+ * @param {module:aerospike/operations~Operation[]} [read.ops] - The read
+ * operations to execute; cannot be combined with <code>bins</code>.
+ * @param {boolean} [read.readAllBins=false] - Whether to read all bins.
+ * @param {BatchReadPolicy} [read.policy] - The policy of every read.
+ * @param {BatchPolicy} [policy] - The Batch Policy to use for this operation.
+ * @param {batchRecordsCallback} [callback] - The function to call when
+ * the operation completes, with the results of the batch operation.
+ *
+ * @returns {?Promise} - If no callback function is passed, the function
+ * returns a Promise that resolves to the results of the batch operation.
+ *
+ * @example
+ *
+ * const Aerospike = require('aerospike')
+ * const op = Aerospike.operations
+ * const lists = Aerospike.lists
+ *
+ * ;(async () => {
+ *   const client = await Aerospike.connect({ hosts: '192.168.33.10:3000' })
+ *   const keys = [1, 2, 3].map(i => new Aerospike.Key('test', 'demo', i))
+ *
+ *   const profiles = await client.batchReadUniform(keys, { bins: ['name', 'email'] })
+ *   const latest = await client.batchReadUniform(keys, {
+ *     ops: [lists.getByIndex('events', -1, lists.returnType.VALUE)]
+ *   })
+ *   await client.close()
+ * })()
+ *
+ * @since v6.4.0
+ */
+Client.prototype.batchReadUniform = function (keys, read, policy, callback) {
+  if (typeof policy === 'function') {
+    callback = policy
+    policy = null
+  }
+
+  const cmd = new Commands.BatchReadUniform(this, [keys, read, policy], callback)
+  return cmd.execute()
+}
+
+/**
+ * @function Client#batchReadDigests
+ *
+ * @summary Reads a batch of records of one set, identified by their
+ * digests.
+ *
+ * @description The keys are given as a single Buffer of packed 20-byte
+ * digests, e.g. as stored by an application that already keeps the digests
+ * of its records, instead of as an array of {@link Key} objects. The
+ * results are positional: <code>results[i]</code> is the result for the
+ * digest at offset <code>i * 20</code> of <code>digests</code>, and its
+ * record has no <code>key</code>. No key object is created for any record,
+ * neither for the request nor for the results.
+ *
+ * What to read for every record is specified as for {@link
+ * Client#batchReadUniform}.
+ *
+ * This method requires server >= 6.0.0.
+ *
+ * @param {string} ns - The namespace of the records.
+ * @param {?string} set - The set of the records.
+ * @param {Buffer} digests - The digests of the records, 20 bytes each.
+ * @param {Object} [read] - What to read for every record; see {@link
+ * Client#batchReadUniform}. Reads all bins by default.
+ * @param {BatchPolicy} [policy] - The Batch Policy to use for this operation.
+ * @param {batchRecordsCallback} [callback] - The function to call when
+ * the operation completes, with the results of the batch operation.
+ *
+ * @returns {?Promise} - If no callback function is passed, the function
+ * returns a Promise that resolves to the results of the batch operation.
+ *
+ * @example
+ *
+ * const Aerospike = require('aerospike')
+ *
+ * ;(async () => {
+ *   const client = await Aerospike.connect({ hosts: '192.168.33.10:3000' })
+ *   const keys = [1, 2, 3].map(i => new Aerospike.Key('test', 'demo', i))
+ *   // Digests kept from earlier reads
+ *   const earlier = await client.batchGet(keys)
+ *   const digests = Buffer.concat(earlier.map(result => result.record.key.digest))
+ *   const results = await client.batchReadDigests('test', 'demo', digests, { bins: ['name'] })
+ *   results.forEach((result, i) => {
+ *     console.log(digests.subarray(i * 20, i * 20 + 20).toString('hex'), result.status)
+ *   })
+ *   await client.close()
+ * })()
+ *
+ * @since v6.4.0
+ */
+Client.prototype.batchReadDigests = function (ns, set, digests, read, policy, callback) {
+  if (typeof read === 'function') {
+    callback = read
+    read = null
+  } else if (typeof policy === 'function') {
+    callback = policy
+    policy = null
+  }
+
+  const batch = { ns, set, digests }
+  const cmd = new Commands.BatchReadUniform(this, [batch, read || { readAllBins: true }, policy], callback)
+  return cmd.execute()
+}
+
 /**
  * @function Client#batchWrite
  *
@@ -1912,11 +2109,28 @@ Client.prototype.batchSelect = function (keys, bins, policy, callback) {
  *   })
  */
 Client.prototype.close = function (releaseEventLoop = false, destroyTransactions = true) {
+  if (this.readBatcher) {
+    this.readBatcher.flush()
+  }
+  if (this.connecting) {
+    // The client is closed once the connection attempt completes.
+    this.pendingClose = { releaseEventLoop, destroyTransactions }
+    return
+  }
   if (this.isConnected(false)) {
     this.connected = false
     this.as_client.close()
     _connectedClients -= 1
   }
+  releaseResources(releaseEventLoop, destroyTransactions)
+}
+
+/**
+ * Releases the resources shared by all clients once the last one is closed.
+ *
+ * @private
+ */
+function releaseResources (releaseEventLoop, destroyTransactions) {
   if (_connectedClients === 0) {
     if (destroyTransactions) {
       _transactionPool.removeAllTransactions()
@@ -1944,6 +2158,11 @@ Client.prototype.close = function (releaseEventLoop = false, destroyTransactions
  * known server endpoints, and will reconnect automatically if the connection
  * is reestablished.
  *
+ * The initial connection - seed host resolution, TLS handshakes,
+ * authentication and fetching the cluster's partition maps - is established
+ * on a background thread, so it does not block the event loop. Several
+ * clients can therefore connect in parallel.
+ *
  * @param {connectCallback} [callback] - The function to call once the
  * client connection has been established successfully and the client is ready
  * to accept commands.
@@ -1983,9 +2202,14 @@ Client.prototype.connect = function (callback) {
 
   this.as_client.setupEventCb(eventsCb)
 
+  this.connecting = true
   const cmd = new Commands.Connect(this)
   return cmd.execute()
     .then(() => {
+      if (this.pendingClose) {
+        throw new AerospikeError('Client was closed while connecting')
+      }
+      this.connecting = false
       this.connected = true
       _connectedClients += 1
       if (callback) callback(null, this)
@@ -1993,7 +2217,13 @@ Client.prototype.connect = function (callback) {
       else return this
     })
     .catch(error => {
+      this.connecting = false
       this.as_client.close()
+      if (this.pendingClose) {
+        const { releaseEventLoop, destroyTransactions } = this.pendingClose
+        this.pendingClose = null
+        releaseResources(releaseEventLoop, destroyTransactions)
+      }
       if (callback) callback(error)
       else throw error
     })
@@ -2510,6 +2740,10 @@ Client.prototype.exists = function exists (key, policy, callback) {
     policy = null
   }
 
+  if (this.readBatcher && this.readBatcher.accepts(key, policy)) {
+    return this.readBatcher.exists(key, policy, callback)
+  }
+
   const cmd = new Commands.Exists(this, null, [key, policy], callback)
   return cmd.execute()
 }
@@ -2566,6 +2800,10 @@ Client.prototype.get = function (key, policy, callback) {
     policy = null
   }
 
+  if (this.readBatcher && this.readBatcher.accepts(key, policy)) {
+    return this.readBatcher.get(key, policy, callback)
+  }
+
   const cmd = new Commands.Get(this, key, [policy], callback)
   return cmd.execute()
 }
@@ -2859,8 +3097,11 @@ Client.prototype.isConnected = function (checkTenderErrors) {
  * * {@link module:aerospike/maps} - Operations on CDT Map values.
  * * {@link module:aerospike/bitwise} - Operations on Bytes values.
  *
+ * Operations that are executed many times with different values can be
+ * prepared once using {@link module:aerospike/operations.prepare}.
+ *
  * @param {Key} key - The key of the record.
- * @param {module:aerospike/operations~Operation[]} operations - List of operations to perform on the record.
+ * @param {(module:aerospike/operations~Operation[]|module:aerospike/operations~BoundOperations)} operations - List of operations to perform on the record, or prepared operations bound to their values.
  * @param {Object} [metadata] - Meta data.
  * @param {OperatePolicy} [policy] - The Operate Policy to use for this operation.
  * @param {recordCallback} [callback] - The function to call when the
@@ -3230,6 +3471,10 @@ Client.prototype.select = function (key, bins, policy, callback) {
     policy = null
   }
 
+  if (this.readBatcher && this.readBatcher.accepts(key, policy)) {
+    return this.readBatcher.select(key, bins, policy, callback)
+  }
+
   const cmd = new Commands.Select(this, key, [bins, policy], callback)
   return cmd.execute()
 }
@@ -3375,6 +3620,23 @@ Client.prototype.stats = function () {
   return this.as_client.getStats()
 }
 
+/**
+ * @function Client#resetStats
+ *
+ * @summary Resets the latency histograms reported by {@link Client#stats}.
+ *
+ * @since v6.4.0
+ *
+ * @example
+ *
+ * const stats = client.stats()
+ * client.resetStats()
+ * console.info(stats.latency.get.total.p99)
+ */
+Client.prototype.resetStats = function () {
+  this.as_client.resetStats()
+}
+
 /**
  * @function Client#udfRemove
  *
@@ -17,23 +17,47 @@
 'use strict'
 
 const Command = require('./command')
-const Record = require('../record')
-
-class BatchResult {
-  constructor (status, record, inDoubt) {
-    this.status = status
-    this.record = record
-    this.inDoubt = inDoubt
-  }
-}
 
+// Batch results are constructed as BatchResult instances by the native add-on.
 module.exports = asCommand => class BatchCommand extends Command(asCommand) {
   convertResult (results) {
-    if (!results) return []
+    return results || []
+  }
+
+  /**
+   * Splits the batch into sub-batches of at most chunkSize records, keeps up
+   * to concurrency of them in flight and yields the results of each one as
+   * soon as it completes, together with the index of its first record.
+   * Completed sub-batches count as in flight until they have been consumed.
+   *
+   * @private
+   */
+  async * stream (chunkSize, concurrency) {
+    const [records, ...args] = this.args
+    const inFlight = new Set()
+    let next = 0
+
+    const send = () => {
+      const index = next
+      const chunk = records.slice(index, index + chunkSize)
+      next += chunk.length
+      const cmd = new this.constructor(this.client, [chunk, ...args])
+      const request = cmd.execute().then(
+        results => ({ request, index, results }),
+        error => ({ request, error }))
+      inFlight.add(request)
+    }
 
-    return results.map(result => {
-      const record = new Record(result.key, result.bins, result.meta)
-      return new BatchResult(result.status, record, result.inDoubt)
-    })
+    while (next < records.length || inFlight.size > 0) {
+      while (next < records.length && inFlight.size < concurrency) {
+        send()
+      }
+      const { request, index, results, error } = await Promise.race(inFlight)
+      inFlight.delete(request)
+      if (error) {
+        throw error
+      }
+      yield { index, results }
+    }
   }
 }
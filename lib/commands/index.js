@@ -29,6 +29,7 @@ exports.Apply = class ApplyCommand extends Command('applyAsync') { }
 exports.BatchExists = class BatchExistsCommand extends BatchCommand('batchExists') { }
 exports.BatchGet = class BatchGetCommand extends BatchCommand('batchGet') { }
 exports.BatchRead = class BatchReadCommand extends BatchCommand('batchRead') { }
+exports.BatchReadUniform = class BatchReadUniformCommand extends BatchCommand('batchReadUniform') { }
 exports.BatchWrite = class BatchWriteCommand extends BatchCommand('batchWrite') { }
 exports.BatchApply = class BatchApplyCommand extends BatchCommand('batchApply') { }
 exports.BatchRemove = class BatchRemoveCommand extends BatchCommand('batchRemove') { }
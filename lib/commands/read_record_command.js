@@ -17,7 +17,6 @@
 'use strict'
 
 const Command = require('./command')
-const Record = require('../record')
 
 module.exports = asCommand => class ReadRecordCommand extends Command(asCommand) {
   constructor (client, key, args, callback) {
@@ -26,7 +25,8 @@ module.exports = asCommand => class ReadRecordCommand extends Command(asCommand)
     this.key = key
   }
 
-  convertResult (bins, metadata) {
-    return new Record(this.key, bins, metadata)
+  // The native add-on returns a Record instance with this.key as its key.
+  convertResult (record) {
+    return record
   }
 }
@@ -17,7 +17,6 @@
 'use strict'
 
 const Command = require('./command')
-const Key = require('../key')
 const Record = require('../record')
 
 module.exports = asCommand => class StreamCommand extends Command(asCommand) {
@@ -29,17 +28,25 @@ module.exports = asCommand => class StreamCommand extends Command(asCommand) {
   callback (error, record) {
     if (error) {
       this.stream.emit('error', error)
+    } else if (Array.isArray(record)) {
+      for (let i = 0; i < record.length && !this.stream.aborted; i++) {
+        this.stream._push(record[i])
+      }
     } else if ('state' in record) {
-      this.stream.emit('end', record.state)
+      this.stream._end(record.state)
     } else {
-      this.stream.emit('data', record)
+      this.stream._push(record)
     }
     return !this.stream.aborted
   }
 
-  convertResult (bins, meta, asKey) {
-    if (!bins) return { state: meta }
-    const key = Key.fromASKey(asKey)
-    return new Record(key, bins, meta)
+  // Records arrive as Record instances constructed by the native add-on,
+  // either one at a time or in batches (see recordsPerCallback). Stream UDF
+  // queries deliver plain values instead.
+  convertResult (result, state) {
+    if (result instanceof Record) return result
+    if (Array.isArray(result) && result[0] instanceof Record) return result
+    if (!result) return { state }
+    return new Record(null, result)
   }
 }
@@ -542,6 +542,167 @@ class Config {
       this.sharedMemory = config.sharedMemory
     }
 
+    /**
+     * @name Config#sharedCluster
+     * @summary Key under which the client's cluster connection is shared
+     * with other clients in the same process.
+     * @description Clients created with the same key - typically one per
+     * worker thread - share a single native cluster instance, i.e. a single
+     * cluster tend thread and set of connection pools, while every client
+     * processes its commands on the event loop of its own thread. All
+     * clients created with a given key must use the same configuration,
+     * apart from <code>log</code>, <code>readCache</code> and
+     * <code>readBatching</code>; creating a client with a different
+     * configuration throws an error. The cluster connection is closed once
+     * the last of these clients is closed. Clients using a shared cluster do
+     * not emit cluster events.
+     *
+     * @type {string}
+     * @since v6.4.0
+     *
+     * @example <caption>Using a shared cluster from worker threads</caption>
+     *
+     * const Aerospike = require('aerospike')
+     * const { Worker, isMainThread } = require('worker_threads')
+     *
+     * const config = {
+     *   hosts: '192.168.33.10:3000',
+     *   sharedCluster: 'default'
+     * }
+     *
+     * if (isMainThread) {
+     *   for (let i = 0; i < 4; i++) {
+     *     new Worker(__filename)
+     *   }
+     * } else {
+     *   Aerospike.connect(config).then(async client => {
+     *     // handle requests, etc.
+     *     client.close()
+     *   })
+     * }
+     */
+    if (typeof config.sharedCluster === 'string') {
+      this.sharedCluster = config.sharedCluster
+    }
+
+    /**
+     * @name Config#pipeline
+     * @summary Pipelining of single-record commands.
+     * @description With pipelining enabled, get, select, exists, put,
+     * remove, operate and apply commands share pipeline connections: a
+     * command is written to a connection while earlier commands on it are
+     * still waiting for their response. This needs far fewer connections per
+     * node for high volumes of small commands. The number of pipelined
+     * commands in flight is reported by {@link Client#stats}, and the
+     * connections per node as <code>pipelineConnections</code>.
+     *
+     * Once <code>maxDepth</code> commands per node are in flight on
+     * pipeline connections, further commands are sent on regular async
+     * connections until some of them have completed.
+     *
+     * @type {Object}
+     * @since v6.4.0
+     *
+     * @property {boolean} [enabled=true] - Whether to pipeline single-record
+     * commands.
+     * @property {number} [maxConnsPerNode=64] - Maximum number of pipeline
+     * connections per server node.
+     * @property {number} [maxDepth=0] - Maximum number of pipelined commands
+     * in flight per server node; 0 means no limit.
+     *
+     * @example
+     *
+     * const Aerospike = require('aerospike')
+     *
+     * const config = {
+     *   hosts: '192.168.33.10:3000',
+     *   pipeline: { maxConnsPerNode: 8, maxDepth: 512 }
+     * }
+     */
+    if (typeof config.pipeline === 'object') {
+      this.pipeline = Object.assign({}, config.pipeline)
+    }
+
+    /**
+     * @name Config#readBatching
+     * @summary Coalescing of single-key reads into batch reads.
+     * @description When set, {@link Client#get}, {@link Client#select} and
+     * {@link Client#exists} calls issued within the same window are
+     * collected and sent as a single {@link Client#batchRead} command per
+     * read policy; the results are returned to the individual callbacks or
+     * promises as usual. This trades a small delay for batch-level server and
+     * network efficiency when an application issues many independent reads.
+     *
+     * Reads are sent once the window has passed, or as soon as
+     * <code>maxKeys</code> reads with the same policy are pending. Reads with
+     * a frozen policy or a transaction are not batched. The batch policy is
+     * derived from the read policy of the reads, or the client's default read
+     * policy.
+     *
+     * @type {Object}
+     * @since v6.4.0
+     *
+     * @property {number} [window=0] - Time in milliseconds to collect reads
+     * for; 0 collects the reads issued in the same event loop iteration.
+     * @property {number} [maxKeys=100] - Maximum number of reads per batch.
+     *
+     * @example
+     *
+     * const Aerospike = require('aerospike')
+     *
+     * const config = {
+     *   hosts: '192.168.33.10:3000',
+     *   readBatching: { window: 1, maxKeys: 200 }
+     * }
+     */
+    if (typeof config.readBatching === 'object' && config.readBatching !== null) {
+      this.readBatching = Object.assign({}, config.readBatching)
+    }
+
+    /**
+     * @name Config#readCache
+     * @summary Client-side cache of records read by the client.
+     * @description When set, records read by {@link Client#get} and
+     * {@link Client#batchGet}, and by {@link Client#batchRead} for records
+     * that read all bins, are kept in a cache keyed by namespace and digest.
+     * {@link Client#get} and {@link Client#select} are answered from the
+     * cache without a round trip to the cluster if the record is cached,
+     * as are {@link Client#batchGet} and {@link Client#batchRead} if all
+     * their records are cached.
+     *
+     * A record stays cached until its TTL has expired, for at most
+     * <code>maxStaleness</code> ms, or until it is evicted to stay within
+     * <code>maxMemory</code>. Writes through this client - put, operate,
+     * remove, apply and batch writes - invalidate the record; writes by other
+     * clients are only seen once the record is no longer cached. Reads with
+     * a filter expression, a transaction, a read-touch TTL percentage or
+     * <code>deserialize: false</code> bypass the cache.
+     *
+     * Cache hits, misses and evictions are reported by {@link Client#stats}.
+     *
+     * @type {Object}
+     * @since v6.4.0
+     *
+     * @property {number} [maxMemory=67108864] - Approximate maximum memory
+     * used by cached records, in bytes.
+     * @property {number} [maxStaleness=1000] - Maximum time in milliseconds
+     * a record is served from the cache after it was read.
+     * @property {number} [shards=16] - Number of independently locked and
+     * evicted cache shards.
+     *
+     * @example
+     *
+     * const Aerospike = require('aerospike')
+     *
+     * const config = {
+     *   hosts: '192.168.33.10:3000',
+     *   readCache: { maxMemory: 16 * 1024 * 1024, maxStaleness: 500 }
+     * }
+     */
+    if (typeof config.readCache === 'object' && config.readCache !== null) {
+      this.readCache = Object.assign({}, config.readCache)
+    }
+
     /**
      * @name Config#useAlternateAccessAddress
      * @summary Whether the client should use the server's
@@ -17,6 +17,7 @@
 'use strict'
 
 const as = require('bindings')('aerospike.node')
+const { isMainThread } = require('worker_threads')
 const AerospikeError = require('./error')
 const CommandQueuePolicy = require('./policies/command_queue_policy')
 
@@ -67,10 +68,18 @@ let _commandQueuePolicy = new CommandQueuePolicy()
  * then the clients need to be closed with <code>releaseEventLoop</code> set
  * to <code>false</code> and the event loop needs to be released explicitly by
  * calling <code>releaseEventLoop()</code>.
+ *
+ * In a worker thread, releasing the event loop returns it to a pool once the
+ * worker's commands have completed, so that it can be reused by another
+ * worker; this also happens when the worker exits. Up to 256 threads, incl.
+ * the main thread, can use an event loop at the same time. Worker threads are
+ * not supported on Windows.
  */
 function releaseEventLoop () {
   if (_eventLoopReleased) return
-  if (as.get_cluster_count() > 0) {
+  // The cluster count is process-wide; worker threads only release their own
+  // event loop, which is pooled once its pending commands complete.
+  if (isMainThread && as.get_cluster_count() > 0) {
     setTimeout(releaseEventLoop, 5)
   } else {
     as.release_as_event_loop()
@@ -995,6 +995,25 @@ exports.var = (varName) => [
   ..._rawStr(varName)
 ]
 
+/**
+ * Compiles a filter expression once so that it can be shared by any number of
+ * policies. Commands using a compiled expression send the pre-compiled bytes
+ * as-is instead of recompiling the expression for every command.
+ *
+ * @function
+ * @param {AerospikeExp} expression The filter expression to compile.
+ * @return {CompiledExpression} The compiled filter expression.
+ * @throws {TypeError} If the expression is invalid.
+ *
+ * @example
+ *
+ * const filter = exp.compile(exp.gt(exp.binInt('age'), exp.int(21)))
+ * const policy = new Aerospike.ReadPolicy({ filterExpression: filter })
+ *
+ * @since v6.4.0
+ */
+exports.compile = (expression) => as.compiled_expression(expression)
+
 /**
  * The {@link module:aerospike/exp/lists|aerospike/exp/lists} module defines functions
  * for expressions on the List datatype.
@@ -42,6 +42,9 @@ Job.safeRandomJobID = function () {
  * Repeatedly execute the given status function until it either indicates that
  * the job has completed or returns an error.
  *
+ * The next status check is only scheduled once the previous one has
+ * completed, so that slow status checks never overlap.
+ *
  * @returns {Promise}
  *
  * @private
@@ -50,21 +53,16 @@ Job.pollUntilDone = function (statusFunction, pollInterval) {
   pollInterval = pollInterval || DEFAULT_POLL_INTERVALL
 
   return new Promise((resolve, reject) => {
-    let timer = null
     const poll = function () {
       statusFunction()
         .then(done => {
           if (done) {
-            if (timer) clearInterval(timer)
             resolve()
-          } else if (!timer) {
-            timer = setInterval(poll, pollInterval)
+          } else {
+            setTimeout(poll, pollInterval)
           }
         })
-        .catch(error => {
-          if (timer) clearInterval(timer)
-          reject(error)
-        })
+        .catch(reject)
     }
     poll()
   })
@@ -92,6 +92,28 @@ Key.fromASKey = function (keyObj) {
   return new Key(keyObj.ns, keyObj.set, keyObj.key, keyObj.digest)
 }
 
+/**
+ * Whether the object is a valid key, i.e. has the properties of a valid
+ * {@link Key} instance.
+ *
+ * @private
+ */
+Key.isValid = function (key) {
+  if (!key || !isValidNamespace(key.ns)) return false
+  if (isSet(key.set) && !isValidSetName(key.set)) return false
+  const hasKey = isSet(key.key)
+  if (hasKey) {
+    try {
+      validateKey(key.key)
+    } catch (error) {
+      return false
+    }
+  }
+  const hasDigest = isSet(key.digest)
+  if (hasDigest && !isValidDigest(key.digest)) return false
+  return hasKey || hasDigest
+}
+
 Key.prototype.equals = function (other) {
   return this.ns === other.ns &&
     ((!isSet(this.set) && !isSet(other.set)) || this.set === other.set) &&
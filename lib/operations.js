@@ -192,3 +192,162 @@ exports.touch = function (ttl) {
 exports.delete = function () {
   return new Operation(ops.DELETE, undefined)
 }
+
+const scalarOpcodes = new Set(Object.values(ops))
+
+// Prefix of the placeholders that mark the position of a parameter in the
+// packed arguments of a CDT operation.
+const PARAM_PLACEHOLDER = '\u0000aerospike.param.'
+
+/**
+ * @class module:aerospike/operations~OperationParam
+ * @classdesc A placeholder for a value that is bound when a prepared
+ * operation list is executed.
+ *
+ * @see {@link module:aerospike/operations.param}
+ * @since v6.4.0
+ */
+class OperationParam {
+  constructor (index) {
+    this.index = index
+  }
+}
+exports.OperationParam = OperationParam
+
+/**
+ * @class module:aerospike/operations~PreparedOperations
+ * @classdesc A list of operations converted once by {@link
+ * module:aerospike/operations.prepare}.
+ *
+ * @since v6.4.0
+ */
+class PreparedOperations {
+  constructor (prepared, params) {
+    this.prepared = prepared
+    this.params = params
+  }
+
+  /**
+   * @summary Binds values to the parameters of the prepared operations.
+   *
+   * @param {Array<any>} values - The parameter values, by parameter index.
+   * @returns {module:aerospike/operations~BoundOperations} Operations that can
+   * be passed to the {@link Client#operate} command.
+   * @throws {TypeError} If fewer values than parameters are given.
+   */
+  bind (values) {
+    if (!Array.isArray(values) || values.length < this.params) {
+      throw new TypeError(`Expected ${this.params} parameter values`)
+    }
+    return new BoundOperations(this.prepared, values)
+  }
+}
+exports.PreparedOperations = PreparedOperations
+
+/**
+ * @class module:aerospike/operations~BoundOperations
+ * @classdesc Prepared operations together with the values of their
+ * parameters.
+ *
+ * @since v6.4.0
+ */
+class BoundOperations {
+  constructor (prepared, values) {
+    this.prepared = prepared
+    this.values = values
+  }
+}
+exports.BoundOperations = BoundOperations
+
+/**
+ * @summary Creates a parameter for a prepared operation list.
+ *
+ * @description A parameter can replace the value of a scalar write, add,
+ * append or prepend operation, or a value argument of a List or Map
+ * operation, e.g. the value of {@link
+ * module:aerospike/lists.append} or the key and value of {@link
+ * module:aerospike/maps.put}. It cannot replace bin names, indexes, ranks,
+ * counts, contexts or policies, which are fixed when the operations are
+ * prepared, nor values nested in other values.
+ *
+ * @param {number} index - The index of the parameter's value in the values
+ * passed to {@link module:aerospike/operations~PreparedOperations#bind}.
+ * @returns {module:aerospike/operations~OperationParam} The parameter.
+ *
+ * @see {@link module:aerospike/operations.prepare}
+ * @since v6.4.0
+ */
+exports.param = function (index) {
+  if (!Number.isInteger(index) || index < 0) {
+    throw new TypeError('Parameter index must be a non-negative integer')
+  }
+  return new OperationParam(index)
+}
+
+/**
+ * @summary Converts a list of operations to its native representation once,
+ * so that it can be executed many times with different values.
+ *
+ * @description Bin names, CDT contexts and CDT policies of the operations
+ * are converted only once. On each execution, only the values bound to the
+ * parameters are converted; all other values are shared with the prepared
+ * operations.
+ *
+ * Parameters that need a particular type, e.g. numbers for {@link
+ * module:aerospike/lists.increment}, are checked by the server when the
+ * operations are executed.
+ *
+ * @param {module:aerospike/operations~Operation[]} operations - The
+ * operations, with the values that change between executions replaced by
+ * {@link module:aerospike/operations.param|parameters}.
+ * @returns {module:aerospike/operations~PreparedOperations} The prepared
+ * operations.
+ * @throws {TypeError} If the operations are invalid or a parameter is used
+ * where it is not supported.
+ *
+ * @example
+ *
+ * const Aerospike = require('aerospike')
+ * const op = Aerospike.operations
+ * const lists = Aerospike.lists
+ *
+ * const visit = op.prepare([
+ *   op.incr('visits', op.param(0)),
+ *   lists.append('pages', op.param(1)),
+ *   op.read('visits')
+ * ])
+ * // ...
+ * const record = await client.operate(key, visit.bind([1, '/home']))
+ *
+ * @since v6.4.0
+ */
+exports.prepare = function (operations) {
+  if (!Array.isArray(operations)) {
+    throw new TypeError('Operations must be an array')
+  }
+  const template = []
+  const slots = []
+  let params = 0
+  operations.forEach((operation, i) => {
+    let copy = null
+    for (const prop of Object.keys(operation)) {
+      const param = operation[prop]
+      if (!(param instanceof OperationParam)) continue
+      copy = copy || Object.assign(Object.create(Object.getPrototypeOf(operation)), operation)
+      if (scalarOpcodes.has(operation.op)) {
+        if (prop !== 'value') {
+          throw new TypeError(`Parameter cannot be used for "${prop}"`)
+        }
+        // Replaced as a whole; the placeholder only has to pass validation.
+        copy.value = operation.op === ops.INCR ? 0 : ''
+        slots.push([i, param.index, null])
+      } else {
+        copy[prop] = PARAM_PLACEHOLDER + slots.length
+        slots.push([i, param.index, copy[prop]])
+      }
+      params = Math.max(params, param.index + 1)
+    }
+    template.push(copy || operation)
+  })
+  return new PreparedOperations(as.prepared_operations(template, slots), params)
+}
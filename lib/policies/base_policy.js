@@ -102,6 +102,12 @@ class BasePolicy {
      * * {@link Client#put}
      * * {@link Client#remove}
      * * {@link Client#select}
+     *
+     * The filter can also be a {@link CompiledExpression} returned by {@link
+     * module:aerospike/exp.compile|exp.compile}, which is shared by commands
+     * instead of being recompiled for every command.
+     *
+     * @type AerospikeExp|CompiledExpression
      */
     this.filterExpression = props.filterExpression
 
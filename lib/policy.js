@@ -475,6 +475,68 @@ function policyClass (type) {
   }
 }
 
+// Frozen policies are native objects; they are tracked here so that they
+// can be passed through createPolicy unchanged.
+const frozenPolicies = new WeakSet()
+
+function frozenPolicyType (type) {
+  switch (type) {
+    case 'batchParentWrite':
+    case 'txnRoll':
+    case 'txnVerify':
+      return 'batch'
+    case 'read':
+    case 'write':
+    case 'apply':
+    case 'operate':
+    case 'remove':
+    case 'batch':
+    case 'batchRead':
+    case 'batchWrite':
+    case 'batchApply':
+    case 'batchRemove':
+      return type
+    default:
+      throw new TypeError(`Policy type "${type}" cannot be frozen`)
+  }
+}
+
+/**
+ * Converts a policy to its native representation once, so that commands
+ * using it copy the converted policy instead of reading all of its
+ * properties again for every command.
+ *
+ * The returned policy can be passed to any command that accepts a policy
+ * of the same type. It cannot be modified; freeze a new policy instead.
+ * Policies that reference a {@link Transaction} cannot be frozen.
+ *
+ * @param {string} type - The policy type, e.g. <code>'read'</code>,
+ * <code>'write'</code>, <code>'operate'</code> or <code>'batch'</code>.
+ * @param {Object} values - The policy or policy values to freeze.
+ * @returns {FrozenPolicy} The frozen policy.
+ * @throws {TypeError} if the policy type cannot be frozen or the policy is
+ * invalid.
+ *
+ * @example
+ *
+ * const Aerospike = require('aerospike')
+ *
+ * const policy = Aerospike.policy.freeze('read', { totalTimeout: 100 })
+ * // ...
+ * const record = await client.get(key, policy)
+ *
+ * @since v6.4.0
+ */
+exports.freeze = function (type, values) {
+  const nativeType = frozenPolicyType(type)
+  if (frozenPolicies.has(values)) {
+    return values
+  }
+  const frozen = as.frozen_policy(nativeType, exports.createPolicy(type, values) || {})
+  frozenPolicies.add(frozen)
+  return frozen
+}
+
 /**
  * @private
  * @throws {TypeError} if the type is not a valid policy type
@@ -483,6 +545,9 @@ exports.createPolicy = function (type, values) {
   if (values === null || typeof values === 'undefined') {
     return undefined
   }
+  if (frozenPolicies.has(values)) {
+    return values
+  }
   const Klass = policyClass(type)
   if (values instanceof Klass) {
     return values
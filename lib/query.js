@@ -153,6 +153,12 @@ const util = require('util')
  * {@link Query#select}.
  * @param {boolean} [options.nobins=false] - Whether only meta data should be
  * returned. See {@link Query#nobins}.
+ * @param {number} [options.recordsPerCallback=1] - Number of records to
+ * deliver from the native client at a time. See {@link Query#recordsPerCallback}.
+ * @param {number} [options.highWaterMark] - Maximum number of records to
+ * request ahead of the consumer of the record stream. See {@link Query#highWaterMark}.
+ * @param {number} [options.maxQueueSize=10000] - Maximum number of stream UDF
+ * results to buffer. See {@link Query#maxQueueSize}.
  * @param {boolean} [options.ttl=0] - The time-to-live (expiration) of the record in seconds.
  * See {@link Query#ttl}.
  *
@@ -254,6 +260,33 @@ function Query (client, ns, set, options) {
    */
   this.nobins = options.nobins
 
+  /**
+   * Maximum number of records to pass from the native client to JavaScript
+   * at a time when the query is executed using {@link Query#foreach}. Records are
+   * still emitted one by one on the {@link RecordStream}; delivering them
+   * in batches reduces the per-record overhead for large result sets.
+   * Defaults to 1, i.e. every record is delivered as soon as it is received.
+   * Not supported by queries that apply a stream UDF.
+   *
+   * @member {number} Query#recordsPerCallback
+   * @since v6.4.0
+   */
+  this.recordsPerCallback = options.recordsPerCallback
+
+  /**
+   * If set, the {@link RecordStream} returned by {@link Query#foreach} is
+   * flow-controlled: the query requests the records in pages of at most this
+   * many records and only requests the next page while the stream is not
+   * paused. A consumer that cannot keep up should pause the stream, e.g. by
+   * piping it into a writable stream. {@link Query#maxRecords} still limits
+   * the total number of records. Not supported for paginated queries or
+   * queries that apply a stream UDF.
+   *
+   * @member {number} Query#highWaterMark
+   * @since v6.4.0
+   */
+  this.highWaterMark = options.highWaterMark
+
   /**
    * User-defined function parameters to be applied to the query executed using
    * {@link Query#foreach}.
@@ -262,6 +295,17 @@ function Query (client, ns, set, options) {
    */
   this.udf = options.udf
 
+  /**
+   * Maximum number of stream UDF results buffered between the cluster and
+   * the application when the query is executed using {@link Query#foreach}.
+   * Results are passed on as soon as they are received; once the buffer is
+   * full, the query waits for the application to catch up. Defaults to 10,000.
+   *
+   * @member {number} Query#maxQueueSize
+   * @since v6.4.0
+   */
+  this.maxQueueSize = options.maxQueueSize
+
   /**
    * If set to <code>true</code>, the query will return records belonging to the partitions specified
    * in {@link Query#partFilter}.
@@ -616,6 +660,14 @@ Query.prototype.foreach = function (policy, dataCb, errorCb, endCb) {
         args.push(null)
       }
       cmd = new Commands.QueryPages(stream, args)
+    } else if (this.highWaterMark > 0) {
+      stream.highWaterMark = this.highWaterMark
+      stream._paginate(this.maxRecords, (state, maxRecords) => {
+        const args = [this.ns, this.set, this, policy, state, maxRecords, null]
+        const cmd = new Commands.QueryPages(stream, args)
+        cmd.execute()
+      })
+      return stream
     } else {
       cmd = new Commands.Query(stream, args)
     }
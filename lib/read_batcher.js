@@ -0,0 +1,230 @@
+// *****************************************************************************
+// Copyright 2024 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+'use strict'
+
+const AerospikeError = require('./error')
+const batchType = require('./batch_type')
+const Key = require('./key')
+const status = require('./status')
+const BatchPolicy = require('./policies/batch_policy')
+const ReadPolicy = require('./policies/read_policy')
+
+// Read policy properties that have the same meaning in a batch policy.
+const BATCH_POLICY_PROPS = [
+  'socketTimeout', 'totalTimeout', 'maxRetries', 'compress',
+  'filterExpression', 'replica', 'readModeAP', 'readModeSC',
+  'readTouchTtlPercent', 'deserialize'
+]
+
+/**
+ * Coalesces single-key reads issued within a short window into batch reads;
+ * see {@link Config#readBatching}.
+ *
+ * @private
+ */
+class ReadBatcher {
+  constructor (client, config) {
+    this.client = client
+    this.window = Number.isInteger(config.window) ? config.window : 0
+    this.maxKeys = Number.isInteger(config.maxKeys) ? config.maxKeys : 100
+
+    // Pending reads, grouped by namespace and by the values of the read
+    // policy they were issued with; see groupKey.
+    this.groups = new Map()
+    this.scheduled = false
+    // Identifies compiled filter expressions, which cannot be serialized.
+    this.expressionIds = new WeakMap()
+    this.nextExpressionId = 0
+  }
+
+  /**
+   * Whether a read of the given key with the given policy can be batched.
+   * Invalid keys are read directly, so that only their own read fails rather
+   * than the whole batch. Frozen policies and policies of a transaction
+   * cannot be converted to batch policies.
+   */
+  accepts (key, policy) {
+    if (!Key.isValid(key)) {
+      return false
+    }
+    if (policy === null || typeof policy === 'undefined') {
+      return true
+    }
+    if (!(policy instanceof ReadPolicy) &&
+        Object.getPrototypeOf(policy) !== Object.prototype) {
+      return false
+    }
+    return !policy.txn
+  }
+
+  get (key, policy, callback) {
+    return this.read({ type: batchType.BATCH_READ, key, readAllBins: true }, policy, callback, 'get')
+  }
+
+  select (key, bins, policy, callback) {
+    return this.read({ type: batchType.BATCH_READ, key, bins }, policy, callback, 'select')
+  }
+
+  exists (key, policy, callback) {
+    return this.read({ type: batchType.BATCH_READ, key, readAllBins: false }, policy, callback, 'exists')
+  }
+
+  /** @private */
+  read (record, policy, callback, kind) {
+    if (callback) {
+      // Called asynchronously, so that an exception thrown by one callback
+      // does not prevent the other reads of the batch from completing.
+      this.add(record, policy, kind, (error, result) => process.nextTick(callback, error, result))
+      return
+    }
+    return new Promise((resolve, reject) => {
+      this.add(record, policy, kind, (error, result) => {
+        if (error) {
+          reject(error)
+        } else {
+          resolve(result)
+        }
+      })
+    })
+  }
+
+  /** @private */
+  add (record, policy, kind, callback) {
+    policy = policy || null
+    const groupKey = this.groupKey(record.key.ns, policy)
+    let group = this.groups.get(groupKey)
+    if (!group) {
+      group = { policy, records: [], reads: [] }
+      this.groups.set(groupKey, group)
+    }
+    group.records.push(record)
+    group.reads.push({ kind, callback })
+
+    if (group.records.length >= this.maxKeys) {
+      this.groups.delete(groupKey)
+      this.send(group)
+    } else if (!this.scheduled) {
+      this.scheduled = true
+      if (this.window > 0) {
+        setTimeout(() => this.flush(), this.window)
+      } else {
+        setImmediate(() => this.flush())
+      }
+    }
+  }
+
+  /**
+   * Sends all pending reads.
+   */
+  flush () {
+    this.scheduled = false
+    const groups = this.groups
+    this.groups = new Map()
+    for (const group of groups.values()) {
+      this.send(group)
+    }
+  }
+
+  /**
+   * Returns the key of the group of a read: reads of the same namespace, with
+   * policies that convert to the same batch policy, are batched together,
+   * even if each was issued with a policy object of its own.
+   *
+   * @private
+   */
+  groupKey (ns, policy) {
+    let groupKey = ns
+    if (!policy) {
+      return groupKey
+    }
+    for (const prop of BATCH_POLICY_PROPS) {
+      const value = policy[prop]
+      if (typeof value === 'undefined') continue
+      groupKey += '\0' + prop + '=' + this.serialize(value)
+    }
+    return groupKey
+  }
+
+  /** @private */
+  serialize (value) {
+    if (value === null || typeof value !== 'object' || Array.isArray(value)) {
+      return JSON.stringify(value, (key, v) => typeof v === 'bigint' ? `${v}n` : v)
+    }
+    let id = this.expressionIds.get(value)
+    if (typeof id === 'undefined') {
+      id = this.nextExpressionId++
+      this.expressionIds.set(value, id)
+    }
+    return '#' + id
+  }
+
+  /** @private */
+  send (group) {
+    const batchPolicy = this.batchPolicy(group.policy)
+    this.client.batchRead(group.records, batchPolicy, (error, results) => {
+      for (let i = 0; i < group.reads.length; i++) {
+        const read = group.reads[i]
+        if (error) {
+          read.callback(error)
+        } else {
+          this.respond(read, group.records[i].key, results[i])
+        }
+      }
+    })
+  }
+
+  /** @private */
+  respond (read, key, result) {
+    if (result.status === status.OK) {
+      if (read.kind === 'exists') {
+        return read.callback(null, true)
+      }
+      result.record.key = key
+      return read.callback(null, result.record)
+    }
+    if (result.status === status.ERR_RECORD_NOT_FOUND && read.kind === 'exists') {
+      return read.callback(null, false)
+    }
+    const error = new AerospikeError(status.getMessage(result.status))
+    error.code = result.status
+    error.inDoubt = !!result.inDoubt
+    read.callback(error)
+  }
+
+  /**
+   * Converts the read policy of a group of reads, or the client's default
+   * read policy, to the batch policy to send them with.
+   *
+   * @private
+   */
+  batchPolicy (policy) {
+    if (!policy) {
+      const policies = this.client.config.policies
+      policy = policies && policies.read
+      if (!policy) return null
+    }
+    const props = {}
+    for (const prop of BATCH_POLICY_PROPS) {
+      if (typeof policy[prop] !== 'undefined') {
+        props[prop] = policy[prop]
+      }
+    }
+    return new BatchPolicy(props)
+  }
+}
+
+module.exports = ReadBatcher
@@ -16,6 +16,10 @@
 
 'use strict'
 
+// Stands in for missing metadata and props, so that records constructed
+// without them, e.g. by the native add-on, do not allocate empty objects.
+const NONE = Object.freeze({})
+
 /**
  * @class Record
  * @classdesc Aerospike Record
@@ -225,8 +229,8 @@
 class Record {
   /** @private */
   constructor (key, bins, metadata, type, props) {
-    metadata = metadata || {}
-    props = props || {}
+    metadata = metadata || NONE
+    props = props || NONE
 
     /**
      * Unique record identifier.
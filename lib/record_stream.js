@@ -23,11 +23,21 @@ const inherits = require('util').inherits
  * @class RecordStream
  * @classdesc Stream of database records (full or partial) returned by {@link Query} or {@link Scan} operations.
  *
- * *Note:* Record stream currently does not support Node.js'
- * <code>Stream#pause</code> and <code>Stream#resume</code> methods, i.e. it
- * always operates in flowing mode. That means data is read from the Aerospike
- * database and provided to your application as fast as possible. If no data
- * event handlers are attached, then data will be lost.
+ * Records are emitted as fast as they are read from the Aerospike database.
+ * If no data event handlers are attached, then data will be lost. Calling
+ * {@link RecordStream#pause} stops the emission of <code>data</code> events;
+ * records received while the stream is paused are buffered until the stream
+ * is resumed. Piping the stream into a writable stream pauses and resumes it
+ * automatically.
+ *
+ * #### Flow Control
+ *
+ * By default, pausing the stream does not slow down the scan/query itself,
+ * i.e. the buffer can grow as large as the result set. If the {@link
+ * Scan#highWaterMark} or {@link Query#highWaterMark} is set, the records are
+ * instead requested from the cluster in pages of at most that many records
+ * and the next page is only requested while the stream is not paused. This
+ * bounds the number of records held in memory by a slow consumer.
  *
  * #### Aborting a Query/Scan
  *
@@ -81,6 +91,35 @@ function RecordStream (client) {
    */
   this.aborted = false
 
+  /**
+   * <code>true</code> if the stream has been paused; <code>false</code> otherwise.
+   * @member {boolean} RecordStream#paused
+   * @see {@link RecordStream#pause}
+   * @since v6.4.0
+   */
+  this.paused = false
+
+  /**
+   * Maximum number of records requested from the cluster ahead of the
+   * consumer, if the stream is flow-controlled; <code>undefined</code>
+   * otherwise.
+   * @member {number} RecordStream#highWaterMark
+   * @since v6.4.0
+   */
+  this.highWaterMark = undefined
+
+  // Records received while the stream is paused.
+  this.buffer = []
+  this.flushing = false
+  this.ended = false
+  this.endState = undefined
+
+  // Set if the stream requests the records one page at a time; see
+  // RecordStream#_paginate.
+  this.executePage = null
+  this.nextPage = null
+  this.remaining = Infinity
+
   // Keep a reference to the client instance even though it's not actually
   // needed to process the stream. This is to prevent situations where the
   // client object goes out of scope while the stream is still being processed
@@ -93,7 +132,44 @@ inherits(RecordStream, stream)
 
 RecordStream.prototype.writable = false
 RecordStream.prototype.readable = true
-RecordStream.prototype._read = function () {}
+RecordStream.prototype._read = function () {
+  this.resume()
+}
+
+/**
+ * @function RecordStream#pause
+ *
+ * @summary Stops emitting <code>data</code> events until the stream is resumed.
+ *
+ * @description Records received while the stream is paused are buffered. If
+ * the stream is flow-controlled, no further records are requested from the
+ * cluster until the stream is resumed.
+ *
+ * @returns {RecordStream} The stream.
+ *
+ * @since v6.4.0
+ */
+RecordStream.prototype.pause = function () {
+  this.paused = true
+  return this
+}
+
+/**
+ * @function RecordStream#resume
+ *
+ * @summary Resumes emitting <code>data</code> events after the stream has been
+ * paused, starting with any buffered records.
+ *
+ * @returns {RecordStream} The stream.
+ *
+ * @since v6.4.0
+ */
+RecordStream.prototype.resume = function () {
+  if (!this.paused) return this
+  this.paused = false
+  this._flush()
+  return this
+}
 
 /**
  * @function RecordStream#abort
@@ -110,6 +186,81 @@ RecordStream.prototype.abort = function () {
   process.nextTick(this.emit.bind(this, 'end'))
 }
 
+/**
+ * Emits a record received from the cluster, or buffers it if the stream is
+ * paused.
+ * @private
+ */
+RecordStream.prototype._push = function (record) {
+  this.remaining--
+  if (this.paused || this.flushing || this.buffer.length > 0) {
+    this.buffer.push(record)
+  } else {
+    this.emit('data', record)
+  }
+}
+
+/**
+ * Signals that the current scan/query (page) is complete. The end event is
+ * emitted once all buffered records have been consumed.
+ * @private
+ */
+RecordStream.prototype._end = function (state) {
+  if (this.executePage) {
+    if (state && this.remaining > 0 && !this.aborted) {
+      const maxRecords = Math.min(this.highWaterMark, this.remaining)
+      this.nextPage = () => this.executePage(state, maxRecords)
+    }
+    state = undefined
+  }
+  this.ended = !this.nextPage
+  this.endState = state
+  this._flush()
+}
+
+/**
+ * Requests the records one page of at most highWaterMark records at a time,
+ * until either the scan/query is complete or limit records have been received.
+ * executePage(state, maxRecords) must execute a single page, continuing from
+ * the given scan/query state, and deliver its results to this stream.
+ * @private
+ */
+RecordStream.prototype._paginate = function (limit, executePage) {
+  this.remaining = limit > 0 ? limit : Infinity
+  this.executePage = executePage
+  executePage(undefined, Math.min(this.highWaterMark, this.remaining))
+}
+
+/**
+ * Emits buffered records until the stream is paused; then requests the next
+ * page or emits the end event once the buffer has been drained.
+ * @private
+ */
+RecordStream.prototype._flush = function () {
+  if (this.flushing) return
+  const buffer = this.buffer
+  let i = 0
+  this.flushing = true
+  try {
+    while (i < buffer.length && !this.paused && !this.aborted) {
+      this.emit('data', buffer[i++])
+    }
+  } finally {
+    buffer.splice(0, i)
+    this.flushing = false
+  }
+  if (this.paused || this.aborted || buffer.length > 0) return
+
+  if (this.nextPage) {
+    const nextPage = this.nextPage
+    this.nextPage = null
+    nextPage()
+  } else if (this.ended) {
+    this.ended = false
+    this.emit('end', this.endState)
+  }
+}
+
 /**
  * @event RecordStream#data
  * @param {Record} record - Aerospike record incl. bins, key and meta data.
@@ -87,6 +87,10 @@ const RecordStream = require('./record_stream')
  * {@link Scan#select}.
  * @param {boolean} [options.nobins=false] - Whether only meta data should be
  * returned. See {@link Scan#nobins}.
+ * @param {number} [options.recordsPerCallback=1] - Number of records to
+ * deliver from the native client at a time. See {@link Scan#recordsPerCallback}.
+ * @param {number} [options.highWaterMark] - Maximum number of records to
+ * request ahead of the consumer of the record stream. See {@link Scan#highWaterMark}.
  * @param {boolean} [options.concurrent=false] - Whether all cluster nodes
  * should be scanned concurrently. See {@link Scan#concurrent}.
  * @param {boolean} [options.ttl=0] - The time-to-live (expiration) of the record in seconds.
@@ -164,6 +168,32 @@ function Scan (client, ns, set, options) {
    */
   this.nobins = options.nobins
 
+  /**
+   * Maximum number of records to pass from the native client to JavaScript
+   * at a time when the scan is executed using {@link Scan#foreach}. Records are
+   * still emitted one by one on the {@link RecordStream}; delivering them
+   * in batches reduces the per-record overhead for large result sets.
+   * Defaults to 1, i.e. every record is delivered as soon as it is received.
+   *
+   * @member {number} Scan#recordsPerCallback
+   * @since v6.4.0
+   */
+  this.recordsPerCallback = options.recordsPerCallback
+
+  /**
+   * If set, the {@link RecordStream} returned by {@link Scan#foreach} is
+   * flow-controlled: the scan requests the records in pages of at most this
+   * many records and only requests the next page while the stream is not
+   * paused. A consumer that cannot keep up should pause the stream, e.g. by
+   * piping it into a writable stream. The scan policy's
+   * {@link ScanPolicy#maxRecords} still limits the total number of records.
+   * Not supported for paginated scans.
+   *
+   * @member {number} Scan#highWaterMark
+   * @since v6.4.0
+   */
+  this.highWaterMark = options.highWaterMark
+
   /**
    * If set to <code>true</code>, all cluster nodes will be scanned in parallel.
    *
@@ -498,6 +528,18 @@ Scan.prototype.foreach = function (policy, dataCb, errorCb, endCb) {
     args.push(this.scanState)
     const cmd = new Commands.ScanPages(stream, args)
     cmd.execute()
+  } else if (this.highWaterMark > 0) {
+    stream.highWaterMark = this.highWaterMark
+    stream._paginate(policy && policy.maxRecords, (state, maxRecords) => {
+      // The server may still be winding down the previous page, so every
+      // page is executed under a new scan ID.
+      const pageID = state ? Job.safeRandomJobID() : scanID
+      const pagePolicy = Object.assign({}, policy, { maxRecords })
+      const cmd = new Commands.ScanPages(stream, [this.ns, this.set, this, pagePolicy, pageID, state])
+      stream.job = new Job(this.client, pageID, 'scan')
+      cmd.execute()
+    })
+    return stream
   } else {
     const cmd = new Commands.Scan(stream, args)
     cmd.execute()
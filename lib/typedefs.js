@@ -37,6 +37,11 @@
  * actively being proccessed.
  * @property {number} commands.queued - Approximate number of commands queued
  * on the global command queue, that have not yet been started.
+ * @property {number} commands.pipelined - Number of commands in flight on
+ * pipeline connections; see {@link Config#pipeline}.
+ * @property {number} eventLoops - Number of event loops registered with the
+ * client library: one for the main thread and one per worker thread, where
+ * the loops of worker threads that have exited are reused by later workers.
  * @property {Object[]} nodes - Array of node stats
  * @property {string} nodes.name - Node ID
  * @property {Object} nodes.syncConnections - Synchronous connection stats
@@ -51,11 +56,56 @@
  * summary of those pools for this node.
  * @property {number} nodes.asyncConnections.inUse - Connections actively being
  * used in database transactions for this node.
+ * @property {Object} nodes.pipelineConnections - Pipeline connection stats,
+ * with the same properties as <code>nodes.asyncConnections</code>.
+ * @property {Object} latency - Latency histograms of the commands sent by this
+ * client instance since it was created or since {@link Client#resetStats} was
+ * last called, in microseconds. Has one property per command type
+ * (<code>get</code>, <code>put</code>, <code>remove</code>,
+ * <code>operate</code>, <code>apply</code>, <code>batch</code>,
+ * <code>scan</code>, <code>query</code>, <code>info</code>), each with a
+ * {@link LatencyHistogram} per phase: <code>request</code> (converting the
+ * arguments and submitting the command), <code>roundTrip</code> (until the
+ * response, or for scans and queries the first record, has been received,
+ * incl. any time the command spent queued), <code>response</code> (converting
+ * the response) and <code>total</code>.
+ * @property {Object} latency.namespaces - Total latency histograms per
+ * namespace and command type. Batch and info commands are not included.
+ * @property {Object} [cache] - Record cache stats, if the client has a
+ * {@link Config#readCache}: the number of <code>hits</code>,
+ * <code>misses</code> and <code>evictions</code>, and the current number of
+ * <code>entries</code> and their estimated <code>memory</code> in bytes.
+ * @property {Object} memory - Native memory held by the client library, shared
+ * by all client instances of the process. Has one property per subsystem
+ * (<code>conversion</code>, <code>batch</code>, <code>scanQueue</code>,
+ * <code>txn</code>, <code>expression</code>, <code>cache</code>), each with
+ * the estimated <code>bytes</code> and the <code>count</code> of allocations
+ * it currently holds. Memory that lives as long as a JS object, or beyond a
+ * single command, is also reported to V8 as external memory, so that the
+ * garbage collector takes it into account. Added in v6.4.0.
  *
  * @see Client#stats
  * @since v3.8.0
  */
 
+/**
+ * @typedef {Object} LatencyHistogram
+ *
+ * @summary Summary of a latency histogram, in microseconds. Values are
+ * recorded with a precision of 1/8, i.e. percentiles are upper bounds that are
+ * at most 12.5% higher than the actual latency.
+ *
+ * @property {number} count - Number of commands recorded.
+ * @property {number} [mean] - Mean latency.
+ * @property {number} [p50] - Median latency.
+ * @property {number} [p90] - 90th percentile.
+ * @property {number} [p99] - 99th percentile.
+ * @property {number} [p999] - 99.9th percentile.
+ * @property {number} [max] - Maximum latency.
+ *
+ * @since v6.4.0
+ */
+
 /**
  * @callback doneCallback
  *
@@ -224,6 +274,14 @@
  * @since v4.0.0
  */
 
+/**
+ * @typedef {object} CompiledExpression
+ *
+ * @summary Filter expression compiled by {@link module:aerospike/exp.compile|exp.compile}
+ *
+ * @since v6.4.0
+ */
+
 /**
  * @typedef {Object} Policies
  *
@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * Copyright 2013-2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <nan.h>
+
+/**
+ *  Bump allocator for the temporary values a command builds while converting
+ *  its arguments. Allocations are carved out of a few contiguous chunks and
+ *  released all at once by Reset(); individual allocations are never freed.
+ *
+ *  Values allocated from an arena must be initialized with their free flags
+ *  cleared (e.g. as_string_init(s, value, false)), so that destroying them
+ *  does not hand arena memory to free().
+ */
+class Arena {
+  public:
+	Arena();
+	~Arena();
+
+	void *Alloc(size_t size);
+	char *Strdup(const char *str, size_t len);
+	void Reset();
+
+  private:
+	struct Chunk {
+		Chunk *next;
+		size_t size;
+	};
+
+	Chunk *chunks = NULL;
+	char *cursor = NULL;
+	char *limit = NULL;
+	size_t allocated = 0;
+
+	void AddChunk(size_t min_size);
+	void FreeChunks();
+};
+
+/**
+ *  Makes an arena from the calling thread's pool the current arena until the
+ *  scope ends; the arena is then reset and returned to the pool.
+ *
+ *  A scope may only be used around conversions whose results are serialized
+ *  before it ends, i.e. by async commands that are submitted within it.
+ */
+class ArenaScope {
+  public:
+	ArenaScope();
+	~ArenaScope();
+
+  private:
+	Arena *arena;
+	Arena *previous;
+};
+
+/**
+ *  Makes conversions allocate from the heap until the scope ends.
+ */
+class HeapScope {
+  public:
+	HeapScope();
+	~HeapScope();
+
+  private:
+	Arena *previous;
+};
+
+/**
+ *  Returns the current arena of the calling thread, or NULL if conversions
+ *  should allocate from the heap.
+ */
+Arena *arena_current();
+
+/**
+ *  Runs a native method without a current arena. Every method exposed to JS
+ *  is registered through this wrapper: converting the arguments of a command
+ *  within an ArenaScope may run JS getters, and a native method called by
+ *  them must not allocate values that it keeps (e.g. batch records that are
+ *  serialized again on retry) from the arena of the enclosing command, which
+ *  is reset as soon as that command has been submitted.
+ */
+template <Nan::FunctionCallback method> NAN_METHOD(native_entry)
+{
+	HeapScope heap_scope;
+	method(info);
+}
+
+// Like NAN_EXPORT, but wraps the function in native_entry.
+#define NATIVE_EXPORT(target, name)                                            \
+	Nan::Export(target, #name, native_entry<name>)
@@ -20,6 +20,7 @@ extern "C" {
 #include <aerospike/aerospike.h>
 #include <aerospike/aerospike_batch.h>
 #include <aerospike/as_event.h>
+#include <aerospike/as_node.h>
 #include <aerospike/aerospike_txn.h>
 }
 
@@ -29,6 +30,31 @@ extern "C" {
 #include "client.h"
 #include "command.h"
 
+/**
+ *  Returns the C client event loop registered for the current isolate, or
+ *  NULL if none has been registered yet. Async commands must be submitted to
+ *  this loop so that their listeners run on the isolate's own thread.
+ */
+as_event_loop *async_event_loop();
+
+/**
+ *  Registers an event loop for the current isolate with the C client: the
+ *  main thread's libuv loop, or a pooled loop run from a worker's libuv loop.
+ */
+as_status async_event_loop_register(as_error *err, as_policy_event *policy);
+
+/**
+ *  Releases the current isolate's event loop. A worker's pooled loop is
+ *  returned to the pool once the worker's commands have completed. All loops
+ *  are closed once none is in use and no cluster is left.
+ */
+void async_event_loop_close();
+
+/**
+ *  Sets whether the current isolate's event loop keeps its libuv loop alive.
+ */
+void async_event_loop_ref(bool ref);
+
 /**
  *  Setup an asynchronous invocation of a function using libuv worker threads.
  */
@@ -38,10 +64,35 @@ async_invoke(const Nan::FunctionCallbackInfo<v8::Value> &args,
 			 void (*execute)(uv_work_t *req),
 			 void (*respond)(uv_work_t *req, int status));
 
+/**
+ *  Sends the command's info request to the given cluster nodes on the current
+ *  isolate's event loop. The command is owned by the info listener from here
+ *  on: its respond function is called, and the command deleted, once every
+ *  node has either responded or failed.
+ */
+void async_info_send(InfoCommand *cmd, as_node **nodes, uint32_t n_nodes);
+
+/**
+ *  Sends the command's info request to a random cluster node; see
+ *  async_info_send.
+ */
+void async_info_send_any(InfoCommand *cmd);
+
+/**
+ *  Checks an info response for an error reported by the server and returns
+ *  the corresponding status, populating err.
+ */
+as_status async_info_check(as_error *err, const char *response);
+
 // implements the as_async_record_listener interface
 void async_record_listener(as_error *err, as_record *record, void *udata,
 						   as_event_loop *event_loop);
 
+// implements the as_async_record_listener interface for RecordCommand, which
+// returns a Record instance
+void async_read_record_listener(as_error *err, as_record *record, void *udata,
+								as_event_loop *event_loop);
+
 // implements the as_async_write_listener interface
 void async_write_listener(as_error *err, void *udata,
 						  as_event_loop *event_loop);
@@ -54,6 +105,20 @@ void async_value_listener(as_error *err, as_val *value, void *udata,
 void async_batch_listener(as_error *err, as_batch_read_records *records,
 						  void *udata, as_event_loop *event_loop);
 
+// implements the as_async_batch_listener interface for batch records created
+// by the batch_*_records_from_keys functions
+void async_batch_keys_listener(as_error *err, as_batch_records *records,
+							   void *udata, as_event_loop *event_loop);
+
+// implements the as_async_batch_listener interface for batch records created
+// by batch_read_records_from_digests; the results have no keys
+void async_batch_digests_listener(as_error *err, as_batch_records *records,
+								  void *udata, as_event_loop *event_loop);
+
+// implements the as_pipe_listener interface; pipelined commands need no
+// action once they have been written to their connection
+void async_pipe_listener(void *udata, as_event_loop *event_loop);
+
 // implements the as_async_scan_listener and as_async_query_record_listener interfaces
 bool async_scan_listener(as_error *err, as_record *record, void *udata,
 						 as_event_loop *event_loop);
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
 #include <node.h>
 #include <nan.h>
 
@@ -23,6 +25,8 @@ extern "C" {
 #include <aerospike/aerospike.h>
 }
 
+#include "config.h"
+#include "latency.h"
 #include "log.h"
 
 #define TYPE_CHECK_REQ(val, type, msg)                                         \
@@ -54,6 +58,16 @@ class AerospikeClient : public Nan::ObjectWrap {
 	uv_async_t asyncEventCb;
 	bool closed = false;
 
+	// Shared with the client's in-flight commands, which may complete after
+	// the client has been closed.
+	std::shared_ptr<LatencyStats> latency;
+	std::shared_ptr<PipelineState> pipeline;
+	std::shared_ptr<RecordCache> cache;
+
+	// Key of the shared cluster this client uses, if any; see sharedCluster
+	// in the client config.
+	std::string shared_cluster;
+
 	/***************************************************************************
 	 *  PRIVATE
 	 **************************************************************************/
@@ -64,7 +78,7 @@ class AerospikeClient : public Nan::ObjectWrap {
 
 	static inline Nan::Persistent<v8::Function> &constructor()
 	{
-		static Nan::Persistent<v8::Function> my_constructor;
+		static thread_local Nan::Persistent<v8::Function> my_constructor;
 		return my_constructor;
 	}
 
@@ -79,6 +93,7 @@ class AerospikeClient : public Nan::ObjectWrap {
 	static NAN_METHOD(BatchExists);
 	static NAN_METHOD(BatchGet);
 	static NAN_METHOD(BatchReadAsync);
+	static NAN_METHOD(BatchReadUniform);
 	static NAN_METHOD(BatchWriteAsync);
 	static NAN_METHOD(BatchApply);
 	static NAN_METHOD(BatchRemove);
@@ -94,6 +109,7 @@ class AerospikeClient : public Nan::ObjectWrap {
 	static NAN_METHOD(GetAsync);
 	static NAN_METHOD(GetNodes);
 	static NAN_METHOD(GetStats);
+	static NAN_METHOD(ResetStats);
 	static NAN_METHOD(HasPendingAsyncCommands);
 	static NAN_METHOD(InfoAny);
 	static NAN_METHOD(InfoForeach);
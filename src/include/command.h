@@ -16,8 +16,23 @@
 
 #pragma once
 
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
 #include "client.h"
+#include "latency.h"
 #include "log.h"
+#include "record_cache.h"
+
+extern "C" {
+#include <aerospike/as_event.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_listener.h>
+#include <aerospike/as_policy.h>
+#include <aerospike/as_record.h>
+}
 
 #define CmdSetError(__cmd, __code, __fmt, ...)                                 \
 	__cmd->SetError(__code, __func__, __FILE__, __LINE__, __fmt, ##__VA_ARGS__);
@@ -25,23 +40,48 @@
 	__cmd->ErrorCallback(__code, __func__, __FILE__, __LINE__, __fmt,          \
 						 ##__VA_ARGS__);
 
-class AerospikeCommand : public Nan::AsyncResource {
+/**
+ *  Per-isolate data shared by all commands with the same name.
+ */
+typedef struct CommandType {
+	// Interned async resource name, e.g. "aerospike:GetCommand".
+	Nan::Persistent<v8::String> resource_name;
+	LatencyType latency_type;
+} CommandType;
+
+/**
+ *  Returns the command type for the given command name, which must be a
+ *  string literal; types are looked up by the address of the name.
+ */
+const CommandType *command_type(const char *name);
+
+/**
+ *  Enables or disables the creation of an async_hooks resource for each
+ *  command of the current isolate. Without it, command callbacks are invoked
+ *  outside of any async context.
+ */
+NAN_METHOD(setAsyncResourcesEnabled);
+
+class AerospikeCommand {
   public:
-	AerospikeCommand(std::string name, AerospikeClient *client,
-					 v8::Local<v8::Function> callback_)
-		: Nan::AsyncResource(("aerospike:" + name + "Command").c_str()),
-		  as(client->as), log(client->log), cmd(name)
-	{
-		as_error_init(&err);
-		callback.Reset(callback_);
-	}
+	AerospikeCommand(const char *name, AerospikeClient *client,
+					 v8::Local<v8::Function> callback_);
 
-	~AerospikeCommand()
+	virtual ~AerospikeCommand()
 	{
 		Nan::HandleScope scope;
+		RecordLatency();
+		if (pipelined) {
+			pipeline->in_flight--;
+		}
 		callback.Reset();
 	}
 
+	// Commands are allocated from per-thread free lists, one per size class,
+	// i.e. effectively one per command class.
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr, size_t size);
+
 	AerospikeCommand *SetError(as_status code, const char *func,
 							   const char *file, uint32_t line, const char *fmt,
 							   ...);
@@ -55,20 +95,163 @@ class AerospikeCommand : public Nan::AsyncResource {
 									   const char *file, uint32_t line,
 									   const char *fmt, ...);
 
+	// Returns the isolate's event loop to submit the command to and marks the
+	// command as submitted; see LatencyStats for the phases recorded.
+	as_event_loop *EventLoop();
+	// Marks the response as received by the command's listener.
+	void Received();
+	// Same for batch commands; batch writes invalidate the keys of their
+	// write records again.
+	void Received(as_batch_records *records);
+	// Sets the namespace the command's latency is recorded for.
+	void SetNamespace(const char *ns);
+	// Returns the pipe listener to submit the command with, or NULL to send it
+	// on a regular async connection, if the client does not pipeline commands
+	// or has reached its max. pipeline depth.
+	as_pipe_listener PipeListener();
+
+	// Reads the key's record from the client's record cache into out, if the
+	// client has a cache and the policy allows it; see RecordCache::Get. On a
+	// miss, a record received by the command is added to the cache if store
+	// is set; see CacheStore.
+	bool CacheGet(as_key *key, const as_policy_read *policy, bool all_bins,
+				  const char *const *bins, uint32_t n_bins, bool store,
+				  as_record *out);
+	// Same for the read records of a batch; the records are only read from
+	// the cache if all of them are cached.
+	bool CacheGet(as_batch_records *records, const as_policy_batch *policy);
+	// Invalidates the key in the client's record cache, when the command is
+	// sent and again once it has completed.
+	void CacheInvalidate(as_key *key);
+	// Invalidates the keys of the write records of a batch, when the command
+	// is sent and again once it has completed.
+	void CacheInvalidate(as_batch_records *records);
+	// Adds the record(s) received by the command to the record cache; must be
+	// called before the records are converted to JS.
+	void CacheStore(as_record *record);
+	void CacheStore(as_batch_records *records);
+
 	aerospike *as;
 	as_error err;
 	LogInfo *log;
 
+  protected:
+	Nan::MaybeLocal<v8::Value> runInAsyncScope(v8::Local<v8::Object> target,
+											   v8::Local<v8::Function> func,
+											   int argc,
+											   v8::Local<v8::Value> argv[]);
+
   private:
-	std::string cmd;
+	const char *cmd;
 	Nan::Persistent<v8::Function> callback;
+	std::optional<Nan::AsyncResource> async_resource;
+
+	std::shared_ptr<LatencyStats> latency;
+	LatencyType latency_type;
+	as_namespace ns;
+	uint64_t created_ns;
+	uint64_t submitted_ns = 0;
+	uint64_t received_ns = 0;
+	uint64_t responded_ns = 0;
+
+	std::shared_ptr<PipelineState> pipeline;
+	bool pipelined = false;
+
+	enum {
+		CACHE_NONE,
+		CACHE_STORE,
+		CACHE_INVALIDATE,
+		CACHE_INVALIDATE_BATCH
+	} cache_mode = CACHE_NONE;
+	std::shared_ptr<RecordCache> cache;
+	as_key cache_key;
+	uint64_t cache_epoch = 0;
+
+	void RecordLatency();
 };
 
 class AsyncCommand : public AerospikeCommand {
   public:
-	AsyncCommand(std::string name, AerospikeClient *client,
+	AsyncCommand(const char *name, AerospikeClient *client,
 				 v8::Local<v8::Function> callback)
 		: AerospikeCommand(name, client, callback)
 	{
 	}
 };
+
+/**
+ *  Single-record read command. The key passed by the caller becomes the key
+ *  of the Record instance the command returns.
+ */
+class RecordCommand : public AsyncCommand {
+  public:
+	RecordCommand(const char *name, AerospikeClient *client,
+				  v8::Local<v8::Function> callback, v8::Local<v8::Value> key_)
+		: AsyncCommand(name, client, callback)
+	{
+		key.Reset(key_);
+	}
+
+	~RecordCommand()
+	{
+		Nan::HandleScope scope;
+		key.Reset();
+	}
+
+	Nan::Persistent<v8::Value> key;
+};
+
+/**
+ *  Scan/query command that can deliver up to records_per_callback records per
+ *  JS callback, as an array of Record instances, instead of calling back once
+ *  per record.
+ */
+class StreamCommand : public AsyncCommand {
+  public:
+	StreamCommand(const char *name, AerospikeClient *client,
+				  v8::Local<v8::Function> callback)
+		: AsyncCommand(name, client, callback), records_per_callback(1),
+		  buffered(0)
+	{
+	}
+
+	~StreamCommand()
+	{
+		Nan::HandleScope scope;
+		records.Reset();
+	}
+
+	v8::Local<v8::Value> RecordCallback(as_record *record);
+	v8::Local<v8::Value> FlushRecords();
+
+	uint32_t records_per_callback;
+
+  private:
+	uint32_t buffered;
+	Nan::Persistent<v8::Array> records;
+};
+
+/**
+ *  Info command sent to one or more cluster nodes on the event loop. The
+ *  response and status of each node are collected in responses/statuses, and
+ *  the first error in err; once the last node has responded, respond is
+ *  called and the command is deleted.
+ */
+class InfoCommand : public AsyncCommand {
+  public:
+	InfoCommand(const char *name, AerospikeClient *client,
+				v8::Local<v8::Function> callback,
+				void (*respond_)(InfoCommand *cmd))
+		: AsyncCommand(name, client, callback), respond(respond_)
+	{
+	}
+
+	as_policy_info policy;
+	as_policy_info *p_policy = NULL;
+	std::string request;
+	std::vector<std::string> nodes;
+	std::vector<std::string> responses;
+	std::vector<as_status> statuses;
+	uint32_t pending = 0;
+	void (*respond)(InfoCommand *cmd);
+};
@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * Copyright 2013-2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+#pragma once
+
+#include <node.h>
+#include <nan.h>
+
+extern "C" {
+#include <aerospike/as_exp.h>
+}
+
+#include "log.h"
+
+/**
+ *  A filter expression compiled once by exp.compile() and shared by any
+ *  number of policies. Commands borrow the compiled bytes via Borrow() and
+ *  hand them back via Release(); the as_exp is freed once the JS object has
+ *  been garbage collected and no in-flight command still references it.
+ */
+class CompiledExpression : public Nan::ObjectWrap {
+
+	/***************************************************************************
+	 *  PUBLIC
+	 **************************************************************************/
+  public:
+	static void Init();
+	static bool HasInstance(v8::Local<v8::Value> value);
+	static v8::Local<v8::Value> NewInstance(v8::Local<v8::Array> entries);
+
+	static as_exp *Borrow(v8::Local<v8::Object> obj);
+	static void Adopt(as_exp *exp);
+	static void Retain(as_exp *exp);
+	static bool Release(as_exp *exp);
+
+	as_exp *exp;
+
+	/***************************************************************************
+	 *  PRIVATE
+	 **************************************************************************/
+  private:
+	CompiledExpression(as_exp *exp);
+	~CompiledExpression();
+
+	static inline Nan::Persistent<v8::Function> &constructor()
+	{
+		static thread_local Nan::Persistent<v8::Function> my_constructor;
+		return my_constructor;
+	}
+
+	static inline Nan::Persistent<v8::FunctionTemplate> &function_template()
+	{
+		static thread_local Nan::Persistent<v8::FunctionTemplate> my_template;
+		return my_template;
+	}
+
+	static NAN_METHOD(New);
+
+	static NAN_METHOD(GetSize);
+};
@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <memory>
 #include <node.h>
 #include "log.h"
+#include "record_cache.h"
 
 extern "C" {
 #include <aerospike/as_policy.h>
@@ -25,3 +27,26 @@ extern "C" {
 
 int config_from_jsobject(as_config *config, v8::Local<v8::Object> obj,
 						 const LogInfo *log);
+
+/**
+ *  Pipelining settings of a client, and the number of its commands in flight
+ *  on pipeline connections; see Config#pipeline.
+ */
+typedef struct PipelineState {
+	bool enabled = false;
+	// Max. number of pipelined commands in flight per cluster node; 0 means
+	// no limit.
+	uint32_t max_depth = 0;
+	// Only accessed on the thread of the client's isolate.
+	uint32_t in_flight = 0;
+} PipelineState;
+
+int pipeline_from_jsobject(PipelineState *pipeline, v8::Local<v8::Object> obj,
+						   const LogInfo *log);
+
+/**
+ *  Creates the client's record cache, if the config enables one; see
+ *  Config#readCache.
+ */
+int record_cache_from_jsobject(std::shared_ptr<RecordCache> *cache,
+							   v8::Local<v8::Object> obj, const LogInfo *log);
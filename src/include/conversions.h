@@ -60,6 +60,8 @@ bool is_double_value(v8::Local<v8::Value> value);
 double double_value(v8::Local<v8::Value> value);
 
 bool is_transaction_value(v8::Local<v8::Value> value);
+bool is_compiled_expression_value(v8::Local<v8::Value> value);
+bool is_frozen_policy_value(v8::Local<v8::Value> value);
 
 bool is_geojson_value(v8::Local<v8::Value> value);
 
@@ -134,6 +136,36 @@ int get_optional_report_dir_property(char **report_dir, bool *defined, int* size
 								v8::Local<v8::Object> obj, const char *prop,
 								const LogInfo *log);
 
+// Overloads taking a cached property name (see property_names.h)
+int get_bool_property(bool *boolp, v8::Local<v8::Object> obj,
+					  v8::Local<v8::String> prop, const LogInfo *log);
+int get_bytes_property(uint8_t **bytes, int *size, v8::Local<v8::Object> obj,
+					   v8::Local<v8::String> prop, const LogInfo *log);
+int get_int_property(int *intp, v8::Local<v8::Object> obj,
+					 v8::Local<v8::String> prop, const LogInfo *log);
+int get_int64_property(int64_t *intp, v8::Local<v8::Object> obj,
+					   v8::Local<v8::String> prop, const LogInfo *log);
+int get_uint64_property(uint64_t *intp, v8::Local<v8::Object> obj,
+						v8::Local<v8::String> prop, const LogInfo *log);
+int get_asval_property(as_val **value, v8::Local<v8::Object> obj,
+					   v8::Local<v8::String> prop, const LogInfo *log);
+int get_string_property(char **strp, v8::Local<v8::Object> obj,
+						v8::Local<v8::String> prop, const LogInfo *log);
+int get_float_property(double *floatp, v8::Local<v8::Object> obj,
+					   v8::Local<v8::String> prop, const LogInfo *log);
+int get_optional_bool_property(bool *boolp, bool *defined,
+							   v8::Local<v8::Object> obj,
+							   v8::Local<v8::String> prop, const LogInfo *log);
+int get_optional_transaction_property(as_txn **txn, bool *defined,
+									  v8::Local<v8::Object> obj,
+									  v8::Local<v8::String> prop,
+									  const LogInfo *log);
+int get_optional_uint32_property(uint32_t *intp, bool *defined,
+								 v8::Local<v8::Object> obj,
+								 v8::Local<v8::String> prop,
+								 const LogInfo *log);
+
+
 // Functions to convert C client structure to v8 object(map)
 v8::Local<v8::Object> error_to_jsobject(as_error *error, const LogInfo *log);
 v8::Local<v8::Value> val_to_jsvalue(as_val *val, const LogInfo *log);
@@ -141,6 +173,7 @@ v8::Local<v8::Object> recordbins_to_jsobject(const as_record *record,
 											 const LogInfo *log);
 v8::Local<v8::Object> recordmeta_to_jsobject(const as_record *record,
 											 const LogInfo *log);
+v8::Local<v8::Number> recordttl_to_jsnumber(const as_record *record);
 v8::Local<v8::Object> record_to_jsobject(const as_record *record,
 										 const as_key *key, const LogInfo *log);
 v8::Local<v8::Object> key_to_jsobject(const as_key *key, const LogInfo *log);
@@ -164,6 +197,8 @@ int host_from_jsobject(v8::Local<v8::Object> obj, char **addr, uint16_t *port,
 int datacenter_from_jsobject(v8::Local<v8::Value> v8_dc, char **dc,
 					   const LogInfo *log);
 int log_from_jsobject(LogInfo *log, v8::Local<v8::Object> obj);
+// Large Buffer bins are referenced, not copied: rec must be serialized while
+// obj is still reachable.
 int recordbins_from_jsobject(as_record *rec, v8::Local<v8::Object> obj,
 							 const LogInfo *log);
 int recordmeta_from_jsobject(as_record *rec, v8::Local<v8::Object> obj,
@@ -178,7 +213,8 @@ int batch_read_records_from_jsarray(as_batch_read_records **batch,
 									v8::Local<v8::Array> arr,
 									const LogInfo *log);
 v8::Local<v8::Array> batch_records_to_jsarray(const as_batch_records *records,
-											  const LogInfo *log);
+											  const LogInfo *log,
+											  bool with_keys = true);
 int batch_records_from_jsarray(as_batch_records **batch,
 							   v8::Local<v8::Array> arr, const LogInfo *log);
 int batch_read_record_from_jsobject(as_batch_records *batch,
@@ -193,7 +229,38 @@ int batch_apply_record_from_jsobject(as_batch_records *batch,
 int batch_remove_record_from_jsobject(as_batch_records *batch,
 									  v8::Local<v8::Object> obj,
 									  const LogInfo *log);
+// Create and destroy batch record lists, accounting for their memory.
+as_batch_records *batch_records_create(uint32_t capacity);
+void batch_records_destroy(as_batch_records *records);
 void batch_records_free(as_batch_records *records, const LogInfo *log);
+// Build batch records for a list of keys which all share the same bin names,
+// operations, UDF arguments and/or policy. The shared arguments are borrowed, not copied;
+// release the records with batch_records_destroy.
+int batch_read_records_from_keys(as_batch_records **records,
+								 v8::Local<v8::Array> keys, char **bin_names,
+								 uint32_t n_bin_names, bool read_all_bins,
+								 as_operations *ops,
+								 const as_policy_batch_read *policy,
+								 const LogInfo *log);
+// Like batch_read_records_from_keys, for n_keys keys given by namespace, set
+// and a contiguous array of n_keys digests.
+int batch_read_records_from_digests(as_batch_records **records,
+									const char *ns, const char *set,
+									const uint8_t *digests, uint32_t n_keys,
+									char **bin_names, uint32_t n_bin_names,
+									bool read_all_bins, as_operations *ops,
+									const as_policy_batch_read *policy,
+									const LogInfo *log);
+int batch_apply_records_from_keys(as_batch_records **records,
+								  v8::Local<v8::Array> keys,
+								  const as_policy_batch_apply *policy,
+								  const char *module, const char *function,
+								  as_list *arglist, const LogInfo *log);
+int batch_remove_records_from_keys(as_batch_records **records,
+								   v8::Local<v8::Array> keys,
+								   const as_policy_batch_remove *policy,
+								   const LogInfo *log);
+
 int udfargs_from_jsobject(char **filename, char **funcname, as_list **args,
 						  v8::Local<v8::Object> obj, const LogInfo *log);
 
@@ -226,6 +293,8 @@ bool record_clone(const as_record *src, as_record **dest, const LogInfo *log);
 bool key_clone(const as_key *src, as_key **dest, const LogInfo *log,
 			   bool alloc_key = true);
 as_val *asval_clone(const as_val *val, const LogInfo *log);
+// Returns NULL for types that are never stored inline.
+as_val *asval_copy_inline(const as_val *val);
 
 // Functions to set metadata of the record.
 int setTTL(v8::Local<v8::Object> obj, uint32_t *ttl, const LogInfo *log);
@@ -25,3 +25,8 @@ extern "C" {
 v8::Local<v8::Object> exp_opcode_values();
 int compile_expression(v8::Local<v8::Array> exp_ary, as_exp **filter_exp,
 					   const LogInfo *log);
+int filter_expression_from_jsvalue(as_exp **filter_exp,
+								   v8::Local<v8::Value> value,
+								   const LogInfo *log);
+as_exp *own_expression(as_exp *exp);
+void release_expression(as_exp *exp);
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * Copyright 2013-2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+#pragma once
+
+#include <node.h>
+#include <nan.h>
+
+extern "C" {
+#include <aerospike/as_policy.h>
+}
+
+#include "log.h"
+
+/**
+ *  A policy that has been converted to its C client struct once, by
+ *  policy.freeze(). The *policy_from_jsobject() functions copy the struct
+ *  instead of converting the policy's properties on every command.
+ */
+class FrozenPolicy : public Nan::ObjectWrap {
+
+	/***************************************************************************
+	 *  PUBLIC
+	 **************************************************************************/
+  public:
+	enum Type {
+		READ,
+		WRITE,
+		APPLY,
+		OPERATE,
+		REMOVE,
+		BATCH,
+		BATCH_READ,
+		BATCH_WRITE,
+		BATCH_APPLY,
+		BATCH_REMOVE
+	};
+
+	static void Init();
+	static bool HasInstance(v8::Local<v8::Value> value);
+	static v8::Local<v8::Value> NewInstance(v8::Local<v8::String> type,
+											v8::Local<v8::Object> policy);
+
+	static int Copy(as_policy_read *policy, v8::Local<v8::Object> obj,
+					const LogInfo *log);
+	static int Copy(as_policy_write *policy, v8::Local<v8::Object> obj,
+					const LogInfo *log);
+	static int Copy(as_policy_apply *policy, v8::Local<v8::Object> obj,
+					const LogInfo *log);
+	static int Copy(as_policy_operate *policy, v8::Local<v8::Object> obj,
+					const LogInfo *log);
+	static int Copy(as_policy_remove *policy, v8::Local<v8::Object> obj,
+					const LogInfo *log);
+	static int Copy(as_policy_batch *policy, v8::Local<v8::Object> obj,
+					const LogInfo *log);
+	static int Copy(as_policy_batch_read *policy, v8::Local<v8::Object> obj,
+					const LogInfo *log);
+	static int Copy(as_policy_batch_write *policy, v8::Local<v8::Object> obj,
+					const LogInfo *log);
+	static int Copy(as_policy_batch_apply *policy, v8::Local<v8::Object> obj,
+					const LogInfo *log);
+	static int Copy(as_policy_batch_remove *policy, v8::Local<v8::Object> obj,
+					const LogInfo *log);
+
+	/***************************************************************************
+	 *  PRIVATE
+	 **************************************************************************/
+  private:
+	FrozenPolicy();
+	~FrozenPolicy();
+
+	Type type;
+	union {
+		as_policy_read read;
+		as_policy_write write;
+		as_policy_apply apply;
+		as_policy_operate operate;
+		as_policy_remove remove;
+		as_policy_batch batch;
+		as_policy_batch_read batch_read;
+		as_policy_batch_write batch_write;
+		as_policy_batch_apply batch_apply;
+		as_policy_batch_remove batch_remove;
+	} policy;
+	as_exp *filter_exp;
+
+	static int CopyTo(void *policy, size_t size, Type type,
+					  v8::Local<v8::Object> obj, const LogInfo *log);
+
+	static inline Nan::Persistent<v8::Function> &constructor()
+	{
+		static thread_local Nan::Persistent<v8::Function> my_constructor;
+		return my_constructor;
+	}
+
+	static inline Nan::Persistent<v8::FunctionTemplate> &function_template()
+	{
+		static thread_local Nan::Persistent<v8::FunctionTemplate> my_template;
+		return my_template;
+	}
+
+	static NAN_METHOD(New);
+};
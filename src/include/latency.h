@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * Copyright 2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include <node.h>
+#include <nan.h>
+
+/*******************************************************************************
+ *  TYPES
+ ******************************************************************************/
+
+typedef enum {
+	LATENCY_GET,
+	LATENCY_PUT,
+	LATENCY_REMOVE,
+	LATENCY_OPERATE,
+	LATENCY_APPLY,
+	LATENCY_BATCH,
+	LATENCY_SCAN,
+	LATENCY_QUERY,
+	LATENCY_INFO,
+	LATENCY_TYPE_COUNT,
+	LATENCY_NONE = LATENCY_TYPE_COUNT
+} LatencyType;
+
+/**
+ * Phases of a command, as seen by the client:
+ * - request: converting the arguments and submitting the command;
+ * - roundTrip: from submitting the command until the C client hands over the
+ *   response (for scans and queries, the first record), incl. any time the
+ *   command spends queued in the C client;
+ * - response: converting the response and passing it to the JS callback;
+ * - total: from the start of the request until the callback returns.
+ */
+typedef enum {
+	LATENCY_PHASE_REQUEST,
+	LATENCY_PHASE_ROUND_TRIP,
+	LATENCY_PHASE_RESPONSE,
+	LATENCY_PHASE_TOTAL,
+	LATENCY_PHASE_COUNT
+} LatencyPhase;
+
+// Values below 2^LATENCY_SUB_BITS µs get one bucket each; above that, every
+// power of two is split into 2^LATENCY_SUB_BITS buckets, i.e. values are
+// recorded with a precision of 1/8.
+#define LATENCY_SUB_BITS 3
+#define LATENCY_MAX_EXPONENT 40
+// Maximum number of namespaces of a cluster.
+#define LATENCY_MAX_NAMESPACES 32
+
+#define LATENCY_BUCKETS                                                        \
+	((1 << LATENCY_SUB_BITS) +                                                 \
+	 (LATENCY_MAX_EXPONENT - LATENCY_SUB_BITS) * (1 << LATENCY_SUB_BITS))
+
+/**
+ * Log-linear histogram of latencies in microseconds. Recording and reading
+ * only use relaxed atomic operations.
+ */
+class LatencyHistogram {
+  public:
+	LatencyHistogram();
+
+	void Record(uint64_t us);
+	void Reset();
+	v8::Local<v8::Object> ToJSObject() const;
+
+  private:
+	std::atomic<uint64_t> buckets[LATENCY_BUCKETS];
+	std::atomic<uint64_t> count;
+	std::atomic<uint64_t> sum;
+	std::atomic<uint64_t> max;
+
+	uint64_t Percentile(uint64_t total, double percentile) const;
+};
+
+/**
+ * Latency histograms of a client, per command type and phase, and per
+ * namespace and command type.
+ */
+class LatencyStats {
+  public:
+	~LatencyStats();
+
+	void Record(LatencyType type, const char *ns, const uint64_t *phases_us);
+	void Reset();
+	v8::Local<v8::Object> ToJSObject();
+
+  private:
+	struct NamespaceStats {
+		std::string ns;
+		LatencyHistogram histograms[LATENCY_TYPE_COUNT];
+	};
+
+	LatencyHistogram histograms[LATENCY_TYPE_COUNT][LATENCY_PHASE_COUNT];
+
+	// Namespaces are only ever added, so existing entries are looked up
+	// without locking; the lock only serializes adding a new namespace.
+	std::mutex namespaces_lock;
+	std::atomic<NamespaceStats *> namespaces[LATENCY_MAX_NAMESPACES] = {};
+	std::atomic<uint32_t> namespaces_size{0};
+
+	NamespaceStats *Namespace(const char *ns);
+};
+
+/*******************************************************************************
+ *  FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * Returns the latency type recorded for the command with the given name.
+ */
+LatencyType latency_type_from_name(const char *name);
@@ -30,7 +30,8 @@ typedef struct LogInfo {
 	as_log_level level;
 } LogInfo;
 
-extern LogInfo g_log_info;
+// Default log settings of the current isolate (main or worker thread)
+extern thread_local LogInfo g_log_info;
 
 /*******************************************************************************
  *  MACROS
@@ -80,6 +81,22 @@ bool as_log_callback_fnct(as_log_level level, const char *func,
 						  const char *file, uint32_t line, const char *fmt,
 						  ...);
 
+void as_log_callback_set_log_info(const LogInfo *log);
+
+/**
+ * Enables or disables async logging for all log settings of the process.
+ * While enabled, log lines are formatted into a ring buffer of buffer_size
+ * lines and written by a background thread. If the buffer is full, lines are
+ * dropped, or, if block is set, the caller waits for the writer to catch up.
+ * The buffer size only takes effect the first time async logging is enabled.
+ */
+void as_v8_log_set_async(bool enabled, uint32_t buffer_size, bool block);
+
+/**
+ * Returns the number of lines dropped by async logging so far.
+ */
+uint64_t as_v8_log_dropped();
+
 void as_v8_log_function(const LogInfo *log, as_log_level level,
 						const char *func, const char *file, uint32_t line,
 						const char *fmt, ...);
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * Copyright 2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+#include <node.h>
+#include <nan.h>
+
+extern "C" {
+#include <aerospike/as_val.h>
+}
+
+/*******************************************************************************
+ *  TYPES
+ ******************************************************************************/
+
+/**
+ *  Subsystems of the binding whose native allocations are accounted for.
+ */
+typedef enum {
+	// Conversion arenas and prepared operation lists.
+	MEMORY_CONVERSION,
+	// Batch record lists of in-flight batch commands.
+	MEMORY_BATCH,
+	// Query and scan results queued for the event loop thread.
+	MEMORY_SCAN_QUEUE,
+	// Transactions.
+	MEMORY_TXN,
+	// Compiled and frozen filter expressions.
+	MEMORY_EXPRESSION,
+	// Records held by the client-side record cache.
+	MEMORY_CACHE,
+	MEMORY_SUBSYSTEMS
+} memory_subsystem;
+
+/*******************************************************************************
+ *  FUNCTIONS
+ ******************************************************************************/
+
+/**
+ *  Accounts for an allocation of size bytes, or for the release of one.
+ *  Allocations of long-lived subsystems are also reported to V8 as external
+ *  memory, so that the garbage collector takes the native memory held by JS
+ *  objects into account; those subsystems are only allocated and freed on
+ *  the event loop thread. Both functions may be called from any thread.
+ */
+void memory_track_alloc(memory_subsystem subsystem, size_t size);
+void memory_track_free(memory_subsystem subsystem, size_t size);
+
+/**
+ *  Estimates the memory held by a value, including nested values and the
+ *  bins of a record.
+ */
+size_t memory_val_size(const as_val *val);
+
+/**
+ *  Returns the bytes and number of allocations currently held by each
+ *  subsystem. The counters are shared by all clients of the process.
+ */
+v8::Local<v8::Object> memory_stats_to_jsobject();
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * Copyright 2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+#pragma once
+
+#pragma once
+
+#include <vector>
+
+#include <node.h>
+#include <nan.h>
+
+extern "C" {
+#include <aerospike/as_operations.h>
+}
+
+#include "log.h"
+
+/**
+ *  An operation list converted once by operations.prepare(). Values marked
+ *  with operations.param() are left as slots in the converted operations;
+ *  Bind() copies the operations and fills in the slots, so that each execution
+ *  converts only the values that change between calls.
+ */
+class PreparedOperations : public Nan::ObjectWrap {
+
+	/***************************************************************************
+	 *  PUBLIC
+	 **************************************************************************/
+  public:
+	static void Init();
+	static bool HasInstance(v8::Local<v8::Value> value);
+	static v8::Local<v8::Value> NewInstance(v8::Local<v8::Array> ops,
+											v8::Local<v8::Array> slots);
+
+	// Initializes ops with the prepared operations, the values bound to their
+	// slots. ops is destroyed again if a value cannot be converted.
+	static int Bind(as_operations *ops, v8::Local<v8::Object> obj,
+					v8::Local<v8::Array> values, const LogInfo *log);
+
+	/***************************************************************************
+	 *  PRIVATE
+	 **************************************************************************/
+  private:
+	// A value slot: either the whole value of a scalar operation (size == 0),
+	// or size bytes at offset in the packed arguments of a CDT operation.
+	struct Slot {
+		uint32_t op;
+		uint32_t param;
+		uint32_t offset;
+		uint32_t size;
+	};
+
+	PreparedOperations(uint16_t n_ops);
+	~PreparedOperations();
+
+	as_operations ops;
+	// Sorted by operation and offset.
+	std::vector<Slot> slots;
+	uint32_t n_params;
+	// Estimated memory held by ops, as accounted for.
+	size_t size;
+
+	int AddSlot(uint32_t op, uint32_t param, v8::Local<v8::Value> placeholder,
+				const LogInfo *log);
+
+	static inline Nan::Persistent<v8::Function> &constructor()
+	{
+		static thread_local Nan::Persistent<v8::Function> my_constructor;
+		return my_constructor;
+	}
+
+	static inline Nan::Persistent<v8::FunctionTemplate> &function_template()
+	{
+		static thread_local Nan::Persistent<v8::FunctionTemplate> my_template;
+		return my_template;
+	}
+
+	static NAN_METHOD(New);
+};
@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * Copyright 2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <node.h>
+#include <nan.h>
+
+/*******************************************************************************
+ *  MACROS
+ ******************************************************************************/
+
+/**
+ * Property names used by the per-record and per-command conversions. Each
+ * name is created once per isolate as an internalized V8 string, so hot paths
+ * do not have to allocate and hash a new string for every property access.
+ */
+#define AS_V8_PROPERTY_NAMES(V)                                                \
+	V(bins)                                                                    \
+	V(boolVal)                                                                 \
+	V(bytesVal)                                                                \
+	V(compress)                                                                \
+	V(count)                                                                   \
+	V(ctx)                                                                     \
+	V(digest)                                                                  \
+	V(digests)                                                                 \
+	V(filterExpression)                                                        \
+	V(floatVal)                                                                \
+	V(gen)                                                                     \
+	V(inDoubt)                                                                 \
+	V(inf)                                                                     \
+	V(intVal)                                                                  \
+	V(key)                                                                     \
+	V(listPolicy)                                                              \
+	V(mapPolicy)                                                               \
+	V(maxRetries)                                                              \
+	V(meta)                                                                    \
+	V(ns)                                                                      \
+	V(op)                                                                      \
+	V(ops)                                                                     \
+	V(policy)                                                                  \
+	V(prepared)                                                                \
+	V(readAllBins)                                                             \
+	V(record)                                                                  \
+	V(set)                                                                     \
+	V(socketTimeout)                                                           \
+	V(status)                                                                  \
+	V(strVal)                                                                  \
+	V(sz)                                                                      \
+	V(totalTimeout)                                                            \
+	V(ttl)                                                                     \
+	V(txn)                                                                     \
+	V(uintVal)                                                                 \
+	V(value)                                                                   \
+	V(values)                                                                  \
+	V(wildcard)
+
+/**
+ * Returns the cached property name string for the current isolate, e.g.
+ * Nan::Set(obj, AS_V8_NAME(ttl), value).
+ */
+#define AS_V8_NAME(__name) Nan::New(property_names()->__name)
+
+/*******************************************************************************
+ *  TYPES
+ ******************************************************************************/
+
+typedef struct PropertyNames {
+#define AS_V8_PROPERTY_NAME_FIELD(__name) Nan::Persistent<v8::String> __name;
+	AS_V8_PROPERTY_NAMES(AS_V8_PROPERTY_NAME_FIELD)
+#undef AS_V8_PROPERTY_NAME_FIELD
+} PropertyNames;
+
+/*******************************************************************************
+ *  FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * Creates the property name table for the current isolate. Must be called
+ * from the module initializer before any conversions take place.
+ */
+void property_names_init();
+
+/**
+ * Returns the property name table of the current isolate.
+ */
+const PropertyNames *property_names();
@@ -27,7 +27,7 @@ extern "C" {
 
 struct query_udata {
     as_query* query;
-    AsyncCommand* cmd;
+    StreamCommand* cmd;
     uint32_t count;
     uint32_t max_records;
     as_exp* exp;
@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * Copyright 2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <node.h>
+#include <nan.h>
+
+extern "C" {
+#include <aerospike/aerospike_batch.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_policy.h>
+#include <aerospike/as_record.h>
+}
+
+#define RECORD_CACHE_DEFAULT_MAX_MEMORY (64 * 1024 * 1024)
+#define RECORD_CACHE_DEFAULT_MAX_STALENESS 1000
+#define RECORD_CACHE_DEFAULT_SHARDS 16
+
+/*******************************************************************************
+ *  TYPES
+ ******************************************************************************/
+
+/**
+ * Client-side cache of records, keyed by namespace and digest, with a memory
+ * budget split evenly over a number of LRU shards.
+ *
+ * Cached records share the bin values of the record they were read from, i.e.
+ * a cached record costs no more than the references to its values. Entries
+ * expire with the record's TTL, and at the latest max_staleness ms after they
+ * were read. Writes through the client invalidate their key; see Invalidate.
+ */
+class RecordCache {
+  public:
+	RecordCache(uint64_t max_memory, uint32_t max_staleness_ms,
+				uint32_t n_shards);
+	~RecordCache();
+
+	// Whether reads with the given policy may be served from, and stored in,
+	// the cache. Reads with a filter expression, a transaction, a read-touch
+	// TTL, or without deserialization bypass the cache.
+	static bool Cacheable(const as_policy_read *policy);
+	static bool Cacheable(const as_policy_batch *policy);
+	static bool Cacheable(const as_batch_read_record *record);
+
+	// Initializes out with the cached bins of the key's record - all bins, or
+	// the given bins - and returns true; returns false if the key is not
+	// cached. The caller destroys out.
+	bool Get(as_key *key, bool all_bins, const char *const *bins,
+			 uint32_t n_bins, as_record *out);
+
+	// Adds the record with all its bins, unless a key has been invalidated
+	// since epoch was taken.
+	void Put(as_key *key, const as_record *record, uint64_t epoch);
+
+	// Removes the key's record; reads started before cannot add it again.
+	void Invalidate(as_key *key);
+
+	uint64_t Epoch() const { return epoch.load(std::memory_order_acquire); }
+
+	v8::Local<v8::Object> ToJSObject();
+
+  private:
+	struct Entry {
+		std::string key;
+		as_record *record;
+		// Expiration of the record itself, 0 if it never expires.
+		uint64_t void_time_ns;
+		// Expiration of the entry.
+		uint64_t expires_ns;
+		size_t size;
+	};
+
+	struct Shard {
+		std::mutex lock;
+		std::list<Entry> lru;
+		std::unordered_map<std::string, std::list<Entry>::iterator> index;
+		size_t memory = 0;
+	};
+
+	std::vector<Shard> shards;
+	size_t shard_max_memory;
+	uint64_t max_staleness_ns;
+
+	// Incremented on every invalidation.
+	std::atomic<uint64_t> epoch{0};
+
+	std::atomic<uint64_t> hits{0};
+	std::atomic<uint64_t> misses{0};
+	std::atomic<uint64_t> evictions{0};
+
+	Shard &ShardOf(const std::string &key);
+	static bool CacheKey(as_key *key, std::string *out);
+	static void Remove(Shard &shard, std::list<Entry>::iterator it);
+};
@@ -0,0 +1,59 @@
+/*******************************************************************************
+ * Copyright 2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <node.h>
+#include <nan.h>
+
+#include "log.h"
+
+extern "C" {
+#include <aerospike/as_key.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_status.h>
+}
+
+/*******************************************************************************
+ *  FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * Registers the JS Key, Record and BatchResult classes of the current isolate.
+ * Command results are then constructed as instances of these classes right
+ * away, instead of as plain objects that the JS layer has to convert again.
+ */
+NAN_METHOD(register_result_classes);
+
+/**
+ * Returns a new Key instance for the given key.
+ */
+v8::Local<v8::Value> key_to_jskey(const as_key *key, const LogInfo *log);
+
+/**
+ * Returns a new Record instance with the record's bins and metadata and the
+ * given key. If record is NULL, the instance only has the key.
+ */
+v8::Local<v8::Value> record_to_jsrecord(const as_record *record,
+										v8::Local<v8::Value> key,
+										const LogInfo *log);
+
+/**
+ * Returns a new BatchResult instance.
+ */
+v8::Local<v8::Value> batch_result_to_jsobject(as_status status,
+											  v8::Local<v8::Value> record,
+											  bool in_doubt);
@@ -24,7 +24,7 @@ extern "C" {
 
 struct scan_udata {
     as_scan* scan;
-    AsyncCommand * cmd;
+    StreamCommand * cmd;
     uint32_t count;
     uint32_t max_records;
 };
@@ -32,10 +32,13 @@ class Transaction : public Nan::ObjectWrap {
 	 **************************************************************************/
   public:
 	static void Init();
+	static bool HasInstance(v8::Local<v8::Value> value);
 	static v8::Local<v8::Value> NewInstance(v8::Local<v8::Object> capacity_obj);
 
     Nan::Persistent<v8::Object> persistent;
 	as_txn *txn;
+	// Estimated memory held by txn.
+	size_t size;
 	
 	Transaction();
 	~Transaction();
@@ -47,10 +50,16 @@ class Transaction : public Nan::ObjectWrap {
 
 	static inline Nan::Persistent<v8::Function> &constructor()
 	{
-		static Nan::Persistent<v8::Function> my_constructor;
+		static thread_local Nan::Persistent<v8::Function> my_constructor;
 		return my_constructor;
 	}
 
+	static inline Nan::Persistent<v8::FunctionTemplate> &function_template()
+	{
+		static thread_local Nan::Persistent<v8::FunctionTemplate> my_template;
+		return my_template;
+	}
+
 	static NAN_METHOD(New);
 
 	static NAN_METHOD(GetId);
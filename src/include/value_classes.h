@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * Copyright 2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <node.h>
+#include <nan.h>
+
+/*******************************************************************************
+ *  TYPES
+ ******************************************************************************/
+
+/**
+ * JS classes whose instances the conversions treat as special values.
+ */
+typedef enum {
+	VALUE_CLASS_DOUBLE,
+	VALUE_CLASS_GEOJSON,
+	VALUE_CLASS_BIN,
+	VALUE_CLASS_COUNT
+} ValueClass;
+
+/*******************************************************************************
+ *  FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * Registers the JS Double, GeoJSON and Bin classes of the current isolate, so
+ * that values can be checked against the class itself rather than by
+ * comparing constructor names.
+ */
+NAN_METHOD(register_value_classes);
+
+/**
+ * Returns true if value is an instance of the given JS class.
+ */
+bool is_value_class_instance(v8::Local<v8::Value> value, ValueClass type);
@@ -0,0 +1,59 @@
+/*******************************************************************************
+ * Copyright 2013-2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+extern "C" {
+#include <aerospike/as_val.h>
+}
+
+/**
+ *  Bounded multi-producer, single-consumer queue of values that are handed
+ *  from C client threads to the event loop thread.
+ *
+ *  Producers block while the queue is full. Push() reports when the consumer
+ *  needs to be woken up, i.e. for the first value queued since the consumer
+ *  last drained the queue, so that wakeups are coalesced without delaying
+ *  any value. Queued values are accounted for as scan queue memory.
+ */
+class ValueQueue {
+  public:
+	ValueQueue(uint32_t capacity);
+	~ValueQueue();
+
+	bool Push(as_val *val, bool *wakeup);
+	uint32_t Drain(std::vector<as_val *> &vals);
+	void Close();
+
+  private:
+	std::mutex lock;
+	std::condition_variable not_full;
+	struct Slot {
+		as_val *val;
+		size_t size;
+	};
+
+	std::vector<Slot> slots;
+	uint32_t head = 0;
+	uint32_t count = 0;
+	bool wakeup_pending = false;
+	bool closed = false;
+};
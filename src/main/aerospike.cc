@@ -15,12 +15,18 @@
  ******************************************************************************/
 
 #include "client.h"
+#include "arena.h"
 #include "enums.h"
 #include "policy.h"
 #include "operations.h"
 #include "expressions.h"
 #include "log.h"
 #include "conversions.h"
+#include "property_names.h"
+#include "result_classes.h"
+#include "value_classes.h"
+#include "async.h"
+#include "command.h"
 
 extern "C" {
 #include <aerospike/as_event.h>
@@ -29,6 +35,9 @@ extern "C" {
 }
 
 #include "transaction.h"
+#include "compiled_expression.h"
+#include "frozen_policy.h"
+#include "prepared_operations.h"
 
 
 #define export(__name, __value)                                                \
@@ -44,46 +53,38 @@ NAN_METHOD(register_as_event_loop)
 {
 	Nan::HandleScope();
 
-	if (!as_event_set_external_loop_capacity(1)) {
-		return Nan::ThrowError("Unable to register default event loop");
-	}
-
 	as_policy_event policy;
 	as_policy_event_init(&policy);
 	eventpolicy_from_jsobject(&policy, info[0].As<Object>(), &g_log_info);
 
-	as_event_loop *loop;
 	as_error err;
-	as_status status =
-		as_set_external_event_loop(&err, &policy, uv_default_loop(), &loop);
+	as_error_init(&err);
+	as_status status = async_event_loop_register(&err, &policy);
 	if (status != AEROSPIKE_OK) {
 		char errmsg[128 + AS_ERROR_MESSAGE_MAX_SIZE];
 		snprintf(errmsg, sizeof(errmsg),
-				 "Unable to register default event loop: %s [%i]", err.message,
+				 "Unable to register event loop: %s [%i]", err.message,
 				 err.code);
 		return Nan::ThrowError(errmsg);
 	}
-	uv_update_time(uv_default_loop());
 }
 
 NAN_METHOD(release_as_event_loop)
 {
 	Nan::HandleScope();
-	as_event_close_loops();
+	async_event_loop_close();
 }
 
 NAN_METHOD(ref_as_event_loop)
 {
 	Nan::HandleScope();
-	as_event_loop *loop = as_event_loop_find(uv_default_loop());
-	uv_ref((uv_handle_t *)loop->wakeup);
+	async_event_loop_ref(true);
 }
 
 NAN_METHOD(unref_as_event_loop)
 {
 	Nan::HandleScope();
-	as_event_loop *loop = as_event_loop_find(uv_default_loop());
-	uv_unref((uv_handle_t *)loop->wakeup);
+	async_event_loop_ref(false);
 }
 
 NAN_METHOD(get_cluster_count)
@@ -105,6 +106,7 @@ NAN_METHOD(setDefaultLogging)
 				as_log_set_callback(NULL);
 			}
 			else {
+				as_log_callback_set_log_info(&g_log_info);
 				as_log_set_level(g_log_info.level);
 				as_log_set_callback(as_log_callback_fnct);
 			}
@@ -112,6 +114,27 @@ NAN_METHOD(setDefaultLogging)
 	}
 }
 
+NAN_METHOD(setAsyncLogging)
+{
+	Nan::HandleScope();
+	TYPE_CHECK_REQ(info[0], IsBoolean, "enabled must be a boolean");
+	TYPE_CHECK_REQ(info[1], IsNumber, "bufferSize must be a number");
+	TYPE_CHECK_REQ(info[2], IsBoolean, "block must be a boolean");
+
+	as_v8_log_set_async(Nan::To<bool>(info[0]).FromJust(),
+						Nan::To<uint32_t>(info[1]).FromJust(),
+						Nan::To<bool>(info[2]).FromJust());
+}
+
+NAN_METHOD(getAsyncLoggingStats)
+{
+	Nan::HandleScope();
+	Local<Object> stats = Nan::New<Object>();
+	Nan::Set(stats, Nan::New("dropped").ToLocalChecked(),
+			 Nan::New((double)as_v8_log_dropped()));
+	info.GetReturnValue().Set(stats);
+}
+
 NAN_METHOD(client)
 {
 	Nan::HandleScope();
@@ -126,6 +149,42 @@ NAN_METHOD(transaction)
 	Local<Object> capacity_obj = info[0].As<Object>();
 	info.GetReturnValue().Set(Transaction::NewInstance(capacity_obj));
 }
+
+NAN_METHOD(compiled_expression)
+{
+	Nan::HandleScope();
+
+	if (!info[0]->IsArray()) {
+		return Nan::ThrowTypeError("Expression must be an array");
+	}
+	Local<Array> entries = info[0].As<Array>();
+	info.GetReturnValue().Set(CompiledExpression::NewInstance(entries));
+}
+
+NAN_METHOD(prepared_operations)
+{
+	Nan::HandleScope();
+
+	if (!info[0]->IsArray() || !info[1]->IsArray()) {
+		return Nan::ThrowTypeError(
+			"Operations and parameter slots are required");
+	}
+	Local<Array> ops = info[0].As<Array>();
+	Local<Array> slots = info[1].As<Array>();
+	info.GetReturnValue().Set(PreparedOperations::NewInstance(ops, slots));
+}
+
+NAN_METHOD(frozen_policy)
+{
+	Nan::HandleScope();
+
+	if (!info[0]->IsString() || !info[1]->IsObject()) {
+		return Nan::ThrowTypeError("Policy type and policy are required");
+	}
+	Local<String> type = info[0].As<String>();
+	Local<Object> policy = info[1].As<Object>();
+	info.GetReturnValue().Set(FrozenPolicy::NewInstance(type, policy));
+}
 /**
  *  aerospike object.
  */
@@ -133,16 +192,28 @@ NAN_MODULE_INIT(Aerospike)
 {
 	Nan::HandleScope scope;
 
+	property_names_init();
 	AerospikeClient::Init();
 	Transaction::Init();
-	NAN_EXPORT(target, client);
-	NAN_EXPORT(target, transaction);
-	NAN_EXPORT(target, get_cluster_count);
-	NAN_EXPORT(target, register_as_event_loop);
-	NAN_EXPORT(target, release_as_event_loop);
-	NAN_EXPORT(target, ref_as_event_loop);
-	NAN_EXPORT(target, unref_as_event_loop);
-	NAN_EXPORT(target, setDefaultLogging);
+	CompiledExpression::Init();
+	FrozenPolicy::Init();
+	PreparedOperations::Init();
+	NATIVE_EXPORT(target, client);
+	NATIVE_EXPORT(target, transaction);
+	NATIVE_EXPORT(target, compiled_expression);
+	NATIVE_EXPORT(target, frozen_policy);
+	NATIVE_EXPORT(target, prepared_operations);
+	NATIVE_EXPORT(target, get_cluster_count);
+	NATIVE_EXPORT(target, register_as_event_loop);
+	NATIVE_EXPORT(target, release_as_event_loop);
+	NATIVE_EXPORT(target, ref_as_event_loop);
+	NATIVE_EXPORT(target, unref_as_event_loop);
+	NATIVE_EXPORT(target, setDefaultLogging);
+	NATIVE_EXPORT(target, setAsyncLogging);
+	NATIVE_EXPORT(target, getAsyncLoggingStats);
+	NATIVE_EXPORT(target, setAsyncResourcesEnabled);
+	NATIVE_EXPORT(target, register_result_classes);
+	NATIVE_EXPORT(target, register_value_classes);
 
 	// enumerations
 	export("bitwise", bitwise_enum_values());
@@ -178,4 +249,4 @@ NAN_MODULE_INIT(Aerospike)
 
 }
 
-NODE_MODULE(aerospike, Aerospike);
+NAN_MODULE_WORKER_ENABLED(aerospike, Aerospike)
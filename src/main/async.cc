@@ -14,7 +14,13 @@
  * limitations under the License.
  ******************************************************************************/
 
+#include <atomic>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <node.h>
 #include <uv.h>
 
@@ -26,15 +32,334 @@
 #include "log.h"
 #include "scan.h"
 #include "query.h"
+#include "result_classes.h"
 
 extern "C" {
+#include <aerospike/as_async_proto.h>
 #include <aerospike/as_error.h>
+#include <aerospike/as_cluster.h>
+#include <aerospike/as_info.h>
 #include <aerospike/as_status.h>
 #include <aerospike/as_txn.h>
 }
 
 using namespace v8;
 
+// Maximum number of event loops - the main thread's plus one per worker
+// thread - that can be in use at the same time. The C client requires the
+// capacity for external event loops to be fixed up front. It never removes a
+// registered loop, so the loops of worker threads that have exited are reused
+// (see loop_slot) and do not count towards the limit.
+#define MAX_EVENT_LOOPS 256
+
+static std::mutex g_event_loops_lock;
+static bool g_event_loops_initialized = false;
+// Number of isolates currently using an event loop.
+static uint32_t g_event_loops_owned = 0;
+
+// Every isolate runs on its own thread, so a thread-local pointer identifies
+// the C client event loop of the isolate.
+static thread_local as_event_loop *g_event_loop = NULL;
+
+#if !defined(_WIN32)
+/**
+ *  The C client's tend thread and aerospike_close() keep posting work to every
+ *  registered loop, but a worker thread's libuv loop is destroyed when the
+ *  worker exits. So workers do not register their own loops. Instead, each
+ *  worker takes a libuv loop owned by the addon from a pool, and runs it from
+ *  its own loop whenever the pooled loop's backend file descriptor becomes
+ *  readable or one of its timers is due; command listeners thus still run on
+ *  the worker's thread. Once the worker has released the loop and its last
+ *  command has completed, the loop is "parked": a native thread keeps running
+ *  it until another worker takes it over. Reused loops keep the event policy
+ *  they were first registered with.
+ *
+ *  The C client starts commands issued on the thread it recorded for a loop
+ *  directly, and queues those issued on other threads for the loop's wakeup
+ *  handle. The recorded thread is therefore handed over with the slot, so that
+ *  the commands of a worker that reuses a loop start directly as well. Other
+ *  threads may read it concurrently, but never match either value.
+ *
+ *  This relies on the backend file descriptor, which libuv does not provide on
+ *  Windows.
+ */
+struct loop_slot {
+	uv_loop_t loop;
+	as_event_loop *event_loop;
+	// Stops the parking thread.
+	uv_async_t unpark;
+	std::thread parking;
+	// Set once the C client closes the loop while it is parked.
+	std::atomic<bool> closing;
+	// Handles in the worker's loop that run the slot's loop.
+	uv_poll_t *poll;
+	uv_timer_t *timer;
+	// Whether the worker has released the loop and it is to be parked once
+	// the worker's commands have completed.
+	bool releasing;
+};
+
+static std::vector<loop_slot *> g_parked_slots;
+static thread_local loop_slot *g_loop_slot = NULL;
+
+static void slot_run(loop_slot *slot);
+#endif
+
+// Closes all event loops, once no isolate uses one and no cluster is left that
+// could still post work to them. Requires the event loops lock.
+static void event_loops_close()
+{
+	if (g_event_loops_owned > 0 || as_async_get_cluster_count() > 0) {
+		return;
+	}
+
+#if !defined(_WIN32)
+	for (loop_slot *slot : g_parked_slots) {
+		// The parking thread releases the slot once the loop has been closed.
+		slot->closing = true;
+		slot->parking.detach();
+	}
+	g_parked_slots.clear();
+#endif
+	as_event_close_loops();
+	g_event_loops_initialized = false;
+}
+
+#if !defined(_WIN32)
+static void slot_unpark(uv_async_t *handle) { uv_stop(handle->loop); }
+
+static void slot_park_thread(loop_slot *slot)
+{
+	slot->event_loop->thread = pthread_self();
+	uv_run(&slot->loop, UV_RUN_DEFAULT);
+	if (!slot->closing) {
+		// Taken over by another worker, which joins this thread.
+		return;
+	}
+
+	uv_close((uv_handle_t *)&slot->unpark, NULL);
+	uv_run(&slot->loop, UV_RUN_DEFAULT);
+	uv_loop_close(&slot->loop);
+	delete slot;
+}
+
+static void slot_handle_closed(uv_handle_t *handle) { cf_free(handle); }
+
+static void slot_poll_cb(uv_poll_t *handle, int status, int events)
+{
+	slot_run((loop_slot *)handle->data);
+}
+
+static void slot_timer_cb(uv_timer_t *handle)
+{
+	slot_run((loop_slot *)handle->data);
+}
+
+// Whether the C client is still processing, or has queued, any commands on
+// the slot's loop.
+static bool slot_busy(loop_slot *slot)
+{
+	return as_event_loop_get_process_size(slot->event_loop) > 0 ||
+		   as_event_loop_get_queue_size(slot->event_loop) > 0;
+}
+
+static void slot_cleanup(void *arg);
+
+// Hands the slot over to a parking thread. Called on the worker's thread.
+static void slot_park(loop_slot *slot)
+{
+	uv_close((uv_handle_t *)slot->poll, slot_handle_closed);
+	uv_close((uv_handle_t *)slot->timer, slot_handle_closed);
+	slot->poll = NULL;
+	slot->timer = NULL;
+	g_loop_slot = NULL;
+
+	std::lock_guard<std::mutex> guard(g_event_loops_lock);
+	slot->parking = std::thread(slot_park_thread, slot);
+	g_parked_slots.push_back(slot);
+	g_event_loops_owned--;
+	event_loops_close();
+}
+
+// Runs the slot's loop without blocking, and schedules the next run for its
+// next due timer.
+static void slot_run(loop_slot *slot)
+{
+	uv_run(&slot->loop, UV_RUN_NOWAIT);
+
+	if (slot->releasing && !slot_busy(slot)) {
+		node::RemoveEnvironmentCleanupHook(Isolate::GetCurrent(), slot_cleanup,
+										   slot);
+		slot_park(slot);
+		return;
+	}
+
+	int timeout = uv_backend_timeout(&slot->loop);
+	if (timeout >= 0) {
+		uv_timer_start(slot->timer, slot_timer_cb, timeout, 0);
+	}
+	else {
+		uv_timer_stop(slot->timer);
+	}
+}
+
+// Environment cleanup hook of a worker that still uses a slot. Completes the
+// worker's commands in flight, whose listeners must not run on the parking
+// thread; they are bounded by the commands' timeouts.
+static void slot_cleanup(void *arg)
+{
+	loop_slot *slot = (loop_slot *)arg;
+	g_event_loop = NULL;
+
+	uv_run(&slot->loop, UV_RUN_NOWAIT);
+	while (slot_busy(slot)) {
+		uv_run(&slot->loop, UV_RUN_ONCE);
+	}
+	slot_park(slot);
+}
+
+// Takes a parked slot, or registers a new one with the C client, and starts
+// running it from the current isolate's loop. Requires the event loops lock.
+static as_status slot_acquire(as_error *err, as_policy_event *policy)
+{
+	loop_slot *slot;
+	if (!g_parked_slots.empty()) {
+		slot = g_parked_slots.back();
+		g_parked_slots.pop_back();
+		uv_async_send(&slot->unpark);
+		slot->parking.join();
+		slot->event_loop->thread = pthread_self();
+	}
+	else {
+		slot = new loop_slot();
+		slot->closing = false;
+		uv_loop_init(&slot->loop);
+		uv_async_init(&slot->loop, &slot->unpark, slot_unpark);
+		// Only the C client's handles keep a parked loop running.
+		uv_unref((uv_handle_t *)&slot->unpark);
+
+		as_status status = as_set_external_event_loop(
+			err, policy, &slot->loop, &slot->event_loop);
+		if (status != AEROSPIKE_OK) {
+			uv_close((uv_handle_t *)&slot->unpark, NULL);
+			uv_run(&slot->loop, UV_RUN_DEFAULT);
+			uv_loop_close(&slot->loop);
+			delete slot;
+			return status;
+		}
+	}
+
+	uv_loop_t *loop = Nan::GetCurrentEventLoop();
+	slot->poll = (uv_poll_t *)cf_malloc(sizeof(uv_poll_t));
+	uv_poll_init(loop, slot->poll, uv_backend_fd(&slot->loop));
+	slot->poll->data = slot;
+	uv_poll_start(slot->poll, UV_READABLE, slot_poll_cb);
+	// Only the poll handle keeps the worker's loop alive, as the C client's
+	// wakeup handle does the main thread's.
+	slot->timer = (uv_timer_t *)cf_malloc(sizeof(uv_timer_t));
+	uv_timer_init(loop, slot->timer);
+	slot->timer->data = slot;
+	uv_unref((uv_handle_t *)slot->timer);
+	slot->releasing = false;
+
+	node::AddEnvironmentCleanupHook(Isolate::GetCurrent(), slot_cleanup, slot);
+	g_loop_slot = slot;
+	g_event_loop = slot->event_loop;
+	uv_timer_start(slot->timer, slot_timer_cb, 0, 0);
+	return AEROSPIKE_OK;
+}
+#endif
+
+as_event_loop *async_event_loop() { return g_event_loop; }
+
+as_status async_event_loop_register(as_error *err, as_policy_event *policy)
+{
+	std::lock_guard<std::mutex> guard(g_event_loops_lock);
+
+	if (g_event_loop != NULL) {
+		return AEROSPIKE_OK;
+	}
+
+	if (!g_event_loops_initialized) {
+		if (!as_event_set_external_loop_capacity(MAX_EVENT_LOOPS)) {
+			return as_error_set_message(err, AEROSPIKE_ERR_CLIENT,
+										"Unable to set event loop capacity");
+		}
+		g_event_loops_initialized = true;
+	}
+
+	// The main thread's libuv loop lives as long as the process, so it is
+	// registered with the C client directly.
+	uv_loop_t *loop = Nan::GetCurrentEventLoop();
+	as_status status;
+	if (loop == uv_default_loop()) {
+		status = as_set_external_event_loop(err, policy, loop, &g_event_loop);
+		if (status == AEROSPIKE_OK) {
+			uv_update_time(loop);
+		}
+	}
+	else {
+#if defined(_WIN32)
+		status = as_error_set_message(
+			err, AEROSPIKE_ERR_CLIENT,
+			"Worker threads are not supported on Windows");
+#else
+		status = slot_acquire(err, policy);
+#endif
+	}
+
+	if (status == AEROSPIKE_OK) {
+		g_event_loops_owned++;
+	}
+	return status;
+}
+
+void async_event_loop_close()
+{
+	if (g_event_loop == NULL) {
+		return;
+	}
+
+#if !defined(_WIN32)
+	if (g_loop_slot != NULL) {
+		// Parked by the next run of the slot without pending commands; this
+		// may be called from a listener, i.e. while the slot's loop runs.
+		g_event_loop = NULL;
+		g_loop_slot->releasing = true;
+		uv_timer_start(g_loop_slot->timer, slot_timer_cb, 0, 0);
+		return;
+	}
+#endif
+
+	// The main thread's loop is closed with the last one, but no longer keeps
+	// the process alive.
+	std::lock_guard<std::mutex> guard(g_event_loops_lock);
+	uv_unref((uv_handle_t *)g_event_loop->wakeup);
+	g_event_loop = NULL;
+	g_event_loops_owned--;
+	event_loops_close();
+}
+
+void async_event_loop_ref(bool ref)
+{
+	if (g_event_loop == NULL) {
+		return;
+	}
+
+	uv_handle_t *handle = (uv_handle_t *)g_event_loop->wakeup;
+#if !defined(_WIN32)
+	if (g_loop_slot != NULL) {
+		handle = (uv_handle_t *)g_loop_slot->poll;
+	}
+#endif
+	if (ref) {
+		uv_ref(handle);
+	}
+	else {
+		uv_unref(handle);
+	}
+}
+
 /**
  *  Setup an asynchronous invocation of a function using uv worker threads.
  */
@@ -52,7 +377,7 @@ async_invoke(const Nan::FunctionCallbackInfo<v8::Value> &args,
 
 	// Pass the work request to libuv to be run when a
 	// worker-thread is available to process it.
-	uv_queue_work(uv_default_loop(), // event loop
+	uv_queue_work(Nan::GetCurrentEventLoop(), // event loop
 				  req,				 // work token
 				  execute,			 // execute work
 				  respond			 // respond to callback
@@ -63,11 +388,128 @@ async_invoke(const Nan::FunctionCallbackInfo<v8::Value> &args,
 	return Nan::Undefined();
 }
 
+typedef struct info_request_s {
+	InfoCommand *cmd;
+	uint32_t index;
+} info_request;
+
+static void async_info_complete(InfoCommand *cmd)
+{
+	if (--cmd->pending > 0) {
+		return;
+	}
+
+	Nan::HandleScope scope;
+	cmd->Received();
+	cmd->respond(cmd);
+	delete cmd;
+}
+
+// implements the as_async_info_listener interface
+static void async_info_listener(as_error *err, char *response, void *udata,
+								as_event_loop *event_loop)
+{
+	info_request *req = reinterpret_cast<info_request *>(udata);
+	InfoCommand *cmd = req->cmd;
+
+	if (err) {
+		as_v8_debug(cmd->log, "Info request to node %s failed: %s",
+					cmd->nodes[req->index].c_str(), err->message);
+		cmd->statuses[req->index] = err->code;
+		if (!cmd->IsError()) {
+			as_error_copy(&cmd->err, err);
+		}
+	}
+	else if (response) {
+		// The response buffer is owned by the C client.
+		cmd->responses[req->index] = response;
+	}
+
+	delete req;
+	async_info_complete(cmd);
+}
+
+void async_info_send(InfoCommand *cmd, as_node **nodes, uint32_t n_nodes)
+{
+	// The extra count keeps the command alive until all requests have been
+	// submitted, even if a listener is called back right away.
+	cmd->pending = n_nodes + 1;
+	cmd->nodes.resize(n_nodes);
+	cmd->responses.resize(n_nodes);
+	cmd->statuses.resize(n_nodes, AEROSPIKE_OK);
+
+	for (uint32_t i = 0; i < n_nodes; i++) {
+		cmd->nodes[i] = nodes[i]->name;
+		info_request *req = new info_request{cmd, i};
+		as_error err;
+		as_error_init(&err);
+
+		as_v8_debug(cmd->log, "Sending info command \"%s\" to cluster node %s",
+					cmd->request.c_str(), nodes[i]->name);
+		as_status status = as_info_command_node_async(
+			cmd->as, &err, cmd->p_policy, nodes[i], cmd->request.c_str(),
+			async_info_listener, req, cmd->EventLoop());
+		if (status != AEROSPIKE_OK) {
+			cmd->statuses[i] = status;
+			if (!cmd->IsError()) {
+				as_error_copy(&cmd->err, &err);
+			}
+			delete req;
+			cmd->pending--;
+		}
+	}
+
+	async_info_complete(cmd);
+}
+
+void async_info_send_any(InfoCommand *cmd)
+{
+	as_node *node = NULL;
+	if (cmd->as->cluster) {
+		node = as_node_get_random(cmd->as->cluster);
+	}
+
+	if (!node) {
+		CmdErrorCallback(cmd, AEROSPIKE_ERR_INVALID_NODE,
+						 "No cluster node available");
+		delete cmd;
+		return;
+	}
+
+	async_info_send(cmd, &node, 1);
+	as_node_release(node);
+}
+
+as_status async_info_check(as_error *err, const char *response)
+{
+	// Responses echo the request, separated from the result by a tab. Errors
+	// are reported as "ERROR:<code>:<message>", "FAIL:<code>:<message>" or,
+	// by UDF commands, as "error=<reason>;...".
+	const char *result = strchr(response, '\t');
+	result = result ? result + 1 : response;
+
+	if (strncmp(result, "ERROR", 5) != 0 && strncmp(result, "FAIL", 4) != 0 &&
+		strstr(result, "error=") == NULL) {
+		return AEROSPIKE_OK;
+	}
+
+	int code = 0;
+	const char *p = strchr(result, ':');
+	if (p) {
+		code = atoi(p + 1);
+	}
+	size_t len = strcspn(result, "\n");
+	return as_error_update(err,
+						   code > 0 ? (as_status)code : AEROSPIKE_ERR_SERVER,
+						   "%.*s", (int)len, result);
+}
+
 void async_record_listener(as_error *err, as_record *record, void *udata,
 						   as_event_loop *event_loop)
 {
 	Nan::HandleScope scope;
 	AsyncCommand *cmd = reinterpret_cast<AsyncCommand *>(udata);
+	cmd->Received();
 
 	if (err) {
 		cmd->ErrorCallback(err);
@@ -82,10 +524,32 @@ void async_record_listener(as_error *err, as_record *record, void *udata,
 	delete cmd;
 }
 
+void async_read_record_listener(as_error *err, as_record *record, void *udata,
+								as_event_loop *event_loop)
+{
+	Nan::HandleScope scope;
+	RecordCommand *cmd = reinterpret_cast<RecordCommand *>(udata);
+	cmd->Received();
+
+	if (err) {
+		cmd->ErrorCallback(err);
+	}
+	else {
+		cmd->CacheStore(record);
+		Local<Value> argv[] = {
+			Nan::Null(),
+			record_to_jsrecord(record, Nan::New(cmd->key), cmd->log)};
+		cmd->Callback(2, argv);
+	}
+
+	delete cmd;
+}
+
 void async_write_listener(as_error *err, void *udata, as_event_loop *event_loop)
 {
 	Nan::HandleScope scope;
 	AsyncCommand *cmd = reinterpret_cast<AsyncCommand *>(udata);
+	cmd->Received();
 
 	if (err) {
 		cmd->ErrorCallback(err);
@@ -102,6 +566,7 @@ void async_value_listener(as_error *err, as_val *value, void *udata,
 {
 	Nan::HandleScope scope;
 	AsyncCommand *cmd = reinterpret_cast<AsyncCommand *>(udata);
+	cmd->Received();
 
 	if (err) {
 		cmd->ErrorCallback(err);
@@ -119,8 +584,9 @@ void async_batch_listener(as_error *err, as_batch_read_records *records,
 {
 	Nan::HandleScope scope;
 	AsyncCommand *cmd = reinterpret_cast<AsyncCommand *>(udata);
+	cmd->Received(records);
 	if (!err || (err->code == AEROSPIKE_BATCH_FAILED && records->list.size != 0)) {
-
+		cmd->CacheStore(records);
 		Local<Value> argv[]{Nan::Null(),
 							batch_records_to_jsarray(records, cmd->log)};
 		cmd->Callback(2, argv);
@@ -133,25 +599,69 @@ void async_batch_listener(as_error *err, as_batch_read_records *records,
 	delete cmd;
 }
 
+void async_batch_keys_listener(as_error *err, as_batch_records *records,
+							   void *udata, as_event_loop *event_loop)
+{
+	Nan::HandleScope scope;
+	AsyncCommand *cmd = reinterpret_cast<AsyncCommand *>(udata);
+	cmd->Received(records);
+	if (!err || (err->code == AEROSPIKE_BATCH_FAILED && records->list.size != 0)) {
+		cmd->CacheStore(records);
+		Local<Value> argv[]{Nan::Null(),
+							batch_records_to_jsarray(records, cmd->log)};
+		cmd->Callback(2, argv);
+	}
+	else {
+		cmd->ErrorCallback(err);
+	}
+
+	// Bin names, UDF arguments and policies shared by the records are owned
+	// by the command and released by its destructor.
+	batch_records_destroy(records);
+	delete cmd;
+}
+
+void async_batch_digests_listener(as_error *err, as_batch_records *records,
+								  void *udata, as_event_loop *event_loop)
+{
+	Nan::HandleScope scope;
+	AsyncCommand *cmd = reinterpret_cast<AsyncCommand *>(udata);
+	cmd->Received();
+	if (!err || (err->code == AEROSPIKE_BATCH_FAILED && records->list.size != 0)) {
+		cmd->CacheStore(records);
+		// Results are positional; the caller already has the digests.
+		Local<Value> argv[]{Nan::Null(),
+							batch_records_to_jsarray(records, cmd->log, false)};
+		cmd->Callback(2, argv);
+	}
+	else {
+		cmd->ErrorCallback(err);
+	}
+
+	batch_records_destroy(records);
+	delete cmd;
+}
+
+void async_pipe_listener(void *udata, as_event_loop *event_loop) {}
+
 bool async_scan_listener(as_error *err, as_record *record, void *udata,
 						 as_event_loop *event_loop)
 {
 	Nan::HandleScope scope;
-	AsyncCommand *cmd = reinterpret_cast<AsyncCommand *>(udata);
+	StreamCommand *cmd = reinterpret_cast<StreamCommand *>(udata);
+	cmd->Received();
 	const LogInfo *log = cmd->log;
 
 	Local<Value> result;
 	if (err) {
+		cmd->FlushRecords();
 		result = cmd->ErrorCallback(err);
 	}
 	else if (record) {
-		Local<Value> argv[] = {Nan::Null(),
-							   recordbins_to_jsobject(record, cmd->log),
-							   recordmeta_to_jsobject(record, cmd->log),
-							   key_to_jsobject(&record->key, cmd->log)};
-		result = cmd->Callback(4, argv);
+		result = cmd->RecordCallback(record);
 	}
 	else {
+		cmd->FlushRecords();
 		cmd->Callback(0, {});
 		delete cmd;
 		return false;
@@ -171,12 +681,14 @@ bool async_scan_pages_listener(as_error *err, as_record *record, void *udata,
 {
 	Nan::HandleScope scope;
 	struct scan_udata* su = (scan_udata*) udata;
-	AsyncCommand *cmd = reinterpret_cast<AsyncCommand *>(su->cmd);
+	StreamCommand *cmd = su->cmd;
+	cmd->Received();
 	
 	const LogInfo *log = cmd->log;
 
 	Local<Value> result;
 	if (err) {
+		cmd->FlushRecords();
 		result = cmd->ErrorCallback(err);
 	}
 	else if (su->count >= su->max_records) {
@@ -184,6 +696,7 @@ bool async_scan_pages_listener(as_error *err, as_record *record, void *udata,
 		uint32_t bytes_size;
 		uint8_t* bytes = NULL;
 
+		cmd->FlushRecords();
 		as_scan_to_bytes(scan, &bytes, &bytes_size);
 		Local<Value> argv[] = {Nan::Null(),
 							   Nan::Null(),
@@ -198,14 +711,11 @@ bool async_scan_pages_listener(as_error *err, as_record *record, void *udata,
 		return false;
 	}
 	else if (record) {
-		Local<Value> argv[] = {Nan::Null(),
-							   recordbins_to_jsobject(record, log),
-							   recordmeta_to_jsobject(record, log),
-							   key_to_jsobject(&record->key, log)};
-		result = cmd->Callback(4, argv);
+		result = cmd->RecordCallback(record);
 	}
 	else {
 		as_scan* scan = reinterpret_cast<as_scan *>(su->scan);
+		cmd->FlushRecords();
 		cmd->Callback(0, {});
 		as_scan_destroy(scan);
 		delete cmd;
@@ -229,13 +739,15 @@ bool async_query_pages_listener(as_error *err, as_record *record, void *udata,
 {
 	Nan::HandleScope scope;
 	struct query_udata* qu = (query_udata*) udata;
-	AsyncCommand *cmd = reinterpret_cast<AsyncCommand *>(qu->cmd);
+	StreamCommand *cmd = qu->cmd;
+	cmd->Received();
 	
     
 	const LogInfo *log = cmd->log;
 
 	Local<Value> result;
 	if (err) {
+		cmd->FlushRecords();
 		result = cmd->ErrorCallback(err);
 	}
 	else if (qu->count >= qu->max_records) {
@@ -243,6 +755,7 @@ bool async_query_pages_listener(as_error *err, as_record *record, void *udata,
 		as_exp* exp = reinterpret_cast<as_exp *>(qu->exp);
 		uint32_t bytes_size;
 		uint8_t* bytes = NULL;
+		cmd->FlushRecords();
 		as_query_to_bytes(query, &bytes, &bytes_size);
 		Local<Value> argv[] = {Nan::Null(),
 							   Nan::Null(),
@@ -257,15 +770,12 @@ bool async_query_pages_listener(as_error *err, as_record *record, void *udata,
 		return false;
 	}
 	else if (record) {
-		Local<Value> argv[] = {Nan::Null(),
-							   recordbins_to_jsobject(record, log),
-							   recordmeta_to_jsobject(record, log),
-							   key_to_jsobject(&record->key, log)};
-		result = cmd->Callback(4, argv);
+		result = cmd->RecordCallback(record);
 	}
 	else {
 		as_query* query = reinterpret_cast<as_query *>(qu->query);
 		as_exp* exp = reinterpret_cast<as_exp *>(qu->exp);
+		cmd->FlushRecords();
 		cmd->Callback(0, {});
 		free_query(query, NULL, exp);
 		delete cmd;
@@ -298,6 +808,7 @@ void async_mrt_listener(as_error* err, uint32_t status, void* udata)
 {
 	Nan::HandleScope scope;
 	AsyncCommand *cmd = reinterpret_cast<AsyncCommand *>(udata);
+	cmd->Received();
 
 	if (err) {
 		cmd->ErrorCallback(err);
@@ -14,8 +14,15 @@
  * limitations under the License.
  ******************************************************************************/
 
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 #include <node.h>
 #include "client.h"
+#include "arena.h"
+#include "async.h"
 #include "command.h"
 #include "conversions.h"
 #include "config.h"
@@ -35,6 +42,73 @@ extern "C" {
 
 using namespace v8;
 
+/*******************************************************************************
+ *  Shared clusters
+ *
+ *  Clients that are created with the same sharedCluster key, e.g. in several
+ *  worker threads, use a single C client instance, i.e. a single cluster
+ *  tender and set of connection pools. Commands are still processed on the
+ *  event loop of the isolate that issued them. The instance is closed when
+ *  the last client using it is closed.
+ *
+ *  All clients sharing a cluster must use the same configuration, apart from
+ *  the settings that only apply to the client itself.
+ ******************************************************************************/
+
+struct shared_cluster {
+	aerospike *as;
+	uint32_t clients;
+	bool connected;
+	// The configuration the cluster was created with; see config_fingerprint.
+	std::string config;
+	// Held while the first of the cluster's clients connects; shared, so that
+	// it outlives the registry entry.
+	std::shared_ptr<std::mutex> connect_lock;
+};
+
+// Configuration keys that only apply to the client itself.
+static const char *const CLIENT_CONFIG_KEYS[] = {"log", "readBatching",
+												 "readCache", "sharedCluster"};
+
+static std::mutex g_shared_clusters_lock;
+static std::unordered_map<std::string, shared_cluster> g_shared_clusters;
+
+/**
+ *  Serializes the settings of the configuration that apply to the cluster.
+ *  Returns false if the configuration cannot be serialized.
+ */
+static bool config_fingerprint(Local<Object> config, std::string *out)
+{
+	Nan::HandleScope scope;
+	Local<Object> cluster_config = Nan::New<Object>();
+	Local<Array> names = Nan::GetOwnPropertyNames(config).ToLocalChecked();
+
+	for (uint32_t i = 0; i < names->Length(); i++) {
+		Local<Value> name = Nan::Get(names, i).ToLocalChecked();
+		Nan::Utf8String key(name);
+		bool client_only = false;
+		for (const char *client_key : CLIENT_CONFIG_KEYS) {
+			if (strcmp(*key, client_key) == 0) {
+				client_only = true;
+				break;
+			}
+		}
+		if (!client_only) {
+			Nan::Set(cluster_config, name,
+					 Nan::Get(config, name).ToLocalChecked());
+		}
+	}
+
+	Nan::TryCatch try_catch;
+	Nan::JSON json;
+	Nan::MaybeLocal<String> str = json.Stringify(cluster_config);
+	if (try_catch.HasCaught() || str.IsEmpty()) {
+		return false;
+	}
+	*out = *Nan::Utf8String(str.ToLocalChecked());
+	return true;
+}
+
 /*******************************************************************************
  *  Constructor and Destructor
  ******************************************************************************/
@@ -52,23 +126,15 @@ AerospikeClient::~AerospikeClient() {}
  */
 NAN_METHOD(AerospikeClient::New)
 {
-	
-
-
 	AerospikeClient *client = new AerospikeClient();
-	client->as = (aerospike *)cf_malloc(sizeof(aerospike));
 	client->log = (LogInfo *)cf_malloc(sizeof(LogInfo));
+	client->latency = std::make_shared<LatencyStats>();
+	client->pipeline = std::make_shared<PipelineState>();
 
 	// initialize the log to default values.
 	client->log->fd = g_log_info.fd;
 	client->log->level = g_log_info.level;
 
-
-	// initialize the config to default values.
-	as_config config;
-	as_config_init(&config);
-
-
 	Local<Object> v8Config = info[0].As<Object>();
 
 	Local<Value> v8LogInfo =
@@ -77,6 +143,59 @@ NAN_METHOD(AerospikeClient::New)
 		log_from_jsobject(client->log, v8LogInfo.As<Object>());
 	}
 
+	if (pipeline_from_jsobject(client->pipeline.get(), v8Config,
+							   client->log) != AS_NODE_PARAM_OK ||
+		record_cache_from_jsobject(&client->cache, v8Config, client->log) !=
+			AS_NODE_PARAM_OK) {
+		cf_free(client->log);
+		delete client;
+		Nan::ThrowError("Invalid client configuration");
+		return;
+	}
+
+	Local<Value> v8Shared =
+		Nan::Get(v8Config, Nan::New("sharedCluster").ToLocalChecked())
+			.ToLocalChecked();
+	std::unique_lock<std::mutex> shared_guard(g_shared_clusters_lock,
+											  std::defer_lock);
+	std::string fingerprint;
+	if (v8Shared->IsString()) {
+		client->shared_cluster = *Nan::Utf8String(v8Shared);
+		if (!config_fingerprint(v8Config, &fingerprint)) {
+			cf_free(client->log);
+			delete client;
+			Nan::ThrowError("Invalid client configuration");
+			return;
+		}
+		shared_guard.lock();
+		auto it = g_shared_clusters.find(client->shared_cluster);
+		if (it != g_shared_clusters.end()) {
+			// The configuration is not converted again: it is either the one
+			// the cluster was created with, or it is rejected.
+			if (it->second.config != fingerprint) {
+				shared_guard.unlock();
+				cf_free(client->log);
+				delete client;
+				Nan::ThrowError("Shared cluster was created with a different "
+								"configuration");
+				return;
+			}
+			it->second.clients++;
+			client->as = it->second.as;
+			as_v8_debug(client->log, "Using shared cluster \"%s\" (%u clients)",
+						client->shared_cluster.c_str(), it->second.clients);
+			client->Wrap(info.This());
+			info.GetReturnValue().Set(info.This());
+			return;
+		}
+	}
+
+	client->as = (aerospike *)cf_malloc(sizeof(aerospike));
+
+	// initialize the config to default values.
+	as_config config;
+	as_config_init(&config);
+
 	int result = config_from_jsobject(&config, v8Config, client->log);
 	if (result != AS_NODE_PARAM_OK) {
 		cf_free(client->as);
@@ -87,33 +206,114 @@ NAN_METHOD(AerospikeClient::New)
 	}
 
 	aerospike_init(client->as, &config);
+	if (!client->shared_cluster.empty()) {
+		g_shared_clusters[client->shared_cluster] = {
+			client->as, 1, false, fingerprint, std::make_shared<std::mutex>()};
+	}
 	as_v8_debug(client->log, "Aerospike client initialized successfully");
 	client->Wrap(info.This());
 	info.GetReturnValue().Set(info.This());
 }
 
-/**
- * Connect to an Aerospike Cluster
- */
-NAN_METHOD(AerospikeClient::Connect)
+class ConnectCommand : public AerospikeCommand {
+  public:
+	ConnectCommand(AerospikeClient *client, Local<Function> callback_)
+		: AerospikeCommand("Connect", client, callback_),
+		  shared_cluster(client->shared_cluster)
+	{
+	}
+
+	std::string shared_cluster;
+};
+
+static void *connect_prepare(const Nan::FunctionCallbackInfo<Value> &info)
 {
 	Nan::HandleScope scope;
 	AerospikeClient *client =
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
-	Local<Function> callback = info[0].As<Function>();
-	AerospikeCommand *cmd = new AerospikeCommand("Connect", client, callback);
+	return new ConnectCommand(client, info[0].As<Function>());
+}
 
-	as_error err;
-	if (aerospike_connect(client->as, &err) != AEROSPIKE_OK) {
-		cmd->ErrorCallback(&err);
+/**
+ *  Runs on a libuv worker thread, since seeding the cluster may involve DNS
+ *  resolution, TLS handshakes, authentication and fetching the partition
+ *  maps from every node.
+ */
+static void connect_execute(uv_work_t *req)
+{
+	ConnectCommand *cmd = reinterpret_cast<ConnectCommand *>(req->data);
+
+	if (cmd->shared_cluster.empty()) {
+		as_v8_debug(cmd->log, "Connecting to cluster");
+		aerospike_connect(cmd->as, &cmd->err);
+		return;
+	}
+
+	// Clients sharing a cluster may connect concurrently from several
+	// threads; only the first of them seeds the cluster. The registry lock is
+	// not held while connecting, so that new clients can be created and other
+	// shared clusters connected meanwhile.
+	std::shared_ptr<std::mutex> connect_lock;
+	{
+		std::lock_guard<std::mutex> guard(g_shared_clusters_lock);
+		auto it = g_shared_clusters.find(cmd->shared_cluster);
+		if (it == g_shared_clusters.end()) {
+			CmdSetError(cmd, AEROSPIKE_ERR_CLIENT,
+						"Shared cluster \"%s\" has been closed",
+						cmd->shared_cluster.c_str());
+			return;
+		}
+		connect_lock = it->second.connect_lock;
+	}
+
+	std::lock_guard<std::mutex> connect_guard(*connect_lock);
+	{
+		std::lock_guard<std::mutex> guard(g_shared_clusters_lock);
+		auto it = g_shared_clusters.find(cmd->shared_cluster);
+		if (it != g_shared_clusters.end() && it->second.connected) {
+			as_v8_debug(cmd->log, "Shared cluster \"%s\" is already connected",
+						cmd->shared_cluster.c_str());
+			return;
+		}
+	}
+
+	as_v8_debug(cmd->log, "Connecting to shared cluster \"%s\"",
+				cmd->shared_cluster.c_str());
+	if (aerospike_connect(cmd->as, &cmd->err) == AEROSPIKE_OK) {
+		std::lock_guard<std::mutex> guard(g_shared_clusters_lock);
+		auto it = g_shared_clusters.find(cmd->shared_cluster);
+		if (it != g_shared_clusters.end()) {
+			it->second.connected = true;
+		}
+	}
+}
+
+static void connect_respond(uv_work_t *req, int status)
+{
+	Nan::HandleScope scope;
+	ConnectCommand *cmd = reinterpret_cast<ConnectCommand *>(req->data);
+
+	if (cmd->IsError()) {
+		cmd->ErrorCallback();
 	}
 	else {
-		as_v8_debug(client->log,
+		as_v8_debug(cmd->log,
 					"Successfully connected to cluster: Enjoy your cake!");
 		cmd->Callback(0, {});
 	}
 
 	delete cmd;
+	delete req;
+}
+
+/**
+ * Connect to an Aerospike Cluster
+ */
+NAN_METHOD(AerospikeClient::Connect)
+{
+	TYPE_CHECK_REQ(info[0], IsFunction, "Callback must be a function");
+
+	async_invoke(info, connect_prepare, connect_execute, connect_respond);
 }
 
 /**
@@ -125,10 +325,32 @@ NAN_METHOD(AerospikeClient::Close)
 	AerospikeClient *client =
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
 
+	if (client->closed) {
+		return;
+	}
+
 	as_v8_debug(client->log, "Closing the connection to aerospike cluster");
+
+	if (!client->shared_cluster.empty()) {
+		std::lock_guard<std::mutex> guard(g_shared_clusters_lock);
+		auto it = g_shared_clusters.find(client->shared_cluster);
+		if (it != g_shared_clusters.end() && --it->second.clients > 0) {
+			as_v8_debug(client->log, "Shared cluster \"%s\" remains open",
+						client->shared_cluster.c_str());
+			cf_free(client->log);
+			client->closed = true;
+			return;
+		}
+		if (it != g_shared_clusters.end()) {
+			g_shared_clusters.erase(it);
+		}
+	}
+
 	as_error err;
-	events_callback_close(&client->as->config);
-	
+	if (client->as->config.event_callback_udata != NULL) {
+		events_callback_close(&client->as->config);
+	}
+
 	aerospike_close(client->as, &err);
 	aerospike_destroy(client->as);
 
@@ -249,6 +471,14 @@ NAN_METHOD(AerospikeClient::SetupEventCb)
 	AerospikeClient *client =
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
 
+	if (!client->shared_cluster.empty()) {
+		// Cluster events are delivered on the loop of the isolate that
+		// registered for them, which may not outlive a shared cluster.
+		as_v8_debug(client->log,
+					"Cluster events are not supported for shared clusters");
+		return;
+	}
+
 	Local<Function> callback;
 	if (info.Length() > 0 && info[0]->IsFunction()) {
 		callback = info[0].As<Function>();
@@ -285,79 +515,100 @@ Local<Value> AerospikeClient::NewInstance(Local<Object> config)
 void AerospikeClient::Init()
 {
 	Local<FunctionTemplate> tpl =
-		Nan::New<FunctionTemplate>(AerospikeClient::New);
+		Nan::New<FunctionTemplate>(native_entry<AerospikeClient::New>);
 	tpl->SetClassName(Nan::New("AerospikeClient").ToLocalChecked());
 
 	// A client object created in Node.js, holds reference to the wrapped C++
 	// object using an internal field.
 	tpl->InstanceTemplate()->SetInternalFieldCount(1);
 
-	Nan::SetPrototypeMethod(tpl, "addSeedHost", AddSeedHost);
-	Nan::SetPrototypeMethod(tpl, "applyAsync", ApplyAsync);
-	Nan::SetPrototypeMethod(tpl, "batchExists", BatchExists);
-	Nan::SetPrototypeMethod(tpl, "batchGet", BatchGet);
-	Nan::SetPrototypeMethod(tpl, "batchRead", BatchReadAsync);
-	Nan::SetPrototypeMethod(tpl, "batchWrite", BatchWriteAsync);
-	Nan::SetPrototypeMethod(tpl, "batchApply", BatchApply);
-	Nan::SetPrototypeMethod(tpl, "batchRemove", BatchRemove);
-	Nan::SetPrototypeMethod(tpl, "batchSelect", BatchSelect);
-	Nan::SetPrototypeMethod(tpl, "contextFromBase64", ContextFromBase64);
-	Nan::SetPrototypeMethod(tpl, "contextToBase64", ContextToBase64);
-	Nan::SetPrototypeMethod(tpl, "changePassword", ChangePassword);
-	Nan::SetPrototypeMethod(tpl, "close", Close);
-	Nan::SetPrototypeMethod(tpl, "connect", Connect);
-	Nan::SetPrototypeMethod(tpl, "existsAsync", ExistsAsync);
-	Nan::SetPrototypeMethod(tpl, "disableMetrics", DisableMetrics);
-	Nan::SetPrototypeMethod(tpl, "enableMetrics", EnableMetrics);
-	Nan::SetPrototypeMethod(tpl, "getAsync", GetAsync);
-	Nan::SetPrototypeMethod(tpl, "getNodes", GetNodes);
-	Nan::SetPrototypeMethod(tpl, "getStats", GetStats);
-	Nan::SetPrototypeMethod(tpl, "hasPendingAsyncCommands", HasPendingAsyncCommands);
-	Nan::SetPrototypeMethod(tpl, "indexCreate", IndexCreate);
-	Nan::SetPrototypeMethod(tpl, "indexRemove", IndexRemove);
-	Nan::SetPrototypeMethod(tpl, "infoAny", InfoAny);
-	Nan::SetPrototypeMethod(tpl, "infoForeach", InfoForeach);
-	Nan::SetPrototypeMethod(tpl, "infoHost", InfoHost);
-	Nan::SetPrototypeMethod(tpl, "infoNode", InfoNode);
-	Nan::SetPrototypeMethod(tpl, "isConnected", IsConnected);
-	Nan::SetPrototypeMethod(tpl, "jobInfo", JobInfo);
-	Nan::SetPrototypeMethod(tpl, "operateAsync", OperateAsync);
-	Nan::SetPrototypeMethod(tpl, "privilegeGrant", PrivilegeGrant);
-	Nan::SetPrototypeMethod(tpl, "privilegeRevoke", PrivilegeRevoke);
-	Nan::SetPrototypeMethod(tpl, "putAsync", PutAsync);
-	Nan::SetPrototypeMethod(tpl, "queryApply", QueryApply);
-	Nan::SetPrototypeMethod(tpl, "queryAsync", QueryAsync);
-	Nan::SetPrototypeMethod(tpl, "queryBackground", QueryBackground);
-	Nan::SetPrototypeMethod(tpl, "queryForeach", QueryForeach);
-	Nan::SetPrototypeMethod(tpl, "queryPages", QueryPages);
-	Nan::SetPrototypeMethod(tpl, "queryRole", QueryRole);
-	Nan::SetPrototypeMethod(tpl, "queryRoles", QueryRoles);
-	Nan::SetPrototypeMethod(tpl, "queryUser", QueryUser);
-	Nan::SetPrototypeMethod(tpl, "queryUsers", QueryUsers);
-	Nan::SetPrototypeMethod(tpl, "removeAsync", RemoveAsync);
-	Nan::SetPrototypeMethod(tpl, "removeSeedHost", RemoveSeedHost);
-	Nan::SetPrototypeMethod(tpl, "roleCreate", RoleCreate);
-	Nan::SetPrototypeMethod(tpl, "roleDrop", RoleDrop);
-	Nan::SetPrototypeMethod(tpl, "roleGrant", RoleGrant);
-	Nan::SetPrototypeMethod(tpl, "roleRevoke", RoleRevoke);
-	Nan::SetPrototypeMethod(tpl, "roleSetWhitelist", RoleSetWhitelist);
-	Nan::SetPrototypeMethod(tpl, "roleSetQuotas", RoleSetQuotas);
-	Nan::SetPrototypeMethod(tpl, "scanAsync", ScanAsync);
-	Nan::SetPrototypeMethod(tpl, "scanPages", ScanPages);
-	Nan::SetPrototypeMethod(tpl, "scanBackground", ScanBackground);
-	Nan::SetPrototypeMethod(tpl, "selectAsync", SelectAsync);
-	Nan::SetPrototypeMethod(tpl, "setPassword", SetPassword);
-	Nan::SetPrototypeMethod(tpl, "setupEventCb", SetupEventCb);
-	Nan::SetPrototypeMethod(tpl, "setXDRFilter", SetXDRFilter);
-	Nan::SetPrototypeMethod(tpl, "transactionAbort", TransactionAbort);
-	Nan::SetPrototypeMethod(tpl, "transactionCommit", TransactionCommit);
-	Nan::SetPrototypeMethod(tpl, "truncate", Truncate);
-	Nan::SetPrototypeMethod(tpl, "udfRegister", Register);
-	Nan::SetPrototypeMethod(tpl, "udfRemove", UDFRemove);
-	Nan::SetPrototypeMethod(tpl, "updateLogging", SetLogLevel);
-	Nan::SetPrototypeMethod(tpl, "userCreate", UserCreate);
-	Nan::SetPrototypeMethod(tpl, "userCreatePKI", UserCreatePKI);
-	Nan::SetPrototypeMethod(tpl, "userDrop", UserDrop);
+	Nan::SetPrototypeMethod(tpl, "addSeedHost", native_entry<AddSeedHost>);
+	Nan::SetPrototypeMethod(tpl, "applyAsync", native_entry<ApplyAsync>);
+	Nan::SetPrototypeMethod(tpl, "batchExists", native_entry<BatchExists>);
+	Nan::SetPrototypeMethod(tpl, "batchGet", native_entry<BatchGet>);
+	Nan::SetPrototypeMethod(tpl, "batchRead", native_entry<BatchReadAsync>);
+	Nan::SetPrototypeMethod(tpl, "batchReadUniform",
+							native_entry<BatchReadUniform>);
+	Nan::SetPrototypeMethod(tpl, "batchWrite", native_entry<BatchWriteAsync>);
+	Nan::SetPrototypeMethod(tpl, "batchApply", native_entry<BatchApply>);
+	Nan::SetPrototypeMethod(tpl, "batchRemove", native_entry<BatchRemove>);
+	Nan::SetPrototypeMethod(tpl, "batchSelect", native_entry<BatchSelect>);
+	Nan::SetPrototypeMethod(tpl, "contextFromBase64",
+							native_entry<ContextFromBase64>);
+	Nan::SetPrototypeMethod(tpl, "contextToBase64",
+							native_entry<ContextToBase64>);
+	Nan::SetPrototypeMethod(tpl, "changePassword",
+							native_entry<ChangePassword>);
+	Nan::SetPrototypeMethod(tpl, "close", native_entry<Close>);
+	Nan::SetPrototypeMethod(tpl, "connect", native_entry<Connect>);
+	Nan::SetPrototypeMethod(tpl, "existsAsync", native_entry<ExistsAsync>);
+	Nan::SetPrototypeMethod(tpl, "disableMetrics",
+							native_entry<DisableMetrics>);
+	Nan::SetPrototypeMethod(tpl, "enableMetrics", native_entry<EnableMetrics>);
+	Nan::SetPrototypeMethod(tpl, "getAsync", native_entry<GetAsync>);
+	Nan::SetPrototypeMethod(tpl, "getNodes", native_entry<GetNodes>);
+	Nan::SetPrototypeMethod(tpl, "getStats", native_entry<GetStats>);
+	Nan::SetPrototypeMethod(tpl, "resetStats", native_entry<ResetStats>);
+	Nan::SetPrototypeMethod(tpl, "hasPendingAsyncCommands",
+							native_entry<HasPendingAsyncCommands>);
+	Nan::SetPrototypeMethod(tpl, "indexCreate", native_entry<IndexCreate>);
+	Nan::SetPrototypeMethod(tpl, "indexRemove", native_entry<IndexRemove>);
+	Nan::SetPrototypeMethod(tpl, "infoAny", native_entry<InfoAny>);
+	Nan::SetPrototypeMethod(tpl, "infoForeach", native_entry<InfoForeach>);
+	Nan::SetPrototypeMethod(tpl, "infoHost", native_entry<InfoHost>);
+	Nan::SetPrototypeMethod(tpl, "infoNode", native_entry<InfoNode>);
+	Nan::SetPrototypeMethod(tpl, "isConnected", native_entry<IsConnected>);
+	Nan::SetPrototypeMethod(tpl, "jobInfo", native_entry<JobInfo>);
+	Nan::SetPrototypeMethod(tpl, "operateAsync", native_entry<OperateAsync>);
+	Nan::SetPrototypeMethod(tpl, "privilegeGrant",
+							native_entry<PrivilegeGrant>);
+	Nan::SetPrototypeMethod(tpl, "privilegeRevoke",
+							native_entry<PrivilegeRevoke>);
+	Nan::SetPrototypeMethod(tpl, "putAsync", native_entry<PutAsync>);
+	Nan::SetPrototypeMethod(tpl, "queryApply", native_entry<QueryApply>);
+	Nan::SetPrototypeMethod(tpl, "queryAsync", native_entry<QueryAsync>);
+	Nan::SetPrototypeMethod(tpl, "queryBackground",
+							native_entry<QueryBackground>);
+	Nan::SetPrototypeMethod(tpl, "queryForeach", native_entry<QueryForeach>);
+	Nan::SetPrototypeMethod(tpl, "queryPages", native_entry<QueryPages>);
+	Nan::SetPrototypeMethod(tpl, "queryRole", native_entry<QueryRole>);
+	Nan::SetPrototypeMethod(tpl, "queryRoles", native_entry<QueryRoles>);
+	Nan::SetPrototypeMethod(tpl, "queryUser", native_entry<QueryUser>);
+	Nan::SetPrototypeMethod(tpl, "queryUsers", native_entry<QueryUsers>);
+	Nan::SetPrototypeMethod(tpl, "removeAsync", native_entry<RemoveAsync>);
+	Nan::SetPrototypeMethod(tpl, "removeSeedHost",
+							native_entry<RemoveSeedHost>);
+	Nan::SetPrototypeMethod(tpl, "roleCreate", native_entry<RoleCreate>);
+	Nan::SetPrototypeMethod(tpl, "roleDrop", native_entry<RoleDrop>);
+	Nan::SetPrototypeMethod(tpl, "roleGrant", native_entry<RoleGrant>);
+	Nan::SetPrototypeMethod(tpl, "roleRevoke", native_entry<RoleRevoke>);
+	Nan::SetPrototypeMethod(tpl, "roleSetWhitelist",
+							native_entry<RoleSetWhitelist>);
+	Nan::SetPrototypeMethod(tpl, "roleSetQuotas", native_entry<RoleSetQuotas>);
+	Nan::SetPrototypeMethod(tpl, "scanAsync", native_entry<ScanAsync>);
+	Nan::SetPrototypeMethod(tpl, "scanPages", native_entry<ScanPages>);
+	Nan::SetPrototypeMethod(tpl, "scanBackground",
+							native_entry<ScanBackground>);
+	Nan::SetPrototypeMethod(tpl, "selectAsync", native_entry<SelectAsync>);
+	Nan::SetPrototypeMethod(tpl, "setPassword", native_entry<SetPassword>);
+	Nan::SetPrototypeMethod(tpl, "setupEventCb", native_entry<SetupEventCb>);
+	Nan::SetPrototypeMethod(tpl, "setXDRFilter", native_entry<SetXDRFilter>);
+	Nan::SetPrototypeMethod(tpl, "transactionAbort",
+							native_entry<TransactionAbort>);
+	Nan::SetPrototypeMethod(tpl, "transactionCommit",
+							native_entry<TransactionCommit>);
+	Nan::SetPrototypeMethod(tpl, "truncate", native_entry<Truncate>);
+	Nan::SetPrototypeMethod(tpl, "udfRegister", native_entry<Register>);
+	Nan::SetPrototypeMethod(tpl, "udfRemove", native_entry<UDFRemove>);
+	Nan::SetPrototypeMethod(tpl, "updateLogging", native_entry<SetLogLevel>);
+	Nan::SetPrototypeMethod(tpl, "userCreate", native_entry<UserCreate>);
+	Nan::SetPrototypeMethod(tpl, "userCreatePKI", native_entry<UserCreatePKI>);
+	Nan::SetPrototypeMethod(tpl, "userDrop", native_entry<UserDrop>);
 
 	constructor().Reset(Nan::GetFunction(tpl).ToLocalChecked());
+
+	// The constructor is per isolate; release it when the isolate's
+	// environment (e.g. a worker thread) is torn down.
+	node::AddEnvironmentCleanupHook(
+		Isolate::GetCurrent(), [](void *) { constructor().Reset(); }, NULL);
 }
\ No newline at end of file
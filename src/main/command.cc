@@ -14,18 +14,160 @@
  * limitations under the License.
  ******************************************************************************/
 
+#include <cstring>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "async.h"
 #include "command.h"
 #include "conversions.h"
 #include "log.h"
+#include "result_classes.h"
 
 extern "C" {
+#include <aerospike/aerospike_batch.h>
+#include <aerospike/as_cluster.h>
 #include <aerospike/as_error.h>
 }
 
 using namespace v8;
 
+// Commands up to this size are pooled; sizes are rounded up to a multiple of
+// COMMAND_POOL_ALIGN.
+#define COMMAND_POOL_ALIGN 16
+#define COMMAND_POOL_MAX_SIZE 1024
+
+// Maximum number of free commands kept per size class and thread.
+#define COMMAND_POOL_MAX_FREE 1024
+
+typedef struct CommandPool {
+	std::vector<void *> free[COMMAND_POOL_MAX_SIZE / COMMAND_POOL_ALIGN];
+
+	~CommandPool()
+	{
+		for (auto &list : free) {
+			for (void *ptr : list) {
+				::operator delete(ptr);
+			}
+		}
+	}
+} CommandPool;
+
+// Commands are created and deleted on their isolate's thread.
+static thread_local CommandPool g_command_pool;
+
+typedef std::unordered_map<const char *, CommandType *> CommandTypes;
+
+static thread_local CommandTypes *g_command_types = NULL;
+static thread_local bool g_async_resources_enabled = true;
+
+static void command_types_cleanup(void *arg)
+{
+	CommandTypes *types = reinterpret_cast<CommandTypes *>(arg);
+	for (auto &entry : *types) {
+		entry.second->resource_name.Reset();
+		delete entry.second;
+	}
+	if (g_command_types == types) {
+		g_command_types = NULL;
+	}
+	delete types;
+}
+
+const CommandType *command_type(const char *name)
+{
+	if (g_command_types == NULL) {
+		g_command_types = new CommandTypes();
+		node::AddEnvironmentCleanupHook(
+			Isolate::GetCurrent(), command_types_cleanup, g_command_types);
+	}
+
+	auto it = g_command_types->find(name);
+	if (it != g_command_types->end()) {
+		return it->second;
+	}
+
+	Nan::HandleScope scope;
+	std::string resource_name = std::string("aerospike:") + name + "Command";
+	CommandType *type = new CommandType();
+	type->resource_name.Reset(
+		String::NewFromUtf8(Isolate::GetCurrent(), resource_name.c_str(),
+							NewStringType::kInternalized)
+			.ToLocalChecked());
+	type->latency_type = latency_type_from_name(name);
+	g_command_types->emplace(name, type);
+	return type;
+}
+
+NAN_METHOD(setAsyncResourcesEnabled)
+{
+	TYPE_CHECK_REQ(info[0], IsBoolean, "enabled must be a boolean");
+	g_async_resources_enabled = Nan::To<bool>(info[0]).FromJust();
+}
+
+AerospikeCommand::AerospikeCommand(const char *name, AerospikeClient *client,
+								   Local<Function> callback_)
+	: as(client->as), log(client->log), cmd(name), latency(client->latency),
+	  created_ns(uv_hrtime()), pipeline(client->pipeline),
+	  cache(client->cache)
+{
+	const CommandType *type = command_type(name);
+	latency_type = type->latency_type;
+	if (g_async_resources_enabled) {
+		async_resource.emplace(Nan::New(type->resource_name));
+	}
+	as_error_init(&err);
+	callback.Reset(callback_);
+	ns[0] = '\0';
+}
+
+void *AerospikeCommand::operator new(size_t size)
+{
+	if (size > COMMAND_POOL_MAX_SIZE) {
+		return ::operator new(size);
+	}
+
+	size_t index = (size + COMMAND_POOL_ALIGN - 1) / COMMAND_POOL_ALIGN - 1;
+	std::vector<void *> &list = g_command_pool.free[index];
+	if (list.empty()) {
+		return ::operator new((index + 1) * COMMAND_POOL_ALIGN);
+	}
+	void *ptr = list.back();
+	list.pop_back();
+	return ptr;
+}
+
+void AerospikeCommand::operator delete(void *ptr, size_t size)
+{
+	if (size > COMMAND_POOL_MAX_SIZE) {
+		::operator delete(ptr);
+		return;
+	}
+
+	size_t index = (size + COMMAND_POOL_ALIGN - 1) / COMMAND_POOL_ALIGN - 1;
+	std::vector<void *> &list = g_command_pool.free[index];
+	if (list.size() >= COMMAND_POOL_MAX_FREE) {
+		::operator delete(ptr);
+		return;
+	}
+	list.push_back(ptr);
+}
+
+Nan::MaybeLocal<Value> AerospikeCommand::runInAsyncScope(Local<Object> target,
+														 Local<Function> func,
+														 int argc,
+														 Local<Value> argv[])
+{
+	if (async_resource) {
+		return async_resource->runInAsyncScope(target, func, argc, argv);
+	}
+	// An empty async context still drains the microtask and nextTick queues
+	// once the callback returns.
+	return node::MakeCallback(Isolate::GetCurrent(), target, func, argc, argv,
+							  node::async_context{0, 0});
+}
+
 AerospikeCommand *AerospikeCommand::SetError(as_status code, const char *func,
 											 const char *file, uint32_t line,
 											 const char *fmt, ...)
@@ -44,47 +186,312 @@ bool AerospikeCommand::CanExecute()
 	if (IsError()) {
 		as_v8_info(log,
 				   "Skipping execution of %s command because an error occurred",
-				   cmd.c_str());
+				   cmd);
 		return false;
 	}
 
 	if (as->cluster == NULL) {
 		as_v8_info(log,
 				   "Skipping execution of %s command because client is invalid",
-				   cmd.c_str());
+				   cmd);
 		return false;
 	}
 
 	return true;
 }
 
+as_event_loop *AerospikeCommand::EventLoop()
+{
+	submitted_ns = uv_hrtime();
+	return async_event_loop();
+}
+
+void AerospikeCommand::Received()
+{
+	if (received_ns == 0) {
+		received_ns = uv_hrtime();
+	}
+	if (cache_mode == CACHE_INVALIDATE) {
+		cache->Invalidate(&cache_key);
+		cache_mode = CACHE_NONE;
+	}
+}
+
+void AerospikeCommand::Received(as_batch_records *records)
+{
+	Received();
+	if (cache_mode == CACHE_INVALIDATE_BATCH) {
+		// A read answered between sending the batch and applying its
+		// writes may have cached a record the batch has since changed.
+		CacheInvalidate(records);
+		cache_mode = CACHE_NONE;
+	}
+}
+
+void AerospikeCommand::SetNamespace(const char *ns_)
+{
+	strncpy(ns, ns_, AS_NAMESPACE_MAX_SIZE - 1);
+	ns[AS_NAMESPACE_MAX_SIZE - 1] = '\0';
+}
+
+/**
+ *  The pipeline depth is limited per node, but the node a command is sent to
+ *  is only known once the C client has resolved its partition; the limit is
+ *  therefore enforced over all of the client's pipelined commands, scaled by
+ *  the current cluster size.
+ */
+as_pipe_listener AerospikeCommand::PipeListener()
+{
+	if (!pipeline->enabled) {
+		return NULL;
+	}
+
+	if (pipeline->max_depth > 0) {
+		as_nodes *nodes = as_nodes_reserve(as->cluster);
+		uint32_t limit = pipeline->max_depth * nodes->size;
+		as_nodes_release(nodes);
+		if (pipeline->in_flight >= limit) {
+			as_v8_detail(log, "Pipeline full (%u commands), not pipelining",
+						 pipeline->in_flight);
+			return NULL;
+		}
+	}
+
+	pipeline->in_flight++;
+	pipelined = true;
+	return async_pipe_listener;
+}
+
+bool AerospikeCommand::CacheGet(as_key *key, const as_policy_read *policy,
+								bool all_bins, const char *const *bins,
+								uint32_t n_bins, bool store, as_record *out)
+{
+	if (!cache || !RecordCache::Cacheable(policy ? policy
+												 : &as->config.policies.read)) {
+		return false;
+	}
+
+	if (cache->Get(key, all_bins, bins, n_bins, out)) {
+		as_v8_detail(log, "Record cache hit");
+		return true;
+	}
+
+	as_digest *digest = as_key_digest(key);
+	if (store && digest) {
+		as_key_init_digest(&cache_key, key->ns, key->set, digest->value);
+		cache_epoch = cache->Epoch();
+		cache_mode = CACHE_STORE;
+	}
+	return false;
+}
+
+bool AerospikeCommand::CacheGet(as_batch_records *records,
+								const as_policy_batch *policy)
+{
+	if (!cache || !RecordCache::Cacheable(policy ? policy
+												 : &as->config.policies.batch)) {
+		return false;
+	}
+
+	as_vector *list = &records->list;
+	for (uint32_t i = 0; i < list->size; i++) {
+		as_batch_read_record *record =
+			(as_batch_read_record *)as_vector_get(list, i);
+		if (!RecordCache::Cacheable(record)) {
+			return false;
+		}
+	}
+
+	uint32_t hits = 0;
+	for (; hits < list->size; hits++) {
+		as_batch_read_record *record =
+			(as_batch_read_record *)as_vector_get(list, hits);
+		if (!cache->Get(&record->key, record->read_all_bins,
+						record->bin_names, record->n_bin_names,
+						&record->record)) {
+			break;
+		}
+	}
+
+	if (hits == list->size) {
+		for (uint32_t i = 0; i < list->size; i++) {
+			((as_batch_read_record *)as_vector_get(list, i))->result =
+				AEROSPIKE_OK;
+		}
+		as_v8_detail(log, "Record cache hit for all %u batch records", hits);
+		return true;
+	}
+
+	// Undo the hits; the batch is sent to the cluster as a whole.
+	for (uint32_t i = 0; i < hits; i++) {
+		as_batch_read_record *record =
+			(as_batch_read_record *)as_vector_get(list, i);
+		as_record_destroy(&record->record);
+		memset(&record->record, 0, sizeof(record->record));
+	}
+	cache_epoch = cache->Epoch();
+	cache_mode = CACHE_STORE;
+	return false;
+}
+
+void AerospikeCommand::CacheInvalidate(as_key *key)
+{
+	as_digest *digest;
+	if (!cache || !(digest = as_key_digest(key))) {
+		return;
+	}
+	cache->Invalidate(key);
+	as_key_init_digest(&cache_key, key->ns, key->set, digest->value);
+	cache_mode = CACHE_INVALIDATE;
+}
+
+void AerospikeCommand::CacheInvalidate(as_batch_records *records)
+{
+	if (!cache) {
+		return;
+	}
+	as_vector *list = &records->list;
+	for (uint32_t i = 0; i < list->size; i++) {
+		as_batch_base_record *record =
+			(as_batch_base_record *)as_vector_get(list, i);
+		if (record->type != AS_BATCH_READ) {
+			cache->Invalidate(&record->key);
+			cache_mode = CACHE_INVALIDATE_BATCH;
+		}
+	}
+}
+
+void AerospikeCommand::CacheStore(as_record *record)
+{
+	if (cache_mode == CACHE_STORE) {
+		cache->Put(&cache_key, record, cache_epoch);
+	}
+}
+
+void AerospikeCommand::CacheStore(as_batch_records *records)
+{
+	if (cache_mode != CACHE_STORE) {
+		return;
+	}
+	as_vector *list = &records->list;
+	for (uint32_t i = 0; i < list->size; i++) {
+		as_batch_read_record *record =
+			(as_batch_read_record *)as_vector_get(list, i);
+		if (record->result == AEROSPIKE_OK && record->read_all_bins) {
+			cache->Put(&record->key, &record->record, cache_epoch);
+		}
+	}
+}
+
+/**
+ *  Records the command's latency. Only commands that were submitted to the
+ *  event loop are recorded; for scans and queries, the response is their
+ *  first record.
+ */
+void AerospikeCommand::RecordLatency()
+{
+	if (!latency || latency_type == LATENCY_NONE || submitted_ns == 0) {
+		return;
+	}
+
+	uint64_t now = uv_hrtime();
+	uint64_t responded = responded_ns ? responded_ns : now;
+	uint64_t received = received_ns ? received_ns : responded;
+
+	uint64_t phases_us[LATENCY_PHASE_COUNT];
+	phases_us[LATENCY_PHASE_REQUEST] = (submitted_ns - created_ns) / 1000;
+	phases_us[LATENCY_PHASE_ROUND_TRIP] = (received - submitted_ns) / 1000;
+	phases_us[LATENCY_PHASE_RESPONSE] = (responded - received) / 1000;
+	phases_us[LATENCY_PHASE_TOTAL] = (now - created_ns) / 1000;
+	latency->Record(latency_type, ns, phases_us);
+}
+
 Local<Value> AerospikeCommand::Callback(const int argc, Local<Value> argv[])
 {
 	Nan::EscapableHandleScope scope;
-	as_v8_debug(log, "Executing JS callback for %s command", cmd.c_str());
+	if (responded_ns == 0) {
+		responded_ns = uv_hrtime();
+	}
+	as_v8_debug(log, "Executing JS callback for %s command", cmd);
 
 	Nan::TryCatch try_catch;
 	Local<Function> cb = Nan::New(callback);
-	Local<Value> result =
-		runInAsyncScope(Nan::GetCurrentContext()->Global(), cb, argc, argv)
-			.ToLocalChecked();
+	Local<Value> result;
+	if (runInAsyncScope(Nan::GetCurrentContext()->Global(), cb, argc, argv)
+			.ToLocal(&result)) {
+		return scope.Escape(result);
+	}
+
 	if (try_catch.HasCaught()) {
 		Nan::FatalException(try_catch);
+		result = Nan::Undefined();
+	}
+	else {
+		// A worker's commands still complete while it is shutting down, when
+		// it can no longer call into JS; scans and queries are aborted.
+		result = Nan::False();
 	}
 
 	return scope.Escape(result);
 }
 
+/**
+ *  Passes a scan/query record to the JS callback, or buffers it until
+ *  records_per_callback records have been received. Returns undefined while
+ *  the record is buffered.
+ */
+Local<Value> StreamCommand::RecordCallback(as_record *record)
+{
+	Nan::EscapableHandleScope scope;
+
+	Local<Value> rec =
+		record_to_jsrecord(record, key_to_jskey(&record->key, log), log);
+
+	if (records_per_callback <= 1) {
+		Local<Value> argv[] = {Nan::Null(), rec};
+		return scope.Escape(Callback(2, argv));
+	}
+
+	if (records.IsEmpty()) {
+		records.Reset(Nan::New<Array>());
+	}
+	Nan::Set(Nan::New(records), buffered, rec);
+
+	if (++buffered < records_per_callback) {
+		return scope.Escape(Nan::Undefined());
+	}
+	return scope.Escape(FlushRecords());
+}
+
+/**
+ *  Passes any buffered records to the JS callback. Returns undefined if there
+ *  were none.
+ */
+Local<Value> StreamCommand::FlushRecords()
+{
+	Nan::EscapableHandleScope scope;
+
+	if (buffered == 0) {
+		return scope.Escape(Nan::Undefined());
+	}
+
+	as_v8_debug(log, "Delivering %u buffered records", buffered);
+	Local<Value> argv[] = {Nan::Null(), Nan::New(records)};
+	records.Reset();
+	buffered = 0;
+	return scope.Escape(Callback(2, argv));
+}
+
 Local<Value> AerospikeCommand::ErrorCallback()
 {
 	Nan::EscapableHandleScope scope;
 
 	if (err.code <= AEROSPIKE_ERR_CLIENT) {
-		as_v8_error(log, "Client error in %s command: %s [%d]", cmd.c_str(),
+		as_v8_error(log, "Client error in %s command: %s [%d]", cmd,
 					err.message, err.code);
 	}
 	else {
-		as_v8_debug(log, "Server error in %s command: %s [%d]", cmd.c_str(),
+		as_v8_debug(log, "Server error in %s command: %s [%d]", cmd,
 					err.message, err.code);
 	}
 
@@ -18,6 +18,8 @@
 #include "async.h"
 #include "command.h"
 #include "conversions.h"
+#include "arena.h"
+#include "expressions.h"
 #include "policy.h"
 #include "log.h"
 
@@ -37,6 +39,8 @@ NAN_METHOD(AerospikeClient::ApplyAsync)
 	AsyncCommand *cmd =
 		new AsyncCommand("Apply", client, info[3].As<Function>());
 	LogInfo *log = client->log;
+	// The converted values are serialized before the command is submitted.
+	ArenaScope arena_scope;
 
 	as_key key;
 	bool key_initalized = false;
@@ -70,10 +74,13 @@ NAN_METHOD(AerospikeClient::ApplyAsync)
 		p_policy = &policy;
 	}
 
+	cmd->SetNamespace(key.ns);
+	cmd->CacheInvalidate(&key);
 	as_v8_debug(log, "Sending async apply command");
 	status = aerospike_key_apply_async(client->as, &cmd->err, p_policy, &key,
 									   udf_module, udf_function, udf_args,
-									   async_value_listener, cmd, NULL, NULL);
+									   async_value_listener, cmd,
+									   cmd->EventLoop(), cmd->PipeListener());
 	if (status == AEROSPIKE_OK) {
 		cmd = NULL; // async callback responsible for deleting the command
 	}
@@ -92,6 +99,6 @@ Cleanup:
 	if (udf_args)
 		as_list_destroy(udf_args);
 	if (p_policy && policy.base.filter_exp) {
-		as_exp_destroy(policy.base.filter_exp);
+		release_expression(policy.base.filter_exp);
 	}
 }
@@ -14,175 +14,79 @@
  * limitations under the License.
  ******************************************************************************/
 
+
 #include "client.h"
-#include "command.h"
 #include "async.h"
+#include "command.h"
 #include "conversions.h"
+#include "expressions.h"
 #include "policy.h"
 #include "log.h"
 
 extern "C" {
-#include <aerospike/aerospike.h>
-#include <aerospike/aerospike_key.h>
-#include <aerospike/as_config.h>
-#include <aerospike/as_key.h>
-#include <aerospike/as_record.h>
 #include <aerospike/aerospike_batch.h>
 }
 
 using namespace v8;
 
-class BatchGetCommand : public AerospikeCommand {
-  public:
-	BatchGetCommand(AerospikeClient *client, Local<Function> callback_)
-		: AerospikeCommand("BatchGet", client, callback_)
-	{
-	}
-
-	~BatchGetCommand()
-	{
-		if (policy != NULL)
-			cf_free(policy);
-		if (results != NULL)
-			cf_free(results);
-	}
-
-	as_policy_batch *policy = NULL;
-	as_batch batch;
-	as_batch_read *results = NULL;
-	uint32_t results_len = 0;
-};
-
-bool batch_get_callback(const as_batch_read *results, uint32_t n, void *udata)
+NAN_METHOD(AerospikeClient::BatchGet)
 {
-	BatchGetCommand *cmd = reinterpret_cast<BatchGetCommand *>(udata);
-	LogInfo *log = cmd->log;
-
-	as_v8_debug(log, "BatchGet callback invoked with %d batch results", n);
-
-	if (results == NULL) {
-		cmd->results = NULL;
-		cmd->results_len = 0;
-		return false;
-	}
-
-	// Copy the batch result to the shared data structure BatchGetCommand, so
-	// that the response can send it back to nodejs layer.
-	cmd->results = (as_batch_read *)calloc(n, sizeof(as_batch_read));
-	cmd->results_len = n;
-	for (uint32_t i = 0; i < n; i++) {
-		cmd->results[i].result = results[i].result;
-		key_clone(results[i].key, (as_key **)&cmd->results[i].key, log);
-		if (results[i].result == AEROSPIKE_OK) {
-			as_record *rec = &cmd->results[i].record;
-			as_record_init(rec, results[i].record.bins.size);
-			record_clone(&results[i].record, &rec, log);
-		}
-	}
-
-	return true;
-}
+	TYPE_CHECK_REQ(info[0], IsArray, "Keys must be a array");
+	TYPE_CHECK_OPT(info[1], IsObject, "Policy must be an object");
+	TYPE_CHECK_REQ(info[2], IsFunction, "Callback must be a function");
 
-static void *prepare(const Nan::FunctionCallbackInfo<v8::Value> &info)
-{
-	Nan::HandleScope scope;
 	AerospikeClient *client =
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
-	BatchGetCommand *cmd = new BatchGetCommand(client, info[2].As<Function>());
+	AsyncCommand *cmd =
+		new AsyncCommand("BatchGet", client, info[2].As<Function>());
 	LogInfo *log = client->log;
 
-	Local<Array> keys = info[0].As<Array>();
-	if (batch_from_jsarray(&cmd->batch, keys, log) != AS_NODE_PARAM_OK) {
-		return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-						   "Batch keys parameter invalid");
+	as_batch_records *records = NULL;
+	as_policy_batch policy;
+	as_policy_batch *p_policy = NULL;
+	as_status status;
+
+	if (batch_read_records_from_keys(&records, info[0].As<Array>(), NULL, 0,
+									 true, NULL, NULL, log) != AS_NODE_PARAM_OK) {
+		CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+						 "Batch keys parameter invalid");
+		goto Cleanup;
 	}
 
 	if (info[1]->IsObject()) {
-		cmd->policy = (as_policy_batch *)cf_malloc(sizeof(as_policy_batch));
-		if (batchpolicy_from_jsobject(cmd->policy, info[1].As<Object>(), log) !=
+		if (batchpolicy_from_jsobject(&policy, info[1].As<Object>(), log) !=
 			AS_NODE_PARAM_OK) {
-			return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-							   "Batch policy parameter invalid");
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Batch policy parameter invalid");
+			batch_records_destroy(records);
+			goto Cleanup;
 		}
+		p_policy = &policy;
 	}
 
-	return cmd;
-}
-
-static void execute(uv_work_t *req)
-{
-	BatchGetCommand *cmd = reinterpret_cast<BatchGetCommand *>(req->data);
-	LogInfo *log = cmd->log;
-
-	if (!cmd->CanExecute()) {
-		return;
+	if (cmd->CacheGet(records, p_policy)) {
+		async_batch_keys_listener(NULL, records, cmd, NULL);
+		cmd = NULL;
+		goto Cleanup;
 	}
 
-	as_v8_debug(log, "Executing BatchGet command for %d keys",
-				cmd->batch.keys.size);
-	if (aerospike_batch_get(cmd->as, &cmd->err, cmd->policy, &cmd->batch,
-							batch_get_callback, cmd) != AEROSPIKE_OK) {
-		cmd->results = NULL;
-		cmd->results_len = 0;
-	}
-	as_batch_destroy(&cmd->batch);
-	if (cmd->policy && cmd->policy->base.filter_exp) {
-		as_exp_destroy(cmd->policy->base.filter_exp);
-	}
-}
-
-static void respond(uv_work_t *req, int status)
-{
-	Nan::HandleScope scope;
-	BatchGetCommand *cmd = reinterpret_cast<BatchGetCommand *>(req->data);
-	LogInfo *log = cmd->log;
-
-	if (!(cmd->IsError()) || ((cmd->err.code == AEROSPIKE_BATCH_FAILED) && (cmd->results_len != 0))) {
-		as_batch_read *batch_results = cmd->results;
-		Local<Array> results = Nan::New<Array>(cmd->results_len);
-		for (uint32_t i = 0; i < cmd->results_len; i++) {
-			as_status status = batch_results[i].result;
-			as_record *record = &batch_results[i].record;
-			const as_key *key = batch_results[i].key;
-
-			Local<Object> result = Nan::New<Object>();
-			Nan::Set(result, Nan::New("status").ToLocalChecked(),
-					 Nan::New(status));
-			Nan::Set(result, Nan::New("key").ToLocalChecked(),
-					 key_to_jsobject(key ? key : &record->key, log));
-
-			if (batch_results[i].result == AEROSPIKE_OK) {
-				Nan::Set(result, Nan::New("meta").ToLocalChecked(),
-						 recordmeta_to_jsobject(record, log));
-				Nan::Set(result, Nan::New("bins").ToLocalChecked(),
-						 recordbins_to_jsobject(record, log));
-			}
-			else {
-				as_v8_debug(log, "Record [%d] not returned by server", i);
-			}
-
-			as_key_destroy((as_key *)key);
-			as_record_destroy(record);
-
-			Nan::Set(results, i, result);
-		}
-
-		Local<Value> argv[] = {Nan::Null(), results};
-		cmd->Callback(2, argv);
+	as_v8_debug(log, "Sending async BatchGet command for %d keys",
+				records->list.size);
+	status =
+		aerospike_batch_read_async(client->as, &cmd->err, p_policy, records,
+								   async_batch_keys_listener, cmd,
+								   cmd->EventLoop());
+	if (status == AEROSPIKE_OK) {
+		cmd = NULL; // async callback responsible for deleting the command
 	}
 	else {
+		batch_records_destroy(records);
 		cmd->ErrorCallback();
 	}
 
+Cleanup:
 	delete cmd;
-	delete req;
-}
-
-NAN_METHOD(AerospikeClient::BatchGet)
-{
-	TYPE_CHECK_REQ(info[0], IsArray, "Keys must be a array");
-	TYPE_CHECK_OPT(info[1], IsObject, "Policy must be an object");
-	TYPE_CHECK_REQ(info[2], IsFunction, "Callback must be a function");
-
-	async_invoke(info, prepare, execute, respond);
+	if (p_policy && policy.base.filter_exp) {
+		release_expression(policy.base.filter_exp);
+	}
 }
@@ -18,6 +18,7 @@
 #include "async.h"
 #include "command.h"
 #include "conversions.h"
+#include "expressions.h"
 #include "policy.h"
 #include "log.h"
 
@@ -56,10 +57,17 @@ NAN_METHOD(AerospikeClient::BatchReadAsync)
 		p_policy = &policy;
 	}
 
+	if (cmd->CacheGet(records, p_policy)) {
+		async_batch_listener(NULL, records, cmd, NULL);
+		cmd = NULL;
+		goto Cleanup;
+	}
+
 	as_v8_debug(log, "Sending async batch read command");
 	status =
 		aerospike_batch_read_async(client->as, &cmd->err, p_policy, records,
-								   async_batch_listener, cmd, NULL);
+								   async_batch_listener, cmd,
+								   cmd->EventLoop());
 	if (status == AEROSPIKE_OK) {
 		cmd = NULL; // async callback responsible for deleting the command
 	}
@@ -71,6 +79,6 @@ NAN_METHOD(AerospikeClient::BatchReadAsync)
 Cleanup:
 	delete cmd;
 	if (p_policy && policy.base.filter_exp) {
-		as_exp_destroy(policy.base.filter_exp);
+		release_expression(policy.base.filter_exp);
 	}
 }
@@ -0,0 +1,212 @@
+/*******************************************************************************
+ * Copyright 2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "client.h"
+#include "async.h"
+#include "command.h"
+#include "conversions.h"
+#include "expressions.h"
+#include "operations.h"
+#include "policy.h"
+#include "property_names.h"
+#include "log.h"
+
+extern "C" {
+#include <aerospike/aerospike_batch.h>
+#include <aerospike/as_operations.h>
+}
+
+using namespace v8;
+
+class BatchReadUniformCommand : public AsyncCommand {
+  public:
+	BatchReadUniformCommand(AerospikeClient *client, Local<Function> callback_)
+		: AsyncCommand("BatchReadUniform", client, callback_)
+	{
+	}
+
+	~BatchReadUniformCommand()
+	{
+		if (bins != NULL) {
+			for (uint32_t i = 0; i < bins_len; i++) {
+				cf_free(bins[i]);
+			}
+			cf_free(bins);
+		}
+		if (ops != NULL) {
+			as_operations_destroy(ops);
+		}
+		if (read_policy != NULL) {
+			release_expression(read_policy->filter_exp);
+		}
+	}
+
+	/**
+	 * Bin names, operations and read policy shared by all batch records; must
+	 * outlive the async command.
+	 */
+	char **bins = NULL;
+	uint32_t bins_len = 0;
+	as_operations *ops = NULL;
+	as_operations ops_s;
+	as_policy_batch_read *read_policy = NULL;
+	as_policy_batch_read read_policy_s;
+};
+
+NAN_METHOD(AerospikeClient::BatchReadUniform)
+{
+	TYPE_CHECK_REQ(info[0], IsObject,
+				   "Keys must be an array or a digest batch object");
+	TYPE_CHECK_REQ(info[1], IsObject, "Read must be an object");
+	TYPE_CHECK_OPT(info[2], IsObject, "Policy must be an object");
+	TYPE_CHECK_REQ(info[3], IsFunction, "Callback must be a function");
+
+	AerospikeClient *client =
+		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
+	BatchReadUniformCommand *cmd =
+		new BatchReadUniformCommand(client, info[3].As<Function>());
+	LogInfo *log = client->log;
+
+	Local<Object> read = info[1].As<Object>();
+	Local<Value> bins = Nan::Get(read, AS_V8_NAME(bins)).ToLocalChecked();
+	Local<Value> ops = Nan::Get(read, AS_V8_NAME(ops)).ToLocalChecked();
+	Local<Value> read_all_bins =
+		Nan::Get(read, AS_V8_NAME(readAllBins)).ToLocalChecked();
+	Local<Value> read_policy =
+		Nan::Get(read, AS_V8_NAME(policy)).ToLocalChecked();
+
+	as_batch_records *records = NULL;
+	as_async_batch_listener listener = async_batch_keys_listener;
+	as_policy_batch policy;
+	as_policy_batch *p_policy = NULL;
+	as_status status;
+
+	if (bins->IsArray() && ops->IsArray()) {
+		CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+						 "Batch read cannot have both bins and ops");
+		goto Cleanup;
+	}
+
+	if (bins->IsArray()) {
+		if (bins_from_jsarray(&cmd->bins, &cmd->bins_len, bins.As<Array>(),
+							  log) != AS_NODE_PARAM_OK) {
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Batch bins parameter invalid");
+			goto Cleanup;
+		}
+	}
+
+	if (ops->IsArray()) {
+		cmd->ops = &cmd->ops_s;
+		as_operations_init(cmd->ops, ops.As<Array>()->Length());
+		if (operations_from_jsarray(cmd->ops, ops.As<Array>(), log) !=
+			AS_NODE_PARAM_OK) {
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Batch ops parameter invalid");
+			goto Cleanup;
+		}
+	}
+
+	if (read_policy->IsObject()) {
+		if (batchread_policy_from_jsobject(&cmd->read_policy_s,
+										   read_policy.As<Object>(),
+										   log) != AS_NODE_PARAM_OK) {
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Batch read policy parameter invalid");
+			goto Cleanup;
+		}
+		cmd->read_policy = &cmd->read_policy_s;
+	}
+
+	if (info[0]->IsArray()) {
+		if (batch_read_records_from_keys(
+				&records, info[0].As<Array>(), cmd->bins, cmd->bins_len,
+				read_all_bins->IsTrue(), cmd->ops, cmd->read_policy,
+				log) != AS_NODE_PARAM_OK) {
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Batch keys parameter invalid");
+			goto Cleanup;
+		}
+	}
+	else {
+		// Keys given as namespace, set and a buffer of packed digests; the
+		// keys are neither read from nor returned to JS one by one.
+		Local<Object> batch = info[0].As<Object>();
+		Local<Value> ns = Nan::Get(batch, AS_V8_NAME(ns)).ToLocalChecked();
+		Local<Value> set = Nan::Get(batch, AS_V8_NAME(set)).ToLocalChecked();
+		Local<Value> digests =
+			Nan::Get(batch, AS_V8_NAME(digests)).ToLocalChecked();
+		if (!ns->IsString() || !(set->IsString() || set->IsNullOrUndefined()) ||
+			!node::Buffer::HasInstance(digests) ||
+			node::Buffer::Length(digests) % AS_DIGEST_VALUE_SIZE != 0) {
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Batch digests parameter invalid");
+			goto Cleanup;
+		}
+		Nan::Utf8String ns_str(ns);
+		Nan::Utf8String set_str(set->IsString() ? set
+												: Nan::EmptyString().As<Value>());
+		if (ns_str.length() >= AS_NAMESPACE_MAX_SIZE ||
+			set_str.length() >= AS_SET_MAX_SIZE) {
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Batch namespace or set name too long");
+			goto Cleanup;
+		}
+		batch_read_records_from_digests(
+			&records, *ns_str, *set_str,
+			(const uint8_t *)node::Buffer::Data(digests),
+			node::Buffer::Length(digests) / AS_DIGEST_VALUE_SIZE, cmd->bins,
+			cmd->bins_len, read_all_bins->IsTrue(), cmd->ops,
+			cmd->read_policy, log);
+		listener = async_batch_digests_listener;
+	}
+
+	if (info[2]->IsObject()) {
+		if (batchpolicy_from_jsobject(&policy, info[2].As<Object>(), log) !=
+			AS_NODE_PARAM_OK) {
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Batch policy parameter invalid");
+			batch_records_destroy(records);
+			goto Cleanup;
+		}
+		p_policy = &policy;
+	}
+
+	if (cmd->CacheGet(records, p_policy)) {
+		listener(NULL, records, cmd, NULL);
+		cmd = NULL;
+		goto Cleanup;
+	}
+
+	as_v8_debug(log, "Sending async BatchReadUniform command for %d keys",
+				records->list.size);
+	status =
+		aerospike_batch_read_async(client->as, &cmd->err, p_policy, records,
+								   listener, cmd, cmd->EventLoop());
+	if (status == AEROSPIKE_OK) {
+		cmd = NULL; // async callback responsible for deleting the command
+	}
+	else {
+		batch_records_destroy(records);
+		cmd->ErrorCallback();
+	}
+
+Cleanup:
+	delete cmd;
+	if (p_policy && policy.base.filter_exp) {
+		release_expression(policy.base.filter_exp);
+	}
+}
@@ -14,121 +14,61 @@
  * limitations under the License.
  ******************************************************************************/
 
+
 #include "client.h"
-#include "command.h"
 #include "async.h"
+#include "command.h"
 #include "conversions.h"
+#include "expressions.h"
 #include "policy.h"
 #include "log.h"
 
 extern "C" {
-#include <aerospike/aerospike.h>
-#include <aerospike/aerospike_key.h>
-#include <aerospike/as_config.h>
-#include <aerospike/as_key.h>
-#include <aerospike/as_record.h>
 #include <aerospike/aerospike_batch.h>
-#include <aerospike/as_status.h>
 }
 
-
 using namespace v8;
 
-class BatchRemoveCommand : public AerospikeCommand {
+class BatchRemoveCommand : public AsyncCommand {
   public:
 	BatchRemoveCommand(AerospikeClient *client, Local<Function> callback_)
-		: AerospikeCommand("BatchRemove", client, callback_)
+		: AsyncCommand("BatchRemove", client, callback_)
 	{
-		as_batch_init(&batch, 0);
 	}
-	static void BatchRemoveCommandFree(BatchRemoveCommand *cmd)
+
+	~BatchRemoveCommand()
 	{
-		if (cmd->policy) {
-			if (cmd->policy->base.filter_exp) {
-				as_exp_destroy(cmd->policy->base.filter_exp);
-			}
-			cf_free(cmd->policy);
-			cmd->policy = NULL;
-		}
-		if (cmd->policy_remove) {
-			if (cmd->policy_remove->filter_exp) {
-				as_exp_destroy(cmd->policy_remove->filter_exp);
+		if (policy_remove) {
+			if (policy_remove->filter_exp) {
+				release_expression(policy_remove->filter_exp);
 			}
-			cf_free(cmd->policy_remove);
-			cmd->policy_remove = NULL;
-		}
-		if (cmd->results != NULL) {
-			cf_free(cmd->results);
-			cmd->results = NULL;
+			cf_free(policy_remove);
 		}
-		as_batch_destroy(&cmd->batch);
 	}
-	~BatchRemoveCommand() { BatchRemoveCommandFree(this); }
 
-	as_policy_batch *policy = NULL;
-	as_batch batch;
-	as_batch_result *results = NULL;
-	uint32_t results_len = 0;
 	/**
-	 * Optional remove policy.
+	 * Optional remove policy, shared by all batch records.
 	 */
 	as_policy_batch_remove *policy_remove = NULL;
 };
 
-bool batch_remove_callback(const as_batch_result *results, uint32_t n,
-						   void *udata)
+NAN_METHOD(AerospikeClient::BatchRemove)
 {
-	BatchRemoveCommand *cmd = reinterpret_cast<BatchRemoveCommand *>(udata);
-	LogInfo *log = cmd->log;
-
-	as_v8_debug(log, "BatchRemove callback invoked with %d batch results", n);
-
-	if (results == NULL) {
-		cmd->results = NULL;
-		cmd->results_len = 0;
-		return false;
-	}
-
-	// Copy the batch result to the shared data structure BatchRemoveCommand, so
-	// that the response can send it back to nodejs layer.
-	cmd->results = (as_batch_read *)calloc(n, sizeof(as_batch_read));
-	cmd->results_len = n;
-	for (uint32_t i = 0; i < n; i++) {
-		cmd->results[i].result = results[i].result;
-		key_clone(results[i].key, (as_key **)&cmd->results[i].key, log);
-		if (results[i].result == AEROSPIKE_OK) {
-			as_record *rec = &cmd->results[i].record;
-			as_record_init(rec, results[i].record.bins.size);
-			record_clone(&results[i].record, &rec, log);
-		}
-	}
-
-	return true;
-}
+	TYPE_CHECK_REQ(info[0], IsArray, "Keys must be a array");
+	TYPE_CHECK_OPT(info[1], IsObject, "Batch policy must be an object");
+	TYPE_CHECK_OPT(info[2], IsObject, "Batch remove policy must be an object");
+	TYPE_CHECK_REQ(info[3], IsFunction, "Callback must be a function");
 
-static void *prepare(const Nan::FunctionCallbackInfo<v8::Value> &info)
-{
-	Nan::HandleScope scope;
 	AerospikeClient *client =
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
 	BatchRemoveCommand *cmd =
 		new BatchRemoveCommand(client, info[3].As<Function>());
 	LogInfo *log = client->log;
 
-	Local<Array> keys = info[0].As<Array>();
-	if (batch_from_jsarray(&cmd->batch, keys, log) != AS_NODE_PARAM_OK) {
-		return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-						   "Batch keys parameter invalid");
-	}
-
-	if (info[1]->IsObject()) {
-		cmd->policy = (as_policy_batch *)cf_malloc(sizeof(as_policy_batch));
-		if (batchpolicy_from_jsobject(cmd->policy, info[1].As<Object>(), log) !=
-			AS_NODE_PARAM_OK) {
-			return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-							   "Batch policy parameter invalid");
-		}
-	}
+	as_batch_records *records = NULL;
+	as_policy_batch policy;
+	as_policy_batch *p_policy = NULL;
+	as_status status;
 
 	if (info[2]->IsObject()) {
 		cmd->policy_remove =
@@ -136,87 +76,49 @@ static void *prepare(const Nan::FunctionCallbackInfo<v8::Value> &info)
 		if (batchremove_policy_from_jsobject(cmd->policy_remove,
 											 info[2].As<Object>(),
 											 log) != AS_NODE_PARAM_OK) {
-			return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-							   "Batch remove policy parameter invalid");
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Batch remove policy parameter invalid");
+			goto Cleanup;
 		}
 	}
 
-	return cmd;
-}
-
-static void execute(uv_work_t *req)
-{
-	BatchRemoveCommand *cmd = reinterpret_cast<BatchRemoveCommand *>(req->data);
-	LogInfo *log = cmd->log;
-
-	if (!cmd->CanExecute()) {
-		return;
+	if (batch_remove_records_from_keys(&records, info[0].As<Array>(),
+									   cmd->policy_remove,
+									   log) != AS_NODE_PARAM_OK) {
+		CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+						 "Batch keys parameter invalid");
+		goto Cleanup;
 	}
 
-	as_v8_debug(log, "Executing BatchRemove command for %d keys",
-				cmd->batch.keys.size);
-	if (aerospike_batch_remove(cmd->as, &cmd->err, cmd->policy,
-							   cmd->policy_remove, &cmd->batch,
-							   batch_remove_callback, cmd) != AEROSPIKE_OK) {
-		cmd->results = NULL;
-		cmd->results_len = 0;
-	}
-}
-
-static void respond(uv_work_t *req, int status)
-{
-	Nan::HandleScope scope;
-	BatchRemoveCommand *cmd = reinterpret_cast<BatchRemoveCommand *>(req->data);
-	LogInfo *log = cmd->log;
-
-
-	if (!(cmd->IsError()) || ((cmd->err.code == AEROSPIKE_BATCH_FAILED) && (cmd->results_len != 0))) {
-		as_batch_read *batch_results = cmd->results;
-		Local<Array> results = Nan::New<Array>(cmd->results_len);
-		for (uint32_t i = 0; i < cmd->results_len; i++) {
-			as_status status = batch_results[i].result;
-			as_record *record = &batch_results[i].record;
-			const as_key *key = batch_results[i].key;
-
-			Local<Object> result = Nan::New<Object>();
-			Nan::Set(result, Nan::New("status").ToLocalChecked(),
-					 Nan::New(status));
-			Nan::Set(result, Nan::New("key").ToLocalChecked(),
-					 key_to_jsobject(key ? key : &record->key, log));
-
-			if (batch_results[i].result == AEROSPIKE_OK) {
-				Nan::Set(result, Nan::New("meta").ToLocalChecked(),
-						 recordmeta_to_jsobject(record, log));
-				Nan::Set(result, Nan::New("bins").ToLocalChecked(),
-						 recordbins_to_jsobject(record, log));
-			}
-			else {
-				as_v8_debug(log, "Record [%d] not returned by server", i);
-			}
-
-			as_key_destroy((as_key *)key);
-			as_record_destroy(record);
-
-			Nan::Set(results, i, result);
+	if (info[1]->IsObject()) {
+		if (batchpolicy_from_jsobject(&policy, info[1].As<Object>(), log) !=
+			AS_NODE_PARAM_OK) {
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Batch policy parameter invalid");
+			batch_records_destroy(records);
+			goto Cleanup;
 		}
+		p_policy = &policy;
+	}
 
-		Local<Value> argv[] = {Nan::Null(), results};
-		cmd->Callback(2, argv);
+	cmd->CacheInvalidate(records);
+	as_v8_debug(log, "Sending async BatchRemove command for %d keys",
+				records->list.size);
+	status =
+		aerospike_batch_write_async(client->as, &cmd->err, p_policy, records,
+									async_batch_keys_listener, cmd,
+									cmd->EventLoop());
+	if (status == AEROSPIKE_OK) {
+		cmd = NULL; // async callback responsible for deleting the command
 	}
 	else {
+		batch_records_destroy(records);
 		cmd->ErrorCallback();
 	}
 
+Cleanup:
 	delete cmd;
-	delete req;
-}
-
-NAN_METHOD(AerospikeClient::BatchRemove)
-{
-	TYPE_CHECK_REQ(info[0], IsArray, "Keys must be a array");
-	TYPE_CHECK_OPT(info[1], IsObject, "Batch policy must be an object");
-	TYPE_CHECK_OPT(info[2], IsObject, "Batch remove policy must be an object");
-	TYPE_CHECK_REQ(info[3], IsFunction, "Callback must be a function");
-
-	async_invoke(info, prepare, execute, respond);
+	if (p_policy && policy.base.filter_exp) {
+		release_expression(policy.base.filter_exp);
+	}
 }
@@ -18,6 +18,7 @@
 #include "async.h"
 #include "command.h"
 #include "conversions.h"
+#include "expressions.h"
 #include "policy.h"
 #include "log.h"
 
@@ -56,10 +57,12 @@ NAN_METHOD(AerospikeClient::BatchWriteAsync)
 		p_policy = &policy;
 	}
 
+	cmd->CacheInvalidate(records);
 	as_v8_debug(log, "Sending async batch write command");
 	status =
 		aerospike_batch_write_async(client->as, &cmd->err, p_policy, records,
-									async_batch_listener, cmd, NULL);
+									async_batch_listener, cmd,
+									cmd->EventLoop());
 	if (status == AEROSPIKE_OK) {
 		cmd = NULL; // async callback responsible for deleting the command
 	}
@@ -71,6 +74,6 @@ NAN_METHOD(AerospikeClient::BatchWriteAsync)
 Cleanup:
 	delete cmd;
 	if (p_policy && policy.base.filter_exp) {
-		as_exp_destroy(policy.base.filter_exp);
+		release_expression(policy.base.filter_exp);
 	}
 }
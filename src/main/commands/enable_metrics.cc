@@ -46,6 +46,7 @@ class MetricsCommand : public AerospikeCommand {
 		: AerospikeCommand("Metrics", client, callback_)
 	{	
 		client_closed = &(client->closed);
+		loop = Nan::GetCurrentEventLoop();
 	}
 
 	~MetricsCommand()
@@ -91,6 +92,7 @@ class MetricsCommand : public AerospikeCommand {
 	}
 
 	bool* client_closed;
+	uv_loop_t* loop;
 	bool disabled = false;
 	char* report_dir = NULL;
 	
@@ -210,7 +212,7 @@ async_invoke_metrics_callback(MetricsCommand *cmd, void (*execute)(uv_work_t *re
 
 	// Pass the work request to libuv to be run when a
 	// worker-thread is available to process it.
-	uv_queue_work(uv_default_loop(), // event loop
+	uv_queue_work(cmd->loop,		 // event loop of the isolate that enabled metrics
 				  req,				 // work token
 				  execute,			 // execute work, nothing since no C Code must be executed
 				  respond			 // respond to callback by running the appropriate metrics callback
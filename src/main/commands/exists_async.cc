@@ -18,6 +18,7 @@
 #include "async.h"
 #include "command.h"
 #include "conversions.h"
+#include "expressions.h"
 #include "policy.h"
 #include "log.h"
 
@@ -57,9 +58,11 @@ NAN_METHOD(AerospikeClient::ExistsAsync)
 		p_policy = &policy;
 	}
 
+	cmd->SetNamespace(key.ns);
 	as_v8_debug(log, "Sending async exists command");
 	status = aerospike_key_exists_async(client->as, &cmd->err, p_policy, &key,
-										async_record_listener, cmd, NULL, NULL);
+										async_record_listener, cmd,
+										cmd->EventLoop(), cmd->PipeListener());
 	if (status == AEROSPIKE_OK) {
 		cmd = NULL; // async callback responsible for deleting the command
 	}
@@ -72,6 +75,6 @@ Cleanup:
 	if (key_initalized)
 		as_key_destroy(&key);
 	if (p_policy && policy.base.filter_exp) {
-		as_exp_destroy(policy.base.filter_exp);
+		release_expression(policy.base.filter_exp);
 	}
 }
@@ -18,6 +18,7 @@
 #include "async.h"
 #include "command.h"
 #include "conversions.h"
+#include "expressions.h"
 #include "policy.h"
 #include "log.h"
 
@@ -31,13 +32,15 @@ NAN_METHOD(AerospikeClient::GetAsync)
 
 	AerospikeClient *client =
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
-	AsyncCommand *cmd = new AsyncCommand("Get", client, info[2].As<Function>());
+	RecordCommand *cmd =
+		new RecordCommand("Get", client, info[2].As<Function>(), info[0]);
 	LogInfo *log = client->log;
 
 	as_key key;
 	bool key_initalized = false;
 	as_policy_read policy;
 	as_policy_read *p_policy = NULL;
+	as_record cached;
 	as_status status = AEROSPIKE_ERR;
 
 	if (key_from_jsobject(&key, info[0].As<Object>(), log) !=
@@ -56,9 +59,18 @@ NAN_METHOD(AerospikeClient::GetAsync)
 		p_policy = &policy;
 	}
 
+	if (cmd->CacheGet(&key, p_policy, true, NULL, 0, true, &cached)) {
+		async_read_record_listener(NULL, &cached, cmd, NULL);
+		as_record_destroy(&cached);
+		cmd = NULL;
+		goto Cleanup;
+	}
+
+	cmd->SetNamespace(key.ns);
 	as_v8_debug(log, "Sending async get command");
 	status = aerospike_key_get_async(client->as, &cmd->err, p_policy, &key,
-									 async_record_listener, cmd, NULL, NULL);
+									 async_read_record_listener, cmd,
+									 cmd->EventLoop(), cmd->PipeListener());
 	if (status == AEROSPIKE_OK) {
 		cmd = NULL; // async callback responsible for deleting the command
 	}
@@ -71,6 +83,6 @@ Cleanup:
 	if (key_initalized)
 		as_key_destroy(&key);
 	if (p_policy && policy.base.filter_exp) {
-		as_exp_destroy(policy.base.filter_exp);
+		release_expression(policy.base.filter_exp);
 	}
 }
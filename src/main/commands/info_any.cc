@@ -24,116 +24,56 @@
 
 extern "C" {
 #include <aerospike/aerospike.h>
-#include <aerospike/aerospike_info.h>
 }
 
-#define MAX_INFO_REQUEST_LEN 256
-
 using namespace v8;
 
-class InfoAnyCommand : public AerospikeCommand {
-  public:
-	InfoAnyCommand(AerospikeClient *client, Local<Function> callback_)
-		: AerospikeCommand("InfoAny", client, callback_)
-	{
+static void respond(InfoCommand *cmd)
+{
+	if (cmd->IsError()) {
+		cmd->ErrorCallback();
+		return;
 	}
 
-	~InfoAnyCommand()
-	{
-		if (policy != NULL)
-			cf_free(policy);
-		if (request != NULL && strlen(request) > 0)
-			cf_free(request);
-		if (response != NULL)
-			cf_free(response);
+	Local<Value> response;
+	if (cmd->responses[0].length() > 0) {
+		response = Nan::New(cmd->responses[0]).ToLocalChecked();
 	}
+	else {
+		response = Nan::Null();
+	}
+	Local<Value> argv[] = {Nan::Null(), response};
+	cmd->Callback(2, argv);
+}
 
-	as_policy_info *policy = NULL;
-	char *request = NULL;
-	char *response = NULL;
-};
-
-static void *prepare(const Nan::FunctionCallbackInfo<v8::Value> &info)
+NAN_METHOD(AerospikeClient::InfoAny)
 {
-	Nan::HandleScope scope;
+	TYPE_CHECK_OPT(info[0], IsString, "Request must be a string");
+	TYPE_CHECK_OPT(info[1], IsObject, "Policy must be an object");
+	TYPE_CHECK_REQ(info[2], IsFunction, "Callback must be a function");
+
 	AerospikeClient *client =
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
-	InfoAnyCommand *cmd = new InfoAnyCommand(client, info[2].As<Function>());
+	InfoCommand *cmd =
+		new InfoCommand("InfoAny", client, info[2].As<Function>(), respond);
 	LogInfo *log = client->log;
 
 	if (info[0]->IsString()) {
-		cmd->request = (char *)cf_malloc(MAX_INFO_REQUEST_LEN);
-		size_t reqlen =
-			as_strlcpy(cmd->request, *Nan::Utf8String(info[0].As<String>()),
-					   MAX_INFO_REQUEST_LEN);
-		if (reqlen > MAX_INFO_REQUEST_LEN) {
-			as_v8_info(log,
-					   "Info request exceeds max. length (%zu > %i): \"%s...\"",
-					   reqlen, MAX_INFO_REQUEST_LEN, cmd->request);
-			return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-							   "Info request exceeds max. length");
-		}
-	}
-	else {
-		cmd->request = (char *)"";
+		cmd->request = *Nan::Utf8String(info[0].As<String>());
 	}
 
 	if (info[1]->IsObject()) {
-		cmd->policy = (as_policy_info *)cf_malloc(sizeof(as_policy_info));
-		if (infopolicy_from_jsobject(cmd->policy, info[1].As<Object>(), log) !=
+		if (infopolicy_from_jsobject(&cmd->policy, info[1].As<Object>(), log) !=
 			AS_NODE_PARAM_OK) {
-			return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-							   "Policy parameter is invalid");
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Policy parameter is invalid");
+			delete cmd;
+			return;
 		}
-	}
-
-	return cmd;
-}
-
-static void execute(uv_work_t *req)
-{
-	InfoAnyCommand *cmd = reinterpret_cast<InfoAnyCommand *>(req->data);
-	LogInfo *log = cmd->log;
-
-	if (!cmd->CanExecute()) {
-		return;
+		cmd->p_policy = &cmd->policy;
 	}
 
 	as_v8_debug(log, "Sending info command \"%s\" to random cluster host",
-				cmd->request);
-	aerospike_info_any(cmd->as, &cmd->err, cmd->policy, cmd->request,
-					   &cmd->response);
-}
-
-static void respond(uv_work_t *req, int status)
-{
-	Nan::HandleScope scope;
-	InfoAnyCommand *cmd = reinterpret_cast<InfoAnyCommand *>(req->data);
-
-	if (cmd->IsError()) {
-		cmd->ErrorCallback();
-	}
-	else {
-		Local<Value> response;
-		if (cmd->response != NULL && strlen(cmd->response) > 0) {
-			response = Nan::New(cmd->response).ToLocalChecked();
-		}
-		else {
-			response = Nan::Null();
-		}
-		Local<Value> argv[] = {Nan::Null(), response};
-		cmd->Callback(2, argv);
-	}
-
-	delete cmd;
-	delete req;
-}
-
-NAN_METHOD(AerospikeClient::InfoAny)
-{
-	TYPE_CHECK_OPT(info[0], IsString, "Request must be a string");
-	TYPE_CHECK_OPT(info[1], IsObject, "Policy must be an object");
-	TYPE_CHECK_REQ(info[2], IsFunction, "Callback must be a function");
-
-	async_invoke(info, prepare, execute, respond);
+				cmd->request.c_str());
+	async_info_send_any(cmd);
 }
@@ -24,176 +24,96 @@
 
 extern "C" {
 #include <aerospike/aerospike.h>
-#include <aerospike/aerospike_info.h>
+#include <aerospike/as_cluster.h>
 #include <aerospike/as_node.h>
 }
 
-#define INFO_REQUEST_LEN 50
-
 using namespace v8;
 
-typedef struct node_info_s {
-	char *info;
-	char node[AS_NODE_NAME_SIZE];
-} node_info;
-
-class InfoForeachCommand : public AerospikeCommand {
-  public:
-	InfoForeachCommand(AerospikeClient *client, Local<Function> callback_)
-		: AerospikeCommand("InfoForeach", client, callback_)
-	{
-		results = as_vector_create(sizeof(node_info), 4);
-	}
+static void respond(InfoCommand *cmd)
+{
+	LogInfo *log = cmd->log;
 
-	~InfoForeachCommand()
-	{
-		if (policy != NULL)
-			cf_free(policy);
-		if (request != NULL && strlen(request) > 0)
-			cf_free(request);
-		as_vector_destroy(results);
+	if (cmd->IsError()) {
+		cmd->ErrorCallback();
+		return;
 	}
 
-	as_policy_info *policy = NULL;
-	char *request = NULL;
-	as_vector *results;
-};
+	uint32_t size = cmd->nodes.size();
+	Local<Array> v8Results = Nan::New<Array>(size);
+	as_v8_debug(log, "num of responses %d", size);
+	for (uint32_t i = 0; i < size; i++) {
+		const std::string &node = cmd->nodes[i];
+		const std::string &info = cmd->responses[i];
 
-bool aerospike_info_callback(const as_error *error, const as_node *node,
-							 const char *info_req, char *response, void *udata)
-{
-	InfoForeachCommand *cmd = reinterpret_cast<InfoForeachCommand *>(udata);
-	LogInfo *log = cmd->log;
-	node_info result;
-
-	if (strlen(node->name) > 0) {
-		as_v8_debug(log, "Response from node %s", node->name);
-		if (as_strlcpy(result.node, node->name, AS_NODE_NAME_SIZE) >
-			AS_NODE_NAME_SIZE) {
-			as_v8_info(log, "Node name exceeds max. length (%d)",
-					   AS_NODE_NAME_SIZE);
+		Local<Object> v8Result = Nan::New<Object>();
+		Local<Object> v8Node = Nan::New<Object>();
+
+		if (node.length() > 0) {
+			as_v8_debug(log, "Node name: %s", node.c_str());
+			Nan::Set(v8Node, Nan::New("node_id").ToLocalChecked(),
+					 Nan::New(node).ToLocalChecked());
 		}
-	}
-	else {
-		result.node[0] = '\0';
-		as_v8_debug(log, "No host name from cluster");
-	}
 
-	if (response != NULL) {
-		as_v8_debug(log, "Response is %s", response);
-		result.info = strdup(response);
-	}
-	else {
-		result.info = NULL;
-		as_v8_debug(log, "No response from cluster");
-	}
+		Nan::Set(v8Result, Nan::New("host").ToLocalChecked(), v8Node);
+
+		if (info.length() > 0) {
+			as_v8_debug(log, "Info response: %s", info.c_str());
+			Nan::Set(v8Result, Nan::New("info").ToLocalChecked(),
+					 Nan::New(info).ToLocalChecked());
+		}
 
-	as_vector_append(cmd->results, (void *)&result);
+		Nan::Set(v8Results, i, v8Result);
+	}
 
-	return true;
+	Local<Value> argv[] = {Nan::Null(), v8Results};
+	cmd->Callback(2, argv);
 }
 
-static void *prepare(const Nan::FunctionCallbackInfo<Value> &info)
+NAN_METHOD(AerospikeClient::InfoForeach)
 {
-	Nan::HandleScope scope;
+	TYPE_CHECK_OPT(info[0], IsString, "Request must be a string");
+	TYPE_CHECK_OPT(info[1], IsObject, "Policy must be an object");
+	TYPE_CHECK_REQ(info[2], IsFunction, "Callback must be a function");
+
 	AerospikeClient *client =
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
-	InfoForeachCommand *cmd =
-		new InfoForeachCommand(client, info[2].As<Function>());
+	InfoCommand *cmd = new InfoCommand("InfoForeach", client,
+									   info[2].As<Function>(), respond);
 	LogInfo *log = client->log;
 
 	if (info[0]->IsString()) {
-		cmd->request = (char *)malloc(INFO_REQUEST_LEN);
-		if (as_strlcpy(cmd->request, *Nan::Utf8String(info[0].As<String>()),
-					   INFO_REQUEST_LEN) > INFO_REQUEST_LEN) {
-			return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-							   "Info request exceeds max. length (%d)",
-							   INFO_REQUEST_LEN);
-		}
-	}
-	else {
-		cmd->request = (char *)"";
+		cmd->request = *Nan::Utf8String(info[0].As<String>());
 	}
 
 	if (info[1]->IsObject()) {
-		cmd->policy = (as_policy_info *)cf_malloc(sizeof(as_policy_info));
-		if (infopolicy_from_jsobject(cmd->policy, info[1].As<Object>(), log) !=
+		if (infopolicy_from_jsobject(&cmd->policy, info[1].As<Object>(), log) !=
 			AS_NODE_PARAM_OK) {
-			return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-							   "Policy parameter is invalid");
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Policy parameter is invalid");
+			delete cmd;
+			return;
 		}
+		cmd->p_policy = &cmd->policy;
 	}
 
-	return cmd;
-}
-
-static void execute(uv_work_t *req)
-{
-	InfoForeachCommand *cmd = reinterpret_cast<InfoForeachCommand *>(req->data);
-	LogInfo *log = cmd->log;
-
-	if (!cmd->CanExecute()) {
+	if (client->as->cluster == NULL) {
+		CmdErrorCallback(cmd, AEROSPIKE_ERR_CLIENT, "Client is not connected");
+		delete cmd;
 		return;
 	}
 
-	as_v8_debug(log, "Sending info command \"%s\" to all cluster hosts",
-				cmd->request);
-	aerospike_info_foreach(cmd->as, &cmd->err, cmd->policy, cmd->request,
-						   aerospike_info_callback, (void *)cmd);
-}
-
-static void respond(uv_work_t *req, int status)
-{
-	Nan::HandleScope scope;
-	InfoForeachCommand *cmd = reinterpret_cast<InfoForeachCommand *>(req->data);
-	LogInfo *log = cmd->log;
-
-	if (cmd->IsError()) {
-		cmd->ErrorCallback();
-	}
-	else {
-		as_vector *results = cmd->results;
-		Local<Array> v8Results = Nan::New<Array>(results->size);
-		as_v8_debug(log, "num of responses %d", results->size);
-		for (uint32_t i = 0; i < results->size; i++) {
-			node_info *result = (node_info *)as_vector_get(results, i);
-			const char *info = result->info;
-			const char *node = result->node;
-
-			Local<Object> v8Result = Nan::New<Object>();
-			Local<Object> v8Node = Nan::New<Object>();
-
-			if (node != NULL && strlen(node) > 0) {
-				as_v8_debug(log, "Node name: %s", node);
-				Nan::Set(v8Node, Nan::New("node_id").ToLocalChecked(),
-						 Nan::New(node).ToLocalChecked());
-			}
-
-			Nan::Set(v8Result, Nan::New("host").ToLocalChecked(), v8Node);
-
-			if (info != NULL && strlen(info) > 0) {
-				as_v8_debug(log, "Info response: %s", info);
-				Nan::Set(v8Result, Nan::New("info").ToLocalChecked(),
-						 Nan::New(info).ToLocalChecked());
-				cf_free((void *)info);
-			}
-
-			Nan::Set(v8Results, i, v8Result);
-		}
-
-		Local<Value> argv[] = {Nan::Null(), v8Results};
-		cmd->Callback(2, argv);
+	as_nodes *nodes = as_nodes_reserve(client->as->cluster);
+	if (nodes->size == 0) {
+		as_nodes_release(nodes);
+		CmdErrorCallback(cmd, AEROSPIKE_ERR_INVALID_NODE,
+						 "No cluster node available");
+		delete cmd;
+		return;
 	}
 
-	delete cmd;
-	delete req;
-}
-
-NAN_METHOD(AerospikeClient::InfoForeach)
-{
-	TYPE_CHECK_OPT(info[0], IsString, "Request must be a string");
-	TYPE_CHECK_OPT(info[1], IsObject, "Policy must be an object");
-	TYPE_CHECK_REQ(info[2], IsFunction, "Callback must be a function");
-
-	async_invoke(info, prepare, execute, respond);
+	as_v8_debug(log, "Sending info command \"%s\" to all cluster hosts",
+				cmd->request.c_str());
+	async_info_send(cmd, nodes->array, nodes->size);
+	as_nodes_release(nodes);
 }
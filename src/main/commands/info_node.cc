@@ -24,130 +24,71 @@
 
 extern "C" {
 #include <aerospike/aerospike.h>
-#include <aerospike/aerospike_info.h>
 #include <aerospike/as_cluster.h>
+#include <aerospike/as_node.h>
 }
 
-#define MAX_INFO_REQUEST_LEN 256
-
 using namespace v8;
 
-class InfoNodeCommand : public AerospikeCommand {
-  public:
-	InfoNodeCommand(AerospikeClient *client, Local<Function> callback_)
-		: AerospikeCommand("InfoNode", client, callback_)
-	{
+static void respond(InfoCommand *cmd)
+{
+	if (cmd->IsError()) {
+		cmd->ErrorCallback();
+		return;
 	}
 
-	~InfoNodeCommand()
-	{
-		if (policy != NULL)
-			cf_free(policy);
-		if (request != NULL && strlen(request) > 0)
-			cf_free(request);
-		if (response != NULL)
-			cf_free(response);
+	Local<Value> response;
+	if (cmd->responses[0].length() > 0) {
+		response = Nan::New(cmd->responses[0]).ToLocalChecked();
 	}
+	else {
+		response = Nan::Null();
+	}
+	Local<Value> argv[] = {Nan::Null(), response};
+	cmd->Callback(2, argv);
+}
 
-	as_policy_info *policy = NULL;
-	char *request = NULL;
-	char *response = NULL;
-	char node_name[AS_NODE_NAME_SIZE] = {'\0'};
-};
-
-static void *prepare(const Nan::FunctionCallbackInfo<v8::Value> &info)
+NAN_METHOD(AerospikeClient::InfoNode)
 {
-	Nan::HandleScope scope;
+	TYPE_CHECK_OPT(info[0], IsString, "Request must be a string");
+	TYPE_CHECK_REQ(info[1], IsString, "Node must be a string");
+	TYPE_CHECK_OPT(info[2], IsObject, "Policy must be an object");
+	TYPE_CHECK_REQ(info[3], IsFunction, "Callback must be a function");
+
 	AerospikeClient *client =
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
-	InfoNodeCommand *cmd = new InfoNodeCommand(client, info[3].As<Function>());
+	InfoCommand *cmd =
+		new InfoCommand("InfoNode", client, info[3].As<Function>(), respond);
 	LogInfo *log = client->log;
+	Nan::Utf8String node_name(info[1].As<String>());
+	as_node *node = NULL;
 
 	if (info[0]->IsString()) {
-		cmd->request = (char *)cf_malloc(MAX_INFO_REQUEST_LEN);
-		size_t reqlen =
-			as_strlcpy(cmd->request, *Nan::Utf8String(info[0].As<String>()),
-					   MAX_INFO_REQUEST_LEN);
-		if (reqlen > MAX_INFO_REQUEST_LEN) {
-			as_v8_info(log,
-					   "Info request exceeds max. length (%zu > %i): \"%s...\"",
-					   reqlen, MAX_INFO_REQUEST_LEN, cmd->request);
-			return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-							   "Info request exceeds max. length");
-		}
-	}
-	else {
-		cmd->request = (char *)"";
+		cmd->request = *Nan::Utf8String(info[0].As<String>());
 	}
 
-	Local<String> node_name = info[1].As<String>();
-	snprintf(cmd->node_name, AS_NODE_NAME_SIZE, "%s", *Nan::Utf8String(node_name));
-
 	if (info[2]->IsObject()) {
-		cmd->policy = (as_policy_info *)cf_malloc(sizeof(as_policy_info));
-		if (infopolicy_from_jsobject(cmd->policy, info[2].As<Object>(), log) !=
+		if (infopolicy_from_jsobject(&cmd->policy, info[2].As<Object>(), log) !=
 			AS_NODE_PARAM_OK) {
-			return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-							   "Policy parameter is invalid");
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Policy parameter is invalid");
+			delete cmd;
+			return;
 		}
+		cmd->p_policy = &cmd->policy;
 	}
 
-	return cmd;
-}
-
-static void execute(uv_work_t *req)
-{
-	InfoNodeCommand *cmd = reinterpret_cast<InfoNodeCommand *>(req->data);
-	LogInfo *log = cmd->log;
-
-	if (!cmd->CanExecute()) {
-		return;
-	}
-
-	as_cluster *cluster = cmd->as->cluster;
-	as_node *node = as_node_get_by_name(cluster, cmd->node_name);
-	if (node) {
-		as_v8_debug(log, "Sending info command \"%s\" to cluster node %s",
-					cmd->request, cmd->node_name);
-		aerospike_info_node(cmd->as, &cmd->err, cmd->policy, node, cmd->request,
-							&cmd->response);
-		as_node_release(node);
-	}
-	else {
-		as_v8_error(log, "No cluster node with name %s found", cmd->node_name);
-	}
-}
-
-static void respond(uv_work_t *req, int status)
-{
-	Nan::HandleScope scope;
-	InfoNodeCommand *cmd = reinterpret_cast<InfoNodeCommand *>(req->data);
-
-	if (cmd->IsError()) {
-		cmd->ErrorCallback();
+	if (client->as->cluster) {
+		node = as_node_get_by_name(client->as->cluster, *node_name);
 	}
-	else {
-		Local<Value> response;
-		if (cmd->response != NULL && strlen(cmd->response) > 0) {
-			response = Nan::New(cmd->response).ToLocalChecked();
-		}
-		else {
-			response = Nan::Null();
-		}
-		Local<Value> argv[] = {Nan::Null(), response};
-		cmd->Callback(2, argv);
+	if (!node) {
+		as_v8_error(log, "No cluster node with name %s found", *node_name);
+		CmdErrorCallback(cmd, AEROSPIKE_ERR_INVALID_NODE,
+						 "No cluster node with name %s found", *node_name);
+		delete cmd;
+		return;
 	}
 
-	delete cmd;
-	delete req;
-}
-
-NAN_METHOD(AerospikeClient::InfoNode)
-{
-	TYPE_CHECK_OPT(info[0], IsString, "Request must be a string");
-	TYPE_CHECK_REQ(info[1], IsString, "Node must be a string");
-	TYPE_CHECK_OPT(info[2], IsObject, "Policy must be an object");
-	TYPE_CHECK_REQ(info[3], IsFunction, "Callback must be a function");
-
-	async_invoke(info, prepare, execute, respond);
+	async_info_send(cmd, &node, 1);
+	as_node_release(node);
 }
@@ -22,90 +22,100 @@
 #include "log.h"
 
 extern "C" {
-#include <aerospike/aerospike_scan.h>
+#include <aerospike/aerospike.h>
+#include <aerospike/as_cluster.h>
 #include <aerospike/as_error.h>
 #include <aerospike/as_job.h>
-#include <aerospike/as_policy.h>
+#include <aerospike/as_node.h>
 #include <aerospike/as_status.h>
 }
 
 using namespace v8;
 
-class JobInfoCommand : public AerospikeCommand {
-  public:
-	JobInfoCommand(AerospikeClient *client, Local<Function> callback_)
-		: AerospikeCommand("JobInfo", client, callback_)
-	{
-	}
+/**
+ *  Merges a node's job status, a list of "name=value" fields separated by
+ *  colons, into the cluster-wide job info.
+ */
+static void jobinfo_merge(as_job_info *job_info, const std::string &response)
+{
+	size_t start = response.find('\t');
+	start = (start == std::string::npos) ? 0 : start + 1;
+	std::string fields = response.substr(start);
 
-	~JobInfoCommand()
-	{
-		if (policy != NULL)
-			cf_free(policy);
-		if (module)
-			free(module);
+	while (!fields.empty() && fields.back() == '\n') {
+		fields.pop_back();
 	}
 
-	as_policy_info *policy = NULL;
-	uint64_t job_id = 0;
-	char *module = NULL;
-	as_job_info job_info;
-};
-
-static void *prepare(const Nan::FunctionCallbackInfo<Value> &info)
-{
-	AerospikeClient *client =
-		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
-	JobInfoCommand *cmd = new JobInfoCommand(client, info[3].As<Function>());
-	LogInfo *log = client->log;
+	as_job_status status = AS_JOB_STATUS_COMPLETED;
+	uint32_t progress_pct = 100;
+	uint64_t records_read = 0;
+	size_t pos = 0;
 
-	cmd->job_id = Nan::To<int64_t>(info[0]).FromJust();
-	cmd->module = strdup(*Nan::Utf8String(info[1].As<String>()));
+	while (pos < fields.size()) {
+		size_t end = fields.find(':', pos);
+		if (end == std::string::npos) {
+			end = fields.size();
+		}
 
-	if (info[2]->IsObject()) {
-		cmd->policy = (as_policy_info *)cf_malloc(sizeof(as_policy_info));
-		if (infopolicy_from_jsobject(cmd->policy, info[2].As<Object>(), log) !=
-			AS_NODE_PARAM_OK) {
-			return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-							   "Policy parameter is invalid");
+		std::string field = fields.substr(pos, end - pos);
+		size_t eq = field.find('=');
+		if (eq != std::string::npos) {
+			std::string name = field.substr(0, eq);
+			const char *value = field.c_str() + eq + 1;
+
+			if (name == "status") {
+				if (strncmp(value, "active", 6) == 0 ||
+					strncmp(value, "in-progress", 11) == 0) {
+					status = AS_JOB_STATUS_INPROGRESS;
+				}
+			}
+			else if (name == "job-progress" || name == "job_progress") {
+				progress_pct = (uint32_t)atoi(value);
+			}
+			else if (name == "recs-read" || name == "recs_read" ||
+					 name == "recs-succeeded") {
+				records_read = strtoull(value, NULL, 10);
+			}
 		}
+
+		pos = end + 1;
 	}
 
-	return cmd;
+	if (status == AS_JOB_STATUS_INPROGRESS) {
+		job_info->status = AS_JOB_STATUS_INPROGRESS;
+	}
+	if (progress_pct < job_info->progress_pct) {
+		job_info->progress_pct = progress_pct;
+	}
+	job_info->records_read += records_read;
 }
 
-static void execute(uv_work_t *req)
+static void respond(InfoCommand *cmd)
 {
-	JobInfoCommand *cmd = reinterpret_cast<JobInfoCommand *>(req->data);
 	LogInfo *log = cmd->log;
 
-	if (!cmd->CanExecute()) {
-		return;
+	// A node that does not know the job, e.g. because it joined the cluster
+	// after the job was started, does not fail the command.
+	for (as_status status : cmd->statuses) {
+		if (status != AEROSPIKE_OK && status != AEROSPIKE_ERR_RECORD_NOT_FOUND) {
+			cmd->ErrorCallback();
+			return;
+		}
 	}
 
-	as_v8_debug(log, "Executing JobInfo command: job ID: %lli, module: %s",
-				cmd->job_id, cmd->module);
-	aerospike_job_info(cmd->as, &cmd->err, cmd->policy, cmd->module,
-					   cmd->job_id, false, &cmd->job_info);
-}
-
-static void respond(uv_work_t *req, int status)
-{
-	Nan::HandleScope scope;
-	JobInfoCommand *cmd = reinterpret_cast<JobInfoCommand *>(req->data);
-	LogInfo *log = cmd->log;
+	as_job_info job_info;
+	job_info.status = AS_JOB_STATUS_COMPLETED;
+	job_info.progress_pct = 100;
+	job_info.records_read = 0;
 
-	if (cmd->IsError()) {
-		cmd->ErrorCallback();
-	}
-	else {
-		Local<Value> argv[] = {Nan::Null(),
-							   jobinfo_to_jsobject(&cmd->job_info, log)};
-		cmd->Callback(2, argv);
+	for (size_t i = 0; i < cmd->responses.size(); i++) {
+		if (cmd->statuses[i] == AEROSPIKE_OK) {
+			jobinfo_merge(&job_info, cmd->responses[i]);
+		}
 	}
 
-	delete cmd;
-	delete req;
+	Local<Value> argv[] = {Nan::Null(), jobinfo_to_jsobject(&job_info, log)};
+	cmd->Callback(2, argv);
 }
 
 NAN_METHOD(AerospikeClient::JobInfo)
@@ -115,5 +125,45 @@ NAN_METHOD(AerospikeClient::JobInfo)
 	TYPE_CHECK_OPT(info[2], IsObject, "Policy must be an object");
 	TYPE_CHECK_REQ(info[3], IsFunction, "Callback must be a function");
 
-	async_invoke(info, prepare, execute, respond);
+	AerospikeClient *client =
+		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
+	InfoCommand *cmd =
+		new InfoCommand("JobInfo", client, info[3].As<Function>(), respond);
+	LogInfo *log = client->log;
+	uint64_t job_id = (uint64_t)Nan::To<int64_t>(info[0]).FromJust();
+	Nan::Utf8String module(info[1].As<String>());
+
+	if (info[2]->IsObject()) {
+		if (infopolicy_from_jsobject(&cmd->policy, info[2].As<Object>(), log) !=
+			AS_NODE_PARAM_OK) {
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Policy parameter is invalid");
+			delete cmd;
+			return;
+		}
+		cmd->p_policy = &cmd->policy;
+	}
+
+	if (client->as->cluster == NULL) {
+		CmdErrorCallback(cmd, AEROSPIKE_ERR_CLIENT, "Client is not connected");
+		delete cmd;
+		return;
+	}
+
+	// Background scans and queries are both tracked as query jobs.
+	cmd->request = "query-show:trid=" + std::to_string(job_id);
+
+	as_nodes *nodes = as_nodes_reserve(client->as->cluster);
+	if (nodes->size == 0) {
+		as_nodes_release(nodes);
+		CmdErrorCallback(cmd, AEROSPIKE_ERR_INVALID_NODE,
+						 "No cluster node available");
+		delete cmd;
+		return;
+	}
+
+	as_v8_debug(log, "Executing JobInfo command: job ID: %llu, module: %s",
+				(unsigned long long)job_id, *module);
+	async_info_send(cmd, nodes->array, nodes->size);
+	as_nodes_release(nodes);
 }
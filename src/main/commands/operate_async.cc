@@ -18,7 +18,11 @@
 #include "async.h"
 #include "command.h"
 #include "conversions.h"
+#include "arena.h"
 #include "operations.h"
+#include "prepared_operations.h"
+#include "property_names.h"
+#include "expressions.h"
 #include "policy.h"
 #include "log.h"
 
@@ -27,19 +31,22 @@ using namespace v8;
 NAN_METHOD(AerospikeClient::OperateAsync)
 {
 	TYPE_CHECK_REQ(info[0], IsObject, "Key must be an object");
-	TYPE_CHECK_REQ(info[1], IsArray, "Operations must be an array");
+	TYPE_CHECK_REQ(info[1], IsObject,
+				   "Operations must be an array or bound prepared operations");
 	TYPE_CHECK_OPT(info[2], IsObject, "Metadata must be an object");
 	TYPE_CHECK_OPT(info[3], IsObject, "Policy must be an object");
 	TYPE_CHECK_REQ(info[4], IsFunction, "Callback must be a function");
 
 	Local<Object> keyObj = info[0].As<Object>();
-	Local<Array> ops = info[1].As<Array>();
+	Local<Object> ops = info[1].As<Object>();
 	Local<Function> cb = info[4].As<Function>();
 
 	AerospikeClient *client =
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
-	AsyncCommand *cmd = new AsyncCommand("Operate", client, cb);
+	RecordCommand *cmd = new RecordCommand("Operate", client, cb, keyObj);
 	LogInfo *log = client->log;
+	// The converted values are serialized before the command is submitted.
+	ArenaScope arena_scope;
 
 	as_key key;
 	bool key_initalized = false;
@@ -55,10 +62,28 @@ NAN_METHOD(AerospikeClient::OperateAsync)
 	}
 	key_initalized = true;
 
-	as_operations_init(&operations, ops->Length());
-	if (operations_from_jsarray(&operations, ops, log) != AS_NODE_PARAM_OK) {
-		CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM, "Operations array invalid");
-		goto Cleanup;
+	if (ops->IsArray()) {
+		as_operations_init(&operations, ops.As<Array>()->Length());
+		if (operations_from_jsarray(&operations, ops.As<Array>(), log) !=
+			AS_NODE_PARAM_OK) {
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Operations array invalid");
+			goto Cleanup;
+		}
+	}
+	else {
+		// Operations prepared by operations.prepare(), bound to their values.
+		Local<Value> prepared =
+			Nan::Get(ops, AS_V8_NAME(prepared)).ToLocalChecked();
+		Local<Value> values = Nan::Get(ops, AS_V8_NAME(values)).ToLocalChecked();
+		if (!PreparedOperations::HasInstance(prepared) || !values->IsArray() ||
+			PreparedOperations::Bind(&operations, prepared.As<Object>(),
+									 values.As<Array>(),
+									 log) != AS_NODE_PARAM_OK) {
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Prepared operations invalid");
+			goto Cleanup;
+		}
 	}
 	operations_initalized = true;
 
@@ -77,10 +102,13 @@ NAN_METHOD(AerospikeClient::OperateAsync)
 		p_policy = &policy;
 	}
 
+	cmd->SetNamespace(key.ns);
+	cmd->CacheInvalidate(&key);
 	as_v8_debug(log, "Sending async operate command");
 	status = aerospike_key_operate_async(client->as, &cmd->err, p_policy, &key,
-										 &operations, async_record_listener,
-										 cmd, NULL, NULL);
+										 &operations,
+										 async_read_record_listener, cmd,
+										 cmd->EventLoop(), cmd->PipeListener());
 	if (status == AEROSPIKE_OK) {
 		cmd = NULL; // async callback responsible for deleting the command
 	}
@@ -95,6 +123,6 @@ Cleanup:
 	if (operations_initalized)
 		as_operations_destroy(&operations);
 	if (p_policy && policy.base.filter_exp) {
-		as_exp_destroy(policy.base.filter_exp);
+		release_expression(policy.base.filter_exp);
 	}
 }
@@ -18,6 +18,8 @@
 #include "async.h"
 #include "command.h"
 #include "conversions.h"
+#include "arena.h"
+#include "expressions.h"
 #include "policy.h"
 #include "log.h"
 
@@ -35,6 +37,8 @@ NAN_METHOD(AerospikeClient::PutAsync)
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
 	AsyncCommand *cmd = new AsyncCommand("Put", client, info[4].As<Function>());
 	LogInfo *log = client->log;
+	// The converted values are serialized before the command is submitted.
+	ArenaScope arena_scope;
 
 	as_key key;
 	bool key_initalized = false;
@@ -75,10 +79,13 @@ NAN_METHOD(AerospikeClient::PutAsync)
 		p_policy = &policy;
 	}
 
+	cmd->SetNamespace(key.ns);
+	cmd->CacheInvalidate(&key);
 	as_v8_debug(log, "Sending async put command");
 	status =
 		aerospike_key_put_async(client->as, &cmd->err, p_policy, &key, &record,
-								async_write_listener, cmd, NULL, NULL);
+								async_write_listener, cmd,
+								cmd->EventLoop(), cmd->PipeListener());
 	if (status == AEROSPIKE_OK) {
 		cmd = NULL; // async callback responsible for deleting the command
 	}
@@ -93,6 +100,6 @@ Cleanup:
 	if (record_initalized)
 		as_record_destroy(&record);
 	if (p_policy && policy.base.filter_exp) {
-		as_exp_destroy(policy.base.filter_exp);
+		release_expression(policy.base.filter_exp);
 	}
 }
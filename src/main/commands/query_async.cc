@@ -43,8 +43,8 @@ NAN_METHOD(AerospikeClient::QueryAsync)
 
 	AerospikeClient *client =
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
-	AsyncCommand *cmd =
-		new AsyncCommand("Query", client, info[4].As<Function>());
+	StreamCommand *cmd =
+		new StreamCommand("Query", client, info[4].As<Function>());
 	LogInfo *log = client->log;
 
 	as_query query;
@@ -70,6 +70,15 @@ NAN_METHOD(AerospikeClient::QueryAsync)
 		p_policy = &policy;
 	}
 
+	if (info[2]->IsObject() &&
+		get_optional_uint32_property(&cmd->records_per_callback, NULL,
+									 info[2].As<Object>(), "recordsPerCallback",
+									 log) != AS_NODE_PARAM_OK) {
+		CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+						 "recordsPerCallback must be a number");
+		goto Cleanup;
+	}
+
 	as_partition_filter_set_all(&pf);
 	if (partitions_from_jsobject(&pf, &pf_defined, info[2].As<Object>(), log) !=
 		AS_NODE_PARAM_OK) {
@@ -77,16 +86,18 @@ NAN_METHOD(AerospikeClient::QueryAsync)
 		goto Cleanup;
 	}
 
+	cmd->SetNamespace(query.ns);
 	if (pf_defined) {
 		as_v8_debug(log, "Sending async query partitions command");
 		status = aerospike_query_partitions_async(
 			client->as, &cmd->err, p_policy, &query, &pf, async_scan_listener,
-			cmd, NULL);
+			cmd, cmd->EventLoop());
 	}
 	else {
 		as_v8_debug(log, "Sending async query command");
 		status = aerospike_query_async(client->as, &cmd->err, p_policy, &query,
-									   async_scan_listener, cmd, NULL);
+									   async_scan_listener, cmd,
+									   cmd->EventLoop());
 	}
 
 	if (status == AEROSPIKE_OK) {
@@ -18,6 +18,7 @@
 #include "command.h"
 #include "async.h"
 #include "conversions.h"
+#include "expressions.h"
 #include "policy.h"
 #include "log.h"
 #include "query.h"
@@ -101,7 +102,7 @@ static void execute(uv_work_t *req)
 							   &cmd->query_id);
 
 	if (cmd->policy && cmd->policy->base.filter_exp) {
-		as_exp_destroy(cmd->policy->base.filter_exp);
+		release_expression(cmd->policy->base.filter_exp);
 	}
 }
 
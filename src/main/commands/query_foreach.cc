@@ -18,31 +18,30 @@
 #include "command.h"
 #include "async.h"
 #include "conversions.h"
+#include "expressions.h"
 #include "policy.h"
 #include "log.h"
 #include "query.h"
+#include "value_queue.h"
 
 extern "C" {
 #include <aerospike/aerospike_query.h>
 #include <aerospike/as_error.h>
 #include <aerospike/as_policy.h>
 #include <aerospike/as_query.h>
-#include <aerospike/as_sleep.h>
 #include <aerospike/as_status.h>
-#include <aerospike/as_queue_mt.h>
 }
 
 using namespace v8;
 
-#define QUEUE_SZ 100000
+// Default for the maxQueueSize query option
+#define DEFAULT_QUEUE_SZ 10000
 
 class QueryForeachCommand : public AerospikeCommand {
   public:
 	QueryForeachCommand(AerospikeClient *client, Local<Function> callback_)
 		: AerospikeCommand("QueryForeach", client, callback_)
 	{
-		max_q_size = QUEUE_SZ; // TODO: make this configurable
-		results = as_queue_mt_create(sizeof(as_val *), max_q_size);
 	}
 
 	~QueryForeachCommand()
@@ -51,7 +50,7 @@ class QueryForeachCommand : public AerospikeCommand {
 		if (policy != NULL)
 			cf_free(policy);
 		if (results != NULL) {
-			as_queue_mt_destroy(results);
+			delete results;
 			results = NULL;
 		}
 		if(with_context){
@@ -62,20 +61,21 @@ class QueryForeachCommand : public AerospikeCommand {
 	as_exp *exp = NULL;
 	as_policy_query *policy = NULL;
 	as_query query;
-	as_queue_mt *results;
-	uint32_t max_q_size;
-	uint32_t signal_interval = 0;
+	ValueQueue *results = NULL;
+	uint32_t max_q_size = DEFAULT_QUEUE_SZ;
 	uv_async_t async_handle;
 	as_cdt_ctx context;
 	bool with_context = false;
+	bool aborted = false;
 };
 
-// Push the record from the server to a queue.
-// The record cannot be passed directly from query callback to v8 thread
+// Push the value from the server to a queue.
+// The value cannot be passed directly from query callback to v8 thread
 // because v8 objects can only be created inside a v8 context. This
 // callback is in C client thread, which is not aware of the v8 context. So
-// store this records in a temporary queue. When the queue reaches a certain
-// size, signal v8 thread to process the queue.
+// store the values in a bounded queue and signal the v8 thread as soon as
+// the queue becomes non-empty. If the v8 thread falls behind, the C client
+// thread blocks until there is room in the queue again.
 static bool async_queue_populate(const as_val *val, QueryForeachCommand *cmd)
 {
 	if (cmd->results == NULL) {
@@ -84,37 +84,48 @@ static bool async_queue_populate(const as_val *val, QueryForeachCommand *cmd)
 		return false;
 	}
 
-	// Clone the value as as_val is freed up after the callback.
-	as_val *clone = asval_clone((as_val *)val, cmd->log);
-	if (clone != NULL) {
-		if (as_queue_mt_size(cmd->results) >= cmd->max_q_size) {
-			as_sleep(1000);
-		}
-		as_queue_mt_push(cmd->results, &clone);
-		cmd->signal_interval++;
-		if (cmd->signal_interval % (cmd->max_q_size / 20) == 0) {
-			cmd->signal_interval = 0;
-			uv_async_send(&cmd->async_handle);
-		}
+	// The value is freed up after the callback; heap allocated values only
+	// need an additional reference to outlive it.
+	as_val *ref = val->free ? as_val_reserve(val)
+							: asval_clone((as_val *)val, cmd->log);
+	if (ref == NULL) {
+		return true;
+	}
+
+	bool wakeup = false;
+	if (!cmd->results->Push(ref, &wakeup)) {
+		as_val_destroy(ref);
+		return false;
+	}
+	if (wakeup) {
+		uv_async_send(&cmd->async_handle);
 	}
 
 	return true;
 }
 
-// Pop each record from the queue and invoke the node callback with this record.
+// Pop each value from the queue and invoke the node callback with this value.
+// Once the callback returns false, i.e. the stream was aborted, the queue is
+// closed, which also stops the query.
 static void async_queue_process(QueryForeachCommand *cmd)
 {
 	Nan::HandleScope scope;
 
 	const int argc = 2;
-	as_val *val = NULL;
-	while (cmd->results && !as_queue_mt_empty(cmd->results)) {
-		if (as_queue_mt_pop(cmd->results, &val, AS_QUEUE_FOREVER)) {
+	std::vector<as_val *> vals;
+	cmd->results->Drain(vals);
+	for (as_val *val : vals) {
+		if (!cmd->aborted) {
 			Local<Value> argv[argc] = {Nan::Null(),
 									   val_to_jsvalue(val, cmd->log)};
-			cmd->Callback(2, argv);
-			as_val_destroy(val);
+			Local<Value> result = cmd->Callback(argc, argv);
+			if (result->IsFalse()) {
+				as_v8_debug(cmd->log, "Query foreach callback returned false");
+				cmd->aborted = true;
+				cmd->results->Close();
+			}
 		}
+		as_val_destroy(val);
 	}
 }
 
@@ -157,8 +168,21 @@ static void *prepare(const Nan::FunctionCallbackInfo<Value> &info)
 		new QueryForeachCommand(client, info[4].As<Function>());
 	LogInfo *log = client->log;
 
+	uv_async_init(Nan::GetCurrentEventLoop(), &cmd->async_handle,
+				  async_callback);
+	cmd->async_handle.data = (void *)cmd;
+
 	setup_query(&cmd->query, info[0], info[1], info[2], &cmd->context, &cmd->with_context, &cmd->exp, log);
 
+	if (info[2]->IsObject() &&
+		get_optional_uint32_property(&cmd->max_q_size, NULL,
+									 info[2].As<Object>(), "maxQueueSize",
+									 log) != AS_NODE_PARAM_OK) {
+		return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
+						   "maxQueueSize must be a number");
+	}
+	cmd->results = new ValueQueue(cmd->max_q_size);
+
 	if (info[3]->IsObject()) {
 		cmd->policy = (as_policy_query *)cf_malloc(sizeof(as_policy_query));
 		if (querypolicy_from_jsobject(cmd->policy, info[3].As<Object>(), log) !=
@@ -168,9 +192,6 @@ static void *prepare(const Nan::FunctionCallbackInfo<Value> &info)
 		}
 	}
 
-	uv_async_init(uv_default_loop(), &cmd->async_handle, async_callback);
-	cmd->async_handle.data = (void *)cmd;
-
 	return cmd;
 }
 
@@ -193,7 +214,7 @@ static void execute(uv_work_t *req)
 	uv_async_send(&cmd->async_handle);
 
 	if (cmd->policy && cmd->policy->base.filter_exp) {
-		as_exp_destroy(cmd->policy->base.filter_exp);
+		release_expression(cmd->policy->base.filter_exp);
 	}
 }
 
@@ -203,11 +224,14 @@ static void respond(uv_work_t *req, int status)
 	QueryForeachCommand *cmd =
 		reinterpret_cast<QueryForeachCommand *>(req->data);
 
-	if (cmd->IsError()) {
+	if (cmd->aborted && cmd->err.code == AEROSPIKE_ERR_CLIENT_ABORT) {
+		as_v8_debug(cmd->log, "Query foreach aborted by the application");
+	}
+	else if (cmd->IsError()) {
 		cmd->ErrorCallback();
 	}
 	else {
-		if (cmd->results && !as_queue_mt_empty(cmd->results)) {
+		if (cmd->results) {
 			async_queue_process(cmd);
 		}
 		cmd->Callback(0, {});
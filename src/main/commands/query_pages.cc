@@ -18,6 +18,7 @@
 #include "async.h"
 #include "command.h"
 #include "conversions.h"
+#include "expressions.h"
 #include "policy.h"
 #include "log.h"
 #include "query.h"
@@ -47,8 +48,8 @@ NAN_METHOD(AerospikeClient::QueryPages)
 
 	AerospikeClient *client =
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
-	AsyncCommand *cmd =
-		new AsyncCommand("Query", client, info[7].As<Function>());
+	StreamCommand *cmd =
+		new StreamCommand("Query", client, info[7].As<Function>());
 	LogInfo *log = client->log;
 
 	as_policy_query* p_policy = NULL;
@@ -99,6 +100,15 @@ NAN_METHOD(AerospikeClient::QueryPages)
 		p_policy = &policy;
 	}
 
+	if (info[2]->IsObject() &&
+		get_optional_uint32_property(&cmd->records_per_callback, NULL,
+									 info[2].As<Object>(), "recordsPerCallback",
+									 log) != AS_NODE_PARAM_OK) {
+		CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+						 "recordsPerCallback must be a number");
+		goto Cleanup;
+	}
+
 	as_partition_filter_set_all(&pf);
 	if (partitions_from_jsobject(&pf, &pf_defined, info[2].As<Object>(), log) !=
 		AS_NODE_PARAM_OK) {
@@ -112,17 +122,19 @@ NAN_METHOD(AerospikeClient::QueryPages)
 	}
 
 
+	cmd->SetNamespace(qu->query->ns);
 	if (pf_defined) {
 		as_v8_debug(log, "Sending async query partitions command");
 		status = aerospike_query_partitions_async(
 			client->as, &cmd->err, p_policy, (as_query*) qu->query, &pf, async_query_pages_listener,
-			qu, NULL);
+			qu, cmd->EventLoop());
 	}
 	else {
 		as_v8_debug(log, "Sending async query command");
 	
 		status = aerospike_query_async(client->as, &cmd->err, p_policy, (as_query*) qu->query,
-									   async_query_pages_listener, qu, NULL);
+									   async_query_pages_listener, qu,
+									   cmd->EventLoop());
 	}
 
 	if (status == AEROSPIKE_OK) {
@@ -135,7 +147,7 @@ NAN_METHOD(AerospikeClient::QueryPages)
 Cleanup:
 	delete cmd;
 	if (p_policy && policy.base.filter_exp) {
-		as_exp_destroy(policy.base.filter_exp);
+		release_expression(policy.base.filter_exp);
 	}
 	if(with_context) {
 		as_cdt_ctx_destroy(&context);
@@ -18,6 +18,7 @@
 #include "async.h"
 #include "command.h"
 #include "conversions.h"
+#include "expressions.h"
 #include "policy.h"
 #include "log.h"
 #include "scan.h"
@@ -44,8 +45,8 @@ NAN_METHOD(AerospikeClient::ScanAsync)
 
 	AerospikeClient *client =
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
-	AsyncCommand *cmd =
-		new AsyncCommand("Scan", client, info[5].As<Function>());
+	StreamCommand *cmd =
+		new StreamCommand("Scan", client, info[5].As<Function>());
 	LogInfo *log = client->log;
 
 	as_scan scan;
@@ -72,6 +73,15 @@ NAN_METHOD(AerospikeClient::ScanAsync)
 		as_v8_debug(log, "Using scan ID %lli for async scan.", scan_id);
 	}
 
+	if (info[2]->IsObject() &&
+		get_optional_uint32_property(&cmd->records_per_callback, NULL,
+									 info[2].As<Object>(), "recordsPerCallback",
+									 log) != AS_NODE_PARAM_OK) {
+		CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+						 "recordsPerCallback must be a number");
+		goto Cleanup;
+	}
+
 	as_partition_filter_set_all(&pf);
 	if (partitions_from_jsobject(&pf, &pf_defined, info[2].As<Object>(), log) !=
 		AS_NODE_PARAM_OK) {
@@ -79,16 +89,18 @@ NAN_METHOD(AerospikeClient::ScanAsync)
 		goto Cleanup;
 	}
 
+	cmd->SetNamespace(scan.ns);
 	if (pf_defined) {
 		as_v8_debug(log, "Sending async scan partitions command");
 		status = aerospike_scan_partitions_async(
 			client->as, &cmd->err, p_policy, &scan, &pf, async_scan_listener,
-			cmd, NULL);
+			cmd, cmd->EventLoop());
 	}
 	else {
 		as_v8_debug(log, "Sending async scan command");
 		status = aerospike_scan_async(client->as, &cmd->err, p_policy, &scan,
-									  &scan_id, async_scan_listener, cmd, NULL);
+									  &scan_id, async_scan_listener, cmd,
+									  cmd->EventLoop());
 	}
 
 	if (status == AEROSPIKE_OK) {
@@ -101,7 +113,7 @@ NAN_METHOD(AerospikeClient::ScanAsync)
 Cleanup:
 	delete cmd;
 	if (p_policy && policy.base.filter_exp) {
-		as_exp_destroy(policy.base.filter_exp);
+		release_expression(policy.base.filter_exp);
 	}
 	as_scan_destroy(&scan);
 }
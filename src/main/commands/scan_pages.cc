@@ -18,6 +18,7 @@
 #include "async.h"
 #include "command.h"
 #include "conversions.h"
+#include "expressions.h"
 #include "policy.h"
 #include "log.h"
 #include "scan.h"
@@ -45,8 +46,8 @@ NAN_METHOD(AerospikeClient::ScanPages)
 
 	AerospikeClient *client =
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
-	AsyncCommand *cmd =
-		new AsyncCommand("Scan", client, info[6].As<Function>());
+	StreamCommand *cmd =
+		new StreamCommand("Scan", client, info[6].As<Function>());
 
 	LogInfo *log = client->log;
 
@@ -91,6 +92,15 @@ NAN_METHOD(AerospikeClient::ScanPages)
 	}
 
 	
+	if (info[2]->IsObject() &&
+		get_optional_uint32_property(&cmd->records_per_callback, NULL,
+									 info[2].As<Object>(), "recordsPerCallback",
+									 log) != AS_NODE_PARAM_OK) {
+		CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+						 "recordsPerCallback must be a number");
+		goto Cleanup;
+	}
+
 	as_partition_filter_set_all(&pf);
 	if (partitions_from_jsobject(&pf, &pf_defined, info[2].As<Object>(), log) !=
 		AS_NODE_PARAM_OK) {
@@ -101,16 +111,18 @@ NAN_METHOD(AerospikeClient::ScanPages)
 	su->max_records = p_policy->max_records;
 	p_policy->max_records = 0;
 
+	cmd->SetNamespace(su->scan->ns);
 	if (pf_defined) {
 		as_v8_debug(log, "Sending async scan partitions command");
 		status = aerospike_scan_partitions_async(
 			client->as, &cmd->err, p_policy, su->scan, &pf, async_scan_pages_listener,
-			su, NULL);
+			su, cmd->EventLoop());
 	}
 	else {
 		as_v8_debug(log, "Sending async scan command");
 		status = aerospike_scan_async(client->as, &cmd->err, p_policy, su->scan,
-									  &scan_id, async_scan_pages_listener, su, NULL);
+									  &scan_id, async_scan_pages_listener, su,
+									  cmd->EventLoop());
 	}
 	if (status == AEROSPIKE_OK) {
 		cmd = NULL; // async callback responsible for deleting the command
@@ -122,6 +134,6 @@ NAN_METHOD(AerospikeClient::ScanPages)
 Cleanup:
 	delete cmd;
 	if (p_policy && policy.base.filter_exp) {
-		as_exp_destroy(policy.base.filter_exp);
+		release_expression(policy.base.filter_exp);
 	}
 }
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include "async.h"
 #include "command.h"
 #include "conversions.h"
+#include "expressions.h"
 #include "policy.h"
 #include "log.h"
 
@@ -32,8 +33,8 @@ NAN_METHOD(AerospikeClient::SelectAsync)
 
 	AerospikeClient *client =
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
-	AsyncCommand *cmd =
-		new AsyncCommand("Select", client, info[3].As<Function>());
+	RecordCommand *cmd =
+		new RecordCommand("Select", client, info[3].As<Function>(), info[0]);
 	LogInfo *log = client->log;
 
 	as_key key;
@@ -42,6 +43,7 @@ NAN_METHOD(AerospikeClient::SelectAsync)
 	uint32_t num_bins = 0;
 	as_policy_read policy;
 	as_policy_read *p_policy = NULL;
+	as_record cached;
 	as_status status;
 
 	if (key_from_jsobject(&key, info[0].As<Object>(), log) !=
@@ -66,10 +68,21 @@ NAN_METHOD(AerospikeClient::SelectAsync)
 		p_policy = &policy;
 	}
 
+	// Select responses only hold some of the bins and are not cached.
+	if (cmd->CacheGet(&key, p_policy, false, bins, num_bins, false,
+					  &cached)) {
+		async_read_record_listener(NULL, &cached, cmd, NULL);
+		as_record_destroy(&cached);
+		cmd = NULL;
+		goto Cleanup;
+	}
+
+	cmd->SetNamespace(key.ns);
 	as_v8_debug(log, "Sending async select command");
 	status = aerospike_key_select_async(client->as, &cmd->err, p_policy, &key,
 										(const char **)bins,
-										async_record_listener, cmd, NULL, NULL);
+										async_read_record_listener, cmd,
+										cmd->EventLoop(), cmd->PipeListener());
 	if (status == AEROSPIKE_OK) {
 		cmd = NULL; // async callback responsible for deleting the command
 	}
@@ -82,7 +95,7 @@ Cleanup:
 	if (key_initalized)
 		as_key_destroy(&key);
 	if (p_policy && policy.base.filter_exp) {
-		as_exp_destroy(policy.base.filter_exp);
+		release_expression(policy.base.filter_exp);
 	}
 	if (bins) {
 		for (uint32_t i = 0; i < num_bins; i++) {
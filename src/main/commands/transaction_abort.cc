@@ -45,7 +45,8 @@ NAN_METHOD(AerospikeClient::TransactionAbort)
 		goto Cleanup;
 	}
 
-	status = aerospike_abort_async(client->as, &cmd->err, transaction->txn, async_abort_listener, cmd, NULL);
+	status = aerospike_abort_async(client->as, &cmd->err, transaction->txn, async_abort_listener, cmd,
+		cmd->EventLoop());
 	as_v8_debug(log, "Sending transaction abort command");
 
 	if (status == AEROSPIKE_OK) {
@@ -45,7 +45,8 @@ NAN_METHOD(AerospikeClient::TransactionCommit)
 		goto Cleanup;
 	}
 
-	status = aerospike_commit_async(client->as, &cmd->err, transaction->txn	, async_commit_listener, cmd, NULL);
+	status = aerospike_commit_async(client->as, &cmd->err, transaction->txn	, async_commit_listener, cmd,
+		cmd->EventLoop());
 	as_v8_debug(log, "Sending transaction commit command");
 
 	if (status == AEROSPIKE_OK) {
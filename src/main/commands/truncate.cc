@@ -28,102 +28,85 @@ extern "C" {
 
 using namespace v8;
 
-class TruncateCommand : public AerospikeCommand {
-  public:
-	TruncateCommand(AerospikeClient *client, Local<Function> callback_)
-		: AerospikeCommand("Truncate", client, callback_)
-	{
+static void respond(InfoCommand *cmd)
+{
+	if (!cmd->IsError()) {
+		async_info_check(&cmd->err, cmd->responses[0].c_str());
 	}
 
-	~TruncateCommand()
-	{
-		if (policy != NULL)
-			cf_free(policy);
+	if (cmd->IsError()) {
+		cmd->ErrorCallback();
 	}
+	else {
+		cmd->Callback(0, {});
+	}
+}
 
-	as_policy_info *policy = NULL;
-	as_namespace ns;
-	as_set set;
-	uint64_t before_nanos = 0;
-};
-
-static void *prepare(const Nan::FunctionCallbackInfo<Value> &info)
+NAN_METHOD(AerospikeClient::Truncate)
 {
+	TYPE_CHECK_REQ(info[0], IsString, "Namespace must be a string");
+	TYPE_CHECK_OPT(info[1], IsString, "Set must be a string");
+	TYPE_CHECK_REQ(info[2], IsNumber, "Before nanos must be a number");
+	TYPE_CHECK_OPT(info[3], IsObject, "Policy must be an object");
+	TYPE_CHECK_REQ(info[4], IsFunction, "Callback must be a function");
+
 	AerospikeClient *client =
 		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
-	TruncateCommand *cmd = new TruncateCommand(client, info[4].As<Function>());
+	InfoCommand *cmd =
+		new InfoCommand("Truncate", client, info[4].As<Function>(), respond);
 	LogInfo *log = client->log;
+	as_namespace ns;
+	as_set set = {'\0'};
+	uint64_t before_nanos = 0;
 
-	if (as_strlcpy(cmd->ns, *Nan::Utf8String(info[0].As<String>()),
+	if (as_strlcpy(ns, *Nan::Utf8String(info[0].As<String>()),
 				   AS_NAMESPACE_MAX_SIZE) > AS_NAMESPACE_MAX_SIZE) {
-		return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-						   "Namespace exceeds max. length (%d)",
-						   AS_NAMESPACE_MAX_SIZE);
+		CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+						 "Namespace exceeds max. length (%d)",
+						 AS_NAMESPACE_MAX_SIZE);
+		delete cmd;
+		return;
 	}
 
 	if (info[1]->IsString()) {
-		if (as_strlcpy(cmd->set, *Nan::Utf8String(info[1].As<String>()),
+		if (as_strlcpy(set, *Nan::Utf8String(info[1].As<String>()),
 					   AS_SET_MAX_SIZE) > AS_SET_MAX_SIZE) {
-			return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-							   "Set exceeds max. length (%d)", AS_SET_MAX_SIZE);
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Set exceeds max. length (%d)", AS_SET_MAX_SIZE);
+			delete cmd;
+			return;
 		}
 	}
 
 	if (info[2]->IsNumber()) {
-		cmd->before_nanos = (uint64_t)Nan::To<int64_t>(info[2]).FromJust();
+		before_nanos = (uint64_t)Nan::To<int64_t>(info[2]).FromJust();
 	}
 
 	if (info[3]->IsObject()) {
-		cmd->policy = (as_policy_info *)cf_malloc(sizeof(as_policy_info));
-		if (infopolicy_from_jsobject(cmd->policy, info[3].As<Object>(), log) !=
+		if (infopolicy_from_jsobject(&cmd->policy, info[3].As<Object>(), log) !=
 			AS_NODE_PARAM_OK) {
-			return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-							   "Policy parameter is invalid");
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Policy parameter is invalid");
+			delete cmd;
+			return;
 		}
+		cmd->p_policy = &cmd->policy;
 	}
 
-	return cmd;
-}
-
-static void execute(uv_work_t *req)
-{
-	TruncateCommand *cmd = reinterpret_cast<TruncateCommand *>(req->data);
-	LogInfo *log = cmd->log;
-
-	if (!cmd->CanExecute()) {
-		return;
-	}
-
-	as_v8_debug(log,
-				"Executing Truncate command: ns=%s, set=%s, before_nanos=%d",
-				cmd->ns, cmd->set, cmd->before_nanos);
-	aerospike_truncate(cmd->as, &cmd->err, cmd->policy, cmd->ns, cmd->set,
-					   cmd->before_nanos);
-}
-
-static void respond(uv_work_t *req, int status)
-{
-	Nan::HandleScope scope;
-	TruncateCommand *cmd = reinterpret_cast<TruncateCommand *>(req->data);
-
-	if (cmd->IsError()) {
-		cmd->ErrorCallback();
+	// The node receiving the request distributes it to the rest of the
+	// cluster.
+	if (strlen(set) > 0) {
+		cmd->request = std::string("truncate:namespace=") + ns + ";set=" + set;
 	}
 	else {
-		cmd->Callback(0, {});
+		cmd->request = std::string("truncate-namespace:namespace=") + ns;
+	}
+	if (before_nanos > 0) {
+		cmd->request += ";lut=" + std::to_string(before_nanos);
 	}
 
-	delete cmd;
-	delete req;
-}
-
-NAN_METHOD(AerospikeClient::Truncate)
-{
-	TYPE_CHECK_REQ(info[0], IsString, "Namespace must be a string");
-	TYPE_CHECK_OPT(info[1], IsString, "Set must be a string");
-	TYPE_CHECK_REQ(info[2], IsNumber, "Before nanos must be a number");
-	TYPE_CHECK_OPT(info[3], IsObject, "Policy must be an object");
-	TYPE_CHECK_REQ(info[4], IsFunction, "Callback must be a function");
-
-	async_invoke(info, prepare, execute, respond);
+	as_v8_debug(log,
+				"Executing Truncate command: ns=%s, set=%s, before_nanos=%llu",
+				ns, set, (unsigned long long)before_nanos);
+	async_info_send_any(cmd);
 }
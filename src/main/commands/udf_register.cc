@@ -24,183 +24,131 @@
 
 extern "C" {
 #include <aerospike/aerospike.h>
-#include <aerospike/aerospike_udf.h>
-#include <aerospike/as_bytes.h>
 #include <aerospike/as_udf.h>
-#include <aerospike/as_config.h>
 #include <aerospike/as_string.h>
+#include <citrusleaf/cf_b64.h>
 }
 
 #define MAX_FILENAME_LEN 255
 
 using namespace v8;
 
-class UdfRegisterCommand : public AerospikeCommand {
-  public:
-	UdfRegisterCommand(AerospikeClient *client, Local<Function> callback_)
-		: AerospikeCommand("UdfRegister", client, callback_)
-	{
+static void respond(InfoCommand *cmd)
+{
+	if (!cmd->IsError()) {
+		async_info_check(&cmd->err, cmd->responses[0].c_str());
 	}
 
-	~UdfRegisterCommand()
-	{
-		if (policy != NULL)
-			cf_free(policy);
-		if (flag && content.type != AS_BYTES_UNDEF)
-			as_bytes_destroy(&content);
+	if (cmd->IsError()) {
+		cmd->ErrorCallback();
 	}
+	else {
+		cmd->Callback(0, {});
+	}
+}
 
-	as_policy_info *policy = NULL;
-	char filename[MAX_FILENAME_LEN] = {'\0'};
-	as_bytes content;
-	bool flag = false;
-	as_udf_type type;
-};
-
-static void *prepare(const Nan::FunctionCallbackInfo<Value> &info)
+/**
+ *  Reads the UDF file and builds the udf-put info request, which carries the
+ *  base64-encoded file content.
+ */
+static as_status build_request(InfoCommand *cmd, const char *filepath)
 {
-	Nan::HandleScope scope;
-	AerospikeClient *client =
-		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
-	UdfRegisterCommand *cmd =
-		new UdfRegisterCommand(client, info[3].As<Function>());
-	LogInfo *log = client->log;
-
-	char *filepath = strdup(*Nan::Utf8String(info[0].As<String>()));
 	FILE *file = fopen(filepath, "r");
 	if (!file) {
 		CmdSetError(cmd, AEROSPIKE_ERR, "Cannot open file: %s", filepath);
-		if (filepath != NULL)
-			cf_free(filepath);
-		return cmd;
+		return cmd->err.code;
 	}
 
 	// Determine the file size.
 	int rv = fseek(file, 0, SEEK_END);
 	if (rv != 0) {
-		CmdSetError(cmd, AEROSPIKE_ERR_CLIENT,
-					"Cannot determine file size: fseek returned %d", rv);
-		if (filepath != NULL)
-			cf_free(filepath);
 		fclose(file);
-		return cmd;
+		CmdSetError(cmd, AEROSPIKE_ERR_CLIENT,
+					"Cannot determine file size: fseek returned %d",
+					rv);
+		return cmd->err.code;
 	}
 
-	int file_size = ftell(file);
+	long file_size = ftell(file);
 	if (file_size < 0) {
-		CmdSetError(cmd, AEROSPIKE_ERR,
-					"Cannot determine file size: ftell returned %d", file_size);
-		if (filepath != NULL)
-			cf_free(filepath);
 		fclose(file);
-		return cmd;
+		CmdSetError(cmd, AEROSPIKE_ERR,
+					"Cannot determine file size: ftell returned %ld",
+					file_size);
+		return cmd->err.code;
 	}
 
 	//Read the file's content into local buffer.
 	rewind(file);
-	uint8_t *file_content = (uint8_t *)cf_malloc(sizeof(uint8_t) * file_size);
-	if (file_content == NULL) {
-		CmdSetError(cmd, AEROSPIKE_ERR,
-					"Memory allocation for UDF buffer failed");
-		fclose(file);
-		return cmd;
-	}
-
-	uint8_t *p_write = file_content;
-	int read = fread(p_write, 1, 512, file);
-	int size = 0;
-
-	while (read) {
-		size += read;
-		p_write += read;
-		read = fread(p_write, 1, 512, file);
-	}
+	std::vector<uint8_t> content(file_size);
+	size_t size = fread(content.data(), 1, file_size, file);
 	fclose(file);
 
 	as_string filename;
 	as_basename(&filename, filepath);
 	if (as_string_get(&filename) == NULL) {
 		CmdSetError(cmd, AEROSPIKE_ERR, "Cannot determine UDF file basename");
-		if (filepath != NULL)
-			cf_free(filepath);
-		return cmd;
+		return cmd->err.code;
 	}
-	if (as_strlcpy(cmd->filename, as_string_get(&filename), MAX_FILENAME_LEN) >
-		MAX_FILENAME_LEN) {
+	if (strlen(as_string_get(&filename)) >= MAX_FILENAME_LEN) {
+		as_string_destroy(&filename);
 		CmdSetError(cmd, AEROSPIKE_ERR,
 					"UDF filename exceeds max. length (> %d)",
 					MAX_FILENAME_LEN);
-		if (filepath != NULL)
-			cf_free(filepath);
-		return cmd;
-	}
-
-	//Wrap the local buffer as an as_bytes object.
-	as_bytes_init_wrap(&cmd->content, file_content, size, true);
-
-	cmd->flag = true;
-	
-	if (info[1]->IsNumber()) {
-		cmd->type = (as_udf_type)Nan::To<int>(info[1]).FromJust();
-	}
-	else {
-		cmd->type = AS_UDF_TYPE_LUA;
-	}
-
-	if (info[2]->IsObject()) {
-		cmd->policy = (as_policy_info *)cf_malloc(sizeof(as_policy_info));
-		if (infopolicy_from_jsobject(cmd->policy, info[2].As<Object>(), log) !=
-			AS_NODE_PARAM_OK) {
-			CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-						"Policy parameter is invalid");
-			if (filepath != NULL)
-				cf_free(filepath);
-			return cmd;
-		}
+		return cmd->err.code;
 	}
 
-	if (filepath != NULL)
-		cf_free(filepath);
+	uint32_t encoded_len = cf_b64_encoded_len((uint32_t)size);
+	std::string encoded(encoded_len, '\0');
+	cf_b64_encode(content.data(), (uint32_t)size, &encoded[0]);
 
-	return cmd;
+	cmd->request = std::string("udf-put:filename=") +
+				   as_string_get(&filename) + ";content=" + encoded +
+				   ";content-len=" + std::to_string(encoded_len) +
+				   ";udf-type=LUA;";
+	as_string_destroy(&filename);
+	return AEROSPIKE_OK;
 }
 
-static void execute(uv_work_t *req)
+NAN_METHOD(AerospikeClient::Register)
 {
-	UdfRegisterCommand *cmd = reinterpret_cast<UdfRegisterCommand *>(req->data);
-	LogInfo *log = cmd->log;
+	TYPE_CHECK_REQ(info[0], IsString, "Filename must be a string");
+	TYPE_CHECK_OPT(info[1], IsNumber, "Type must be an integer");
+	TYPE_CHECK_OPT(info[2], IsObject, "Policy must be an object");
+	TYPE_CHECK_REQ(info[3], IsFunction, "Callback must be a function");
+
+	AerospikeClient *client =
+		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
+	InfoCommand *cmd = new InfoCommand("UdfRegister", client,
+									   info[3].As<Function>(), respond);
+	LogInfo *log = client->log;
+	Nan::Utf8String filepath(info[0].As<String>());
 
-	if (!cmd->CanExecute()) {
+	// Lua is the only UDF type supported by the server.
+	if (info[1]->IsNumber() &&
+		Nan::To<int>(info[1]).FromJust() != AS_UDF_TYPE_LUA) {
+		CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM, "Invalid UDF type");
+		delete cmd;
 		return;
 	}
 
-	as_v8_debug(log, "Executing UdfRegister command: %s", cmd->filename);
-	aerospike_udf_put(cmd->as, &cmd->err, cmd->policy, cmd->filename, cmd->type,
-					  &cmd->content);
-}
-
-static void respond(uv_work_t *req, int status)
-{
-	Nan::HandleScope scope;
-	UdfRegisterCommand *cmd = reinterpret_cast<UdfRegisterCommand *>(req->data);
+	if (info[2]->IsObject()) {
+		if (infopolicy_from_jsobject(&cmd->policy, info[2].As<Object>(), log) !=
+			AS_NODE_PARAM_OK) {
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Policy parameter is invalid");
+			delete cmd;
+			return;
+		}
+		cmd->p_policy = &cmd->policy;
+	}
 
-	if (cmd->IsError()) {
+	if (build_request(cmd, *filepath) != AEROSPIKE_OK) {
 		cmd->ErrorCallback();
+		delete cmd;
+		return;
 	}
-	else {
-		cmd->Callback(0, {});
-	}
-
-	delete cmd;
-	delete req;
-}
-
-NAN_METHOD(AerospikeClient::Register)
-{
-	TYPE_CHECK_REQ(info[0], IsString, "Filename must be a string");
-	TYPE_CHECK_OPT(info[1], IsNumber, "Type must be an integer");
-	TYPE_CHECK_OPT(info[2], IsObject, "Policy must be an object");
-	TYPE_CHECK_REQ(info[3], IsFunction, "Callback must be a function");
 
-	async_invoke(info, prepare, execute, respond);
+	as_v8_debug(log, "Executing UdfRegister command: %s", *filepath);
+	async_info_send_any(cmd);
 }
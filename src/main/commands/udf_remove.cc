@@ -23,82 +23,22 @@
 
 extern "C" {
 #include <aerospike/aerospike.h>
-#include <aerospike/aerospike_udf.h>
-#include <aerospike/as_udf.h>
-#include <aerospike/as_config.h>
 }
 
 using namespace v8;
 
-class UdfRemoveCommand : public AerospikeCommand {
-  public:
-	UdfRemoveCommand(AerospikeClient *client, Local<Function> callback_)
-		: AerospikeCommand("UdfRemove", client, callback_)
-	{
-	}
-
-	~UdfRemoveCommand()
-	{
-		if (policy != NULL)
-			cf_free(policy);
-		if (module != NULL)
-			free(module);
-	}
-
-	as_policy_info *policy = NULL;
-	char *module = NULL;
-};
-
-static void *prepare(const Nan::FunctionCallbackInfo<Value> &info)
-{
-	Nan::HandleScope scope;
-	AerospikeClient *client =
-		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
-	UdfRemoveCommand *cmd =
-		new UdfRemoveCommand(client, info[2].As<Function>());
-	LogInfo *log = client->log;
-
-	cmd->module = strdup(*Nan::Utf8String(info[0].As<String>()));
-
-	if (info[1]->IsObject()) {
-		cmd->policy = (as_policy_info *)cf_malloc(sizeof(as_policy_info));
-		if (infopolicy_from_jsobject(cmd->policy, info[1].As<Object>(), log) !=
-			AS_NODE_PARAM_OK) {
-			return CmdSetError(cmd, AEROSPIKE_ERR_PARAM,
-							   "Policy parameter is invalid");
-		}
-	}
-
-	return cmd;
-}
-
-static void execute(uv_work_t *req)
+static void respond(InfoCommand *cmd)
 {
-	UdfRemoveCommand *cmd = reinterpret_cast<UdfRemoveCommand *>(req->data);
-	LogInfo *log = cmd->log;
-
-	if (!cmd->CanExecute()) {
-		return;
+	if (!cmd->IsError()) {
+		async_info_check(&cmd->err, cmd->responses[0].c_str());
 	}
 
-	as_v8_debug(log, "Executing UdfRemove command: module=%s", cmd->module);
-	aerospike_udf_remove(cmd->as, &cmd->err, cmd->policy, cmd->module);
-}
-
-static void respond(uv_work_t *req, int status)
-{
-	Nan::HandleScope scope;
-	UdfRemoveCommand *cmd = reinterpret_cast<UdfRemoveCommand *>(req->data);
-
 	if (cmd->IsError()) {
 		cmd->ErrorCallback();
 	}
 	else {
 		cmd->Callback(0, {});
 	}
-
-	delete cmd;
-	delete req;
 }
 
 NAN_METHOD(AerospikeClient::UDFRemove)
@@ -107,5 +47,26 @@ NAN_METHOD(AerospikeClient::UDFRemove)
 	TYPE_CHECK_OPT(info[1], IsObject, "Policy must be an object");
 	TYPE_CHECK_REQ(info[2], IsFunction, "Callback must be a function");
 
-	async_invoke(info, prepare, execute, respond);
+	AerospikeClient *client =
+		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
+	InfoCommand *cmd =
+		new InfoCommand("UdfRemove", client, info[2].As<Function>(), respond);
+	LogInfo *log = client->log;
+	Nan::Utf8String module(info[0].As<String>());
+
+	if (info[1]->IsObject()) {
+		if (infopolicy_from_jsobject(&cmd->policy, info[1].As<Object>(), log) !=
+			AS_NODE_PARAM_OK) {
+			CmdErrorCallback(cmd, AEROSPIKE_ERR_PARAM,
+							 "Policy parameter is invalid");
+			delete cmd;
+			return;
+		}
+		cmd->p_policy = &cmd->policy;
+	}
+
+	cmd->request = std::string("udf-remove:filename=") + *module + ";";
+
+	as_v8_debug(log, "Executing UdfRemove command: module=%s", *module);
+	async_info_send_any(cmd);
 }
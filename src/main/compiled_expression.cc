@@ -0,0 +1,271 @@
+/*******************************************************************************
+ * Copyright 2013-2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include <node.h>
+#include "compiled_expression.h"
+#include "arena.h"
+#include "expressions.h"
+#include "conversions.h"
+#include "memory_accounting.h"
+#include "log.h"
+
+extern "C" {
+#include <aerospike/as_exp.h>
+}
+
+using namespace v8;
+
+/*******************************************************************************
+ *  Borrow registry
+ *
+ *  Commands may outlive the JS object they took their filter expression from,
+ *  e.g. when the object is collected while a command is being retried. Every
+ *  compiled expression is therefore tracked here together with the number of
+ *  commands currently borrowing it; whichever of the finalizer or the last
+ *  Release() comes second frees the as_exp.
+ *
+ *  Most filter expressions are not compiled, but converted per command and
+ *  owned by it. So that releasing those does not take the registry lock, the
+ *  registry keeps a counting filter of the addresses it tracks: an expression
+ *  whose filter slot is zero is known not to be tracked.
+ ******************************************************************************/
+
+struct exp_ref {
+	uint32_t borrowed;
+	bool collected;
+};
+
+typedef std::unordered_map<const as_exp *, exp_ref> exp_refs;
+
+// Number of filter slots; a power of two.
+#define EXP_FILTER_SIZE 1024
+
+static std::mutex g_exp_refs_lock;
+static exp_refs g_exp_refs;
+static std::atomic<uint32_t> g_exp_filter[EXP_FILTER_SIZE];
+
+static inline std::atomic<uint32_t> &exp_filter_slot(const as_exp *exp)
+{
+	uintptr_t addr = (uintptr_t)exp;
+	return g_exp_filter[((addr >> 4) ^ (addr >> 14)) & (EXP_FILTER_SIZE - 1)];
+}
+
+static inline size_t exp_size(const as_exp *exp)
+{
+	return sizeof(as_exp) + exp->packed_sz;
+}
+
+// Adds exp to the registry; the caller holds g_exp_refs_lock.
+static void track_exp(as_exp *exp, exp_ref ref)
+{
+	g_exp_refs[exp] = ref;
+	exp_filter_slot(exp).fetch_add(1, std::memory_order_release);
+	memory_track_alloc(MEMORY_EXPRESSION, exp_size(exp));
+}
+
+// Removes exp from the registry and frees it; the caller holds
+// g_exp_refs_lock.
+static void destroy_exp(exp_refs::iterator it, as_exp *exp)
+{
+	g_exp_refs.erase(it);
+	exp_filter_slot(exp).fetch_sub(1, std::memory_order_release);
+	memory_track_free(MEMORY_EXPRESSION, exp_size(exp));
+	as_exp_destroy(exp);
+}
+
+/*******************************************************************************
+ *  Constructor and Destructor
+ ******************************************************************************/
+
+CompiledExpression::CompiledExpression(as_exp *exp) : exp(exp)
+{
+	std::lock_guard<std::mutex> guard(g_exp_refs_lock);
+	track_exp(exp, {0, false});
+}
+
+CompiledExpression::~CompiledExpression()
+{
+	std::lock_guard<std::mutex> guard(g_exp_refs_lock);
+	auto it = g_exp_refs.find(exp);
+	if (it == g_exp_refs.end()) {
+		return;
+	}
+	if (it->second.borrowed == 0) {
+		destroy_exp(it, exp);
+	}
+	else {
+		it->second.collected = true;
+	}
+}
+
+/**
+ *  Constructor for CompiledExpression.
+ */
+NAN_METHOD(CompiledExpression::New)
+{
+	if (!info[0]->IsArray()) {
+		return Nan::ThrowTypeError("Expression must be an array");
+	}
+
+	as_exp *exp = NULL;
+	if (compile_expression(info[0].As<Array>(), &exp, &g_log_info) !=
+			AS_NODE_PARAM_OK ||
+		exp == NULL) {
+		return Nan::ThrowTypeError("Invalid filter expression");
+	}
+
+	CompiledExpression *compiled = new CompiledExpression(exp);
+	compiled->Wrap(info.This());
+
+	info.GetReturnValue().Set(info.This());
+}
+
+/**
+ *  Returns the size of the packed expression in bytes.
+ */
+NAN_METHOD(CompiledExpression::GetSize)
+{
+	CompiledExpression *compiled =
+		Nan::ObjectWrap::Unwrap<CompiledExpression>(info.This());
+
+	info.GetReturnValue().Set(Nan::New<Number>(compiled->exp->packed_sz));
+}
+
+/**
+ *  Instantiate a new CompiledExpression.
+ */
+Local<Value> CompiledExpression::NewInstance(Local<Array> entries)
+{
+	Nan::EscapableHandleScope scope;
+	const int argc = 1;
+	Local<Value> argv[argc] = {entries};
+
+	Local<Function> cons = Nan::New<Function>(constructor());
+	Nan::TryCatch try_catch;
+	Nan::MaybeLocal<Object> instance = Nan::NewInstance(cons, argc, argv);
+	if (try_catch.HasCaught()) {
+		try_catch.ReThrow();
+		return Nan::Undefined();
+	}
+
+	return scope.Escape(instance.ToLocalChecked());
+}
+
+/**
+ *  Takes a reference to the compiled expression wrapped by obj. The caller
+ *  must hand it back via Release() (or release_expression()) instead of
+ *  destroying it.
+ */
+as_exp *CompiledExpression::Borrow(Local<Object> obj)
+{
+	CompiledExpression *compiled =
+		Nan::ObjectWrap::Unwrap<CompiledExpression>(obj);
+
+	std::lock_guard<std::mutex> guard(g_exp_refs_lock);
+	g_exp_refs[compiled->exp].borrowed++;
+	return compiled->exp;
+}
+
+/**
+ *  Hands a reference to exp over to the registry, so that it can be shared
+ *  the same way as a compiled expression. Expressions that are already
+ *  tracked keep the reference their owner has borrowed.
+ */
+void CompiledExpression::Adopt(as_exp *exp)
+{
+	std::lock_guard<std::mutex> guard(g_exp_refs_lock);
+	if (g_exp_refs.find(exp) == g_exp_refs.end()) {
+		track_exp(exp, {1, true});
+	}
+}
+
+/**
+ *  Takes an additional reference to an expression that is already tracked.
+ */
+void CompiledExpression::Retain(as_exp *exp)
+{
+	std::lock_guard<std::mutex> guard(g_exp_refs_lock);
+	auto it = g_exp_refs.find(exp);
+	if (it != g_exp_refs.end()) {
+		it->second.borrowed++;
+	}
+}
+
+/**
+ *  Drops a reference taken by Borrow(), Adopt() or Retain(). Returns false
+ *  if exp is not tracked, i.e. it is owned by the caller.
+ */
+bool CompiledExpression::Release(as_exp *exp)
+{
+	// An expression is tracked before any command can borrow it, and stays
+	// tracked until the last of them has released it.
+	if (exp_filter_slot(exp).load(std::memory_order_acquire) == 0) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> guard(g_exp_refs_lock);
+	auto it = g_exp_refs.find(exp);
+	if (it == g_exp_refs.end()) {
+		return false;
+	}
+	if (--it->second.borrowed == 0 && it->second.collected) {
+		destroy_exp(it, exp);
+	}
+	return true;
+}
+
+/**
+ *  Initialize a CompiledExpression object.
+ *  This creates a constructor function, and sets up the prototype.
+ */
+void CompiledExpression::Init()
+{
+	Local<FunctionTemplate> tpl =
+		Nan::New<FunctionTemplate>(native_entry<CompiledExpression::New>);
+
+	tpl->SetClassName(Nan::New("CompiledExpression").ToLocalChecked());
+
+	tpl->InstanceTemplate()->SetInternalFieldCount(1);
+
+	Nan::SetPrototypeMethod(tpl, "getSize", native_entry<GetSize>);
+
+	constructor().Reset(Nan::GetFunction(tpl).ToLocalChecked());
+	function_template().Reset(tpl);
+
+	node::AddEnvironmentCleanupHook(
+		Isolate::GetCurrent(),
+		[](void *) {
+			constructor().Reset();
+			function_template().Reset();
+		},
+		NULL);
+}
+
+/**
+ *  Checks whether value was created by this class's constructor, using the
+ *  brand V8 stamps on every instance of the function template.
+ */
+bool CompiledExpression::HasInstance(Local<Value> value)
+{
+	if (function_template().IsEmpty()) {
+		return false;
+	}
+	return Nan::New(function_template())->HasInstance(value);
+}
@@ -20,6 +20,7 @@
 #include "policy.h"
 #include "config.h"
 #include "conversions.h"
+#include "expressions.h"
 
 extern "C" {
 #include <aerospike/as_config.h>
@@ -59,6 +60,9 @@ int config_from_jsobject(as_config *config, Local<Object> configObj,
 	Local<Value> v8_sharedMemory =
 		Nan::Get(configObj, Nan::New("sharedMemory").ToLocalChecked())
 			.ToLocalChecked();
+	Local<Value> v8_pipeline =
+		Nan::Get(configObj, Nan::New("pipeline").ToLocalChecked())
+			.ToLocalChecked();
 
 
 	if (v8_config_provider->IsObject()) {
@@ -396,6 +400,25 @@ int config_from_jsobject(as_config *config, Local<Object> configObj,
 			}
 		}
 
+		// The C client destroys the filter expressions of the default
+		// policies itself, so they must not borrow compiled expressions.
+		as_policy_base *bases[] = {&policies->apply.base,
+								   &policies->batch.base,
+								   &policies->batch_parent_write.base,
+								   &policies->txn_roll.base,
+								   &policies->txn_verify.base,
+								   &policies->operate.base,
+								   &policies->read.base,
+								   &policies->remove.base,
+								   &policies->scan.base,
+								   &policies->query.base,
+								   &policies->write.base};
+		for (as_policy_base *base : bases) {
+			base->filter_exp = own_expression(base->filter_exp);
+		}
+		policies->batch_write.filter_exp =
+			own_expression(policies->batch_write.filter_exp);
+
 		as_v8_debug(log, "Parsing global policies: success");
 	}
 
@@ -495,6 +518,14 @@ int config_from_jsobject(as_config *config, Local<Object> configObj,
 										   log)) != AS_NODE_PARAM_OK) {
 		goto Cleanup;
 	}
+	if (v8_pipeline->IsObject()) {
+		if ((rc = get_optional_uint32_property(
+				 &config->pipe_max_conns_per_node, NULL,
+				 v8_pipeline.As<Object>(), "maxConnsPerNode", log)) !=
+			AS_NODE_PARAM_OK) {
+			goto Cleanup;
+		}
+	}
 	if ((rc = get_optional_uint32_property(&config->max_error_rate,
 										   &defined, configObj, "maxErrorRate",
 										   log)) != AS_NODE_PARAM_OK) {
@@ -568,3 +599,69 @@ Cleanup:
 	as_v8_debug(log, "Built as_config instance from JS config object");
 	return rc;
 }
+
+int pipeline_from_jsobject(PipelineState *pipeline, Local<Object> configObj,
+						   const LogInfo *log)
+{
+	int rc = AS_NODE_PARAM_OK;
+	Local<Value> v8_pipeline =
+		Nan::Get(configObj, Nan::New("pipeline").ToLocalChecked())
+			.ToLocalChecked();
+	if (!v8_pipeline->IsObject()) {
+		return rc;
+	}
+
+	Local<Object> obj = v8_pipeline.As<Object>();
+	pipeline->enabled = true;
+	if ((rc = get_optional_bool_property(&pipeline->enabled, NULL, obj,
+										 "enabled", log)) != AS_NODE_PARAM_OK) {
+		return rc;
+	}
+	if ((rc = get_optional_uint32_property(&pipeline->max_depth, NULL, obj,
+										   "maxDepth", log)) !=
+		AS_NODE_PARAM_OK) {
+		return rc;
+	}
+
+	as_v8_debug(log, "Pipelining %s (max. depth per node: %u)",
+				pipeline->enabled ? "enabled" : "disabled",
+				pipeline->max_depth);
+	return rc;
+}
+
+int record_cache_from_jsobject(std::shared_ptr<RecordCache> *cache,
+							   Local<Object> configObj, const LogInfo *log)
+{
+	int rc = AS_NODE_PARAM_OK;
+	Local<Value> v8_cache =
+		Nan::Get(configObj, Nan::New("readCache").ToLocalChecked())
+			.ToLocalChecked();
+	if (!v8_cache->IsObject()) {
+		return rc;
+	}
+
+	Local<Object> obj = v8_cache.As<Object>();
+	uint64_t max_memory = RECORD_CACHE_DEFAULT_MAX_MEMORY;
+	uint32_t max_staleness = RECORD_CACHE_DEFAULT_MAX_STALENESS;
+	uint32_t shards = RECORD_CACHE_DEFAULT_SHARDS;
+	if ((rc = get_optional_uint64_property(&max_memory, NULL, obj, "maxMemory",
+										   log)) != AS_NODE_PARAM_OK) {
+		return rc;
+	}
+	if ((rc = get_optional_uint32_property(&max_staleness, NULL, obj,
+										   "maxStaleness", log)) !=
+		AS_NODE_PARAM_OK) {
+		return rc;
+	}
+	if ((rc = get_optional_uint32_property(&shards, NULL, obj, "shards",
+										   log)) != AS_NODE_PARAM_OK) {
+		return rc;
+	}
+
+	*cache = std::make_shared<RecordCache>(max_memory, max_staleness, shards);
+	as_v8_debug(log,
+				"Record cache enabled (max. memory: %llu bytes, max. "
+				"staleness: %u ms, shards: %u)",
+				(unsigned long long)max_memory, max_staleness, shards);
+	return rc;
+}
@@ -130,7 +130,7 @@ void events_callback_init(as_config *config, Local<Function> callback,
 {
 	Nan::HandleScope scope;
 	uv_async_t *handle = (uv_async_t *)cf_malloc(sizeof(uv_async_t));
-	uv_async_init(uv_default_loop(), handle, cluster_event_async);
+	uv_async_init(Nan::GetCurrentEventLoop(), handle, cluster_event_async);
 	handle->data = new EventQueue(callback, log);
 	config->event_callback_udata = (void *)handle;
 	config->event_callback = cluster_event_callback;
@@ -14,13 +14,16 @@
  * limitations under the License.
  ******************************************************************************/
 
+#include <cstring>
 #include <node.h>
 #include <nan.h>
 
 #include "log.h"
 #include "conversions.h"
+#include "compiled_expression.h"
 #include "expressions.h"
 #include "operations.h"
+#include "property_names.h"
 
 extern "C" {
 #include <aerospike/as_exp.h>
@@ -38,63 +41,54 @@ int free_entries(Local<Array> entries_ary, as_exp_entry *entries,
 		Local<Object> entry_obj =
 			Nan::Get(entries_ary, i).ToLocalChecked().As<Object>();
 
-		if (Nan::Has(entry_obj, Nan::New("value").ToLocalChecked())
-				.FromJust()) {
+		if (Nan::Has(entry_obj, AS_V8_NAME(value)).FromJust()) {
 			// it is freed by c-client in case of geojson exp but for other cases it may leak
 			// if (entry->v.val) as_val_destroy(entry->v.val);
 			continue;
 		}
 
-		if (Nan::Has(entry_obj, Nan::New("strVal").ToLocalChecked())
-				.FromJust()) {
+		if (Nan::Has(entry_obj, AS_V8_NAME(strVal)).FromJust()) {
 			if (entry->v.str_val)
 				free((void *)entry->v.str_val);
 			continue;
 		}
 
-		if (Nan::Has(entry_obj, Nan::New("bytesVal").ToLocalChecked())
-				.FromJust()) {
+		if (Nan::Has(entry_obj, AS_V8_NAME(bytesVal)).FromJust()) {
 			if (entry->v.str_val)
 				cf_free((void *)entry->v.bytes_val);
 			continue;
 		}
 
-		if (Nan::Has(entry_obj, Nan::New("intVal").ToLocalChecked())
-				.FromJust()) {
+		if (Nan::Has(entry_obj, AS_V8_NAME(intVal)).FromJust()) {
 			continue;
 		}
 
-		if (Nan::Has(entry_obj, Nan::New("uintVal").ToLocalChecked())
-				.FromJust()) {
+		if (Nan::Has(entry_obj, AS_V8_NAME(uintVal)).FromJust()) {
 			continue;
 		}
 
-		if (Nan::Has(entry_obj, Nan::New("floatVal").ToLocalChecked())
-				.FromJust()) {
+		if (Nan::Has(entry_obj, AS_V8_NAME(floatVal)).FromJust()) {
 			continue;
 		}
 
-		if (Nan::Has(entry_obj, Nan::New("boolVal").ToLocalChecked())
-				.FromJust()) {
+		if (Nan::Has(entry_obj, AS_V8_NAME(boolVal)).FromJust()) {
 			continue;
 		}
 
-		if (Nan::Has(entry_obj, Nan::New("ctx").ToLocalChecked()).FromJust()) {
+		if (Nan::Has(entry_obj, AS_V8_NAME(ctx)).FromJust()) {
 			if (entry->v.ctx)
 				as_cdt_ctx_destroy(entry->v.ctx);
 			continue;
 		}
 
-		if (Nan::Has(entry_obj, Nan::New("listPolicy").ToLocalChecked())
-				.FromJust()) {
+		if (Nan::Has(entry_obj, AS_V8_NAME(listPolicy)).FromJust()) {
 			if (entry->v.list_pol) {
 				cf_free(entry->v.list_pol);
 			}
 			continue;
 		}
 
-		if (Nan::Has(entry_obj, Nan::New("mapPolicy").ToLocalChecked())
-				.FromJust()) {
+		if (Nan::Has(entry_obj, AS_V8_NAME(mapPolicy)).FromJust()) {
 			if (entry->v.map_pol) {
 				cf_free(entry->v.map_pol);
 			}
@@ -111,73 +105,76 @@ int convert_entry(Local<Object> entry_obj, as_exp_entry *entry,
 {
 	int rc = AS_NODE_PARAM_OK;
 
-	if ((rc = get_int_property((int *)&entry->op, entry_obj, "op", log)) !=
-		AS_NODE_PARAM_OK) {
+	if ((rc = get_int_property((int *)&entry->op, entry_obj, AS_V8_NAME(op),
+							   log)) != AS_NODE_PARAM_OK) {
 		return rc;
 	}
 
 	if ((rc = get_optional_uint32_property(&entry->count, NULL, entry_obj,
-										   "count", log)) != AS_NODE_PARAM_OK) {
+										   AS_V8_NAME(count), log)) !=
+		AS_NODE_PARAM_OK) {
 		return rc;
 	}
 
-	if ((rc = get_optional_uint32_property(&entry->sz, NULL, entry_obj, "sz",
-										   log)) != AS_NODE_PARAM_OK) {
+	if ((rc = get_optional_uint32_property(&entry->sz, NULL, entry_obj,
+										   AS_V8_NAME(sz), log)) !=
+		AS_NODE_PARAM_OK) {
 		return rc;
 	}
 
-	if (Nan::Has(entry_obj, Nan::New("value").ToLocalChecked()).FromJust()) {
+	if (Nan::Has(entry_obj, AS_V8_NAME(value)).FromJust()) {
 		entry->v.val = NULL;
-		rc = get_asval_property(&entry->v.val, entry_obj, "value", log);
+		rc = get_asval_property(&entry->v.val, entry_obj, AS_V8_NAME(value),
+								log);
 		return rc;
 	}
 
-	if (Nan::Has(entry_obj, Nan::New("strVal").ToLocalChecked()).FromJust()) {
+	if (Nan::Has(entry_obj, AS_V8_NAME(strVal)).FromJust()) {
 		entry->v.str_val = NULL;
 		rc = get_string_property((char **)&entry->v.str_val, entry_obj,
-								 "strVal", log);
+								 AS_V8_NAME(strVal), log);
 		return rc;
 	}
 
-	if (Nan::Has(entry_obj, Nan::New("bytesVal").ToLocalChecked()).FromJust()) {
+	if (Nan::Has(entry_obj, AS_V8_NAME(bytesVal)).FromJust()) {
 		entry->v.bytes_val = NULL;
 		entry->sz = 0;
 		rc = get_bytes_property(&entry->v.bytes_val, (int *)&entry->sz,
-								entry_obj, "bytesVal", log);
+								entry_obj, AS_V8_NAME(bytesVal), log);
 		return rc;
 	}
 
-	if (Nan::Has(entry_obj, Nan::New("intVal").ToLocalChecked()).FromJust()) {
-		rc = get_int64_property(&entry->v.int_val, entry_obj, "intVal", log);
+	if (Nan::Has(entry_obj, AS_V8_NAME(intVal)).FromJust()) {
+		rc = get_int64_property(&entry->v.int_val, entry_obj,
+								AS_V8_NAME(intVal), log);
 		return rc;
 	}
 
-	if (Nan::Has(entry_obj, Nan::New("uintVal").ToLocalChecked()).FromJust()) {
-		return get_uint64_property(&entry->v.uint_val, entry_obj, "uintVal",
-								   log);
+	if (Nan::Has(entry_obj, AS_V8_NAME(uintVal)).FromJust()) {
+		return get_uint64_property(&entry->v.uint_val, entry_obj,
+								   AS_V8_NAME(uintVal), log);
 	}
 
-	if (Nan::Has(entry_obj, Nan::New("floatVal").ToLocalChecked()).FromJust()) {
-		return get_float_property(&entry->v.float_val, entry_obj, "floatVal",
-								  log);
+	if (Nan::Has(entry_obj, AS_V8_NAME(floatVal)).FromJust()) {
+		return get_float_property(&entry->v.float_val, entry_obj,
+								  AS_V8_NAME(floatVal), log);
 	}
 
-	if (Nan::Has(entry_obj, Nan::New("boolVal").ToLocalChecked()).FromJust()) {
-		return get_bool_property(&entry->v.bool_val, entry_obj, "boolVal", log);
+	if (Nan::Has(entry_obj, AS_V8_NAME(boolVal)).FromJust()) {
+		return get_bool_property(&entry->v.bool_val, entry_obj,
+								 AS_V8_NAME(boolVal), log);
 	}
 
-	if (Nan::Has(entry_obj, Nan::New("ctx").ToLocalChecked()).FromJust()) {
+	if (Nan::Has(entry_obj, AS_V8_NAME(ctx)).FromJust()) {
 		entry->v.ctx =
 			get_optional_cdt_context_heap(&rc, entry_obj, "ctx", log);
 		return rc;
 	}
 
-	if (Nan::Has(entry_obj, Nan::New("listPolicy").ToLocalChecked())
-			.FromJust()) {
+	if (Nan::Has(entry_obj, AS_V8_NAME(listPolicy)).FromJust()) {
 		entry->v.list_pol = NULL;
 		Local<Value> policy_obj =
-			Nan::Get(entry_obj, Nan::New("listPolicy").ToLocalChecked())
-				.ToLocalChecked();
+			Nan::Get(entry_obj, AS_V8_NAME(listPolicy)).ToLocalChecked();
 		if (policy_obj->IsObject()) {
 			entry->v.list_pol =
 				(as_list_policy *)cf_malloc(sizeof(as_list_policy));
@@ -187,12 +184,10 @@ int convert_entry(Local<Object> entry_obj, as_exp_entry *entry,
 		return AS_NODE_PARAM_OK;
 	}
 
-	if (Nan::Has(entry_obj, Nan::New("mapPolicy").ToLocalChecked())
-			.FromJust()) {
+	if (Nan::Has(entry_obj, AS_V8_NAME(mapPolicy)).FromJust()) {
 		entry->v.map_pol = NULL;
 		Local<Value> policy_obj =
-			Nan::Get(entry_obj, Nan::New("mapPolicy").ToLocalChecked())
-				.ToLocalChecked();
+			Nan::Get(entry_obj, AS_V8_NAME(mapPolicy)).ToLocalChecked();
 		if (policy_obj->IsObject()) {
 			entry->v.map_pol =
 				(as_map_policy *)cf_malloc(sizeof(as_map_policy));
@@ -201,12 +196,12 @@ int convert_entry(Local<Object> entry_obj, as_exp_entry *entry,
 		return AS_NODE_PARAM_OK;
 	}
 
-	if (Nan::Has(entry_obj, Nan::New("inf").ToLocalChecked()).FromJust()) {
+	if (Nan::Has(entry_obj, AS_V8_NAME(inf)).FromJust()) {
 		entry->v.val = NULL;
 		get_inf_property(&entry->v.val, log);
 	}
 
-	if (Nan::Has(entry_obj, Nan::New("wildcard").ToLocalChecked()).FromJust()) {
+	if (Nan::Has(entry_obj, AS_V8_NAME(wildcard)).FromJust()) {
 		entry->v.val = NULL;
 		get_wildcard_property(&entry->v.val, log);
 	}
@@ -240,3 +235,55 @@ done:
 	free_entries(entries_ary, entries, log);
 	return rc;
 }
+
+/**
+ *  Converts the filterExpression value of a policy, which is either an
+ *  uncompiled expression array or a CompiledExpression returned by
+ *  exp.compile(). A compiled expression is borrowed rather than copied; the
+ *  result must be passed to release_expression() instead of as_exp_destroy().
+ */
+int filter_expression_from_jsvalue(as_exp **filter_exp, Local<Value> value,
+								   const LogInfo *log)
+{
+	if (value->IsArray()) {
+		return compile_expression(value.As<Array>(), filter_exp, log);
+	}
+	if (is_compiled_expression_value(value)) {
+		*filter_exp = CompiledExpression::Borrow(value.As<Object>());
+		as_v8_debug(log, "Using compiled expression (size=%u)",
+					(*filter_exp)->packed_sz);
+		return AS_NODE_PARAM_OK;
+	}
+	if (value->IsNull() || value->IsUndefined()) {
+		return AS_NODE_PARAM_OK;
+	}
+	as_v8_error(log, "Invalid filter expression value");
+	return AS_NODE_PARAM_ERR;
+}
+
+/**
+ *  Returns an expression the caller owns outright: borrowed compiled
+ *  expressions are copied and released, others are returned as-is. Used
+ *  where the C client frees the expression itself, e.g. default policies.
+ */
+as_exp *own_expression(as_exp *exp)
+{
+	if (exp == NULL) {
+		return NULL;
+	}
+	size_t size = sizeof(as_exp) + exp->packed_sz;
+	as_exp *copy = (as_exp *)cf_malloc(size);
+	memcpy(copy, exp, size);
+	if (CompiledExpression::Release(exp)) {
+		return copy;
+	}
+	cf_free(copy);
+	return exp;
+}
+
+void release_expression(as_exp *exp)
+{
+	if (exp && !CompiledExpression::Release(exp)) {
+		as_exp_destroy(exp);
+	}
+}
@@ -0,0 +1,293 @@
+/*******************************************************************************
+ * Copyright 2013-2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <cstring>
+#include <node.h>
+#include "frozen_policy.h"
+#include "arena.h"
+#include "compiled_expression.h"
+#include "conversions.h"
+#include "expressions.h"
+#include "policy.h"
+#include "log.h"
+
+extern "C" {
+#include <aerospike/as_policy.h>
+}
+
+using namespace v8;
+
+/*******************************************************************************
+ *  Constructor and Destructor
+ ******************************************************************************/
+
+FrozenPolicy::FrozenPolicy() : filter_exp(NULL)
+{
+	memset(&policy, 0, sizeof(policy));
+}
+
+/**
+ *  The filter expression is shared with every command that copied this
+ *  policy; it is freed once the last of them has released it.
+ */
+FrozenPolicy::~FrozenPolicy()
+{
+	release_expression(filter_exp);
+}
+
+/**
+ *  Constructor for FrozenPolicy.
+ */
+NAN_METHOD(FrozenPolicy::New)
+{
+	if (!info[0]->IsString()) {
+		return Nan::ThrowTypeError("Policy type must be a string");
+	}
+	if (!info[1]->IsObject()) {
+		return Nan::ThrowTypeError("Policy must be an object");
+	}
+
+	Nan::Utf8String type(info[0]);
+	Local<Object> obj = info[1].As<Object>();
+	const LogInfo *log = &g_log_info;
+	FrozenPolicy *frozen = new FrozenPolicy();
+	as_policy_base *base = NULL;
+	int rc = AS_NODE_PARAM_ERR;
+
+	if (strcmp(*type, "read") == 0) {
+		frozen->type = READ;
+		rc = readpolicy_from_jsobject(&frozen->policy.read, obj, log);
+		base = &frozen->policy.read.base;
+	}
+	else if (strcmp(*type, "write") == 0) {
+		frozen->type = WRITE;
+		rc = writepolicy_from_jsobject(&frozen->policy.write, obj, log);
+		base = &frozen->policy.write.base;
+	}
+	else if (strcmp(*type, "apply") == 0) {
+		frozen->type = APPLY;
+		rc = applypolicy_from_jsobject(&frozen->policy.apply, obj, log);
+		base = &frozen->policy.apply.base;
+	}
+	else if (strcmp(*type, "operate") == 0) {
+		frozen->type = OPERATE;
+		rc = operatepolicy_from_jsobject(&frozen->policy.operate, obj, log);
+		base = &frozen->policy.operate.base;
+	}
+	else if (strcmp(*type, "remove") == 0) {
+		frozen->type = REMOVE;
+		rc = removepolicy_from_jsobject(&frozen->policy.remove, obj, log);
+		base = &frozen->policy.remove.base;
+	}
+	else if (strcmp(*type, "batch") == 0) {
+		frozen->type = BATCH;
+		rc = batchpolicy_from_jsobject(&frozen->policy.batch, obj, log);
+		base = &frozen->policy.batch.base;
+	}
+	else if (strcmp(*type, "batchRead") == 0) {
+		frozen->type = BATCH_READ;
+		rc = batchread_policy_from_jsobject(&frozen->policy.batch_read, obj,
+											log);
+		frozen->filter_exp = frozen->policy.batch_read.filter_exp;
+	}
+	else if (strcmp(*type, "batchWrite") == 0) {
+		frozen->type = BATCH_WRITE;
+		rc = batchwrite_policy_from_jsobject(&frozen->policy.batch_write, obj,
+											 log);
+		frozen->filter_exp = frozen->policy.batch_write.filter_exp;
+	}
+	else if (strcmp(*type, "batchApply") == 0) {
+		frozen->type = BATCH_APPLY;
+		rc = batchapply_policy_from_jsobject(&frozen->policy.batch_apply, obj,
+											 log);
+		frozen->filter_exp = frozen->policy.batch_apply.filter_exp;
+	}
+	else if (strcmp(*type, "batchRemove") == 0) {
+		frozen->type = BATCH_REMOVE;
+		rc = batchremove_policy_from_jsobject(&frozen->policy.batch_remove,
+											  obj, log);
+		frozen->filter_exp = frozen->policy.batch_remove.filter_exp;
+	}
+	else {
+		delete frozen;
+		return Nan::ThrowTypeError("Unknown policy type");
+	}
+
+	if (base) {
+		frozen->filter_exp = base->filter_exp;
+	}
+
+	if (rc != AS_NODE_PARAM_OK) {
+		delete frozen;
+		return Nan::ThrowTypeError("Invalid policy");
+	}
+
+	if (base && base->txn) {
+		delete frozen;
+		return Nan::ThrowTypeError(
+			"Policies with a transaction cannot be frozen");
+	}
+
+	if (frozen->filter_exp) {
+		CompiledExpression::Adopt(frozen->filter_exp);
+	}
+
+	frozen->Wrap(info.This());
+
+	info.GetReturnValue().Set(info.This());
+}
+
+/**
+ *  Instantiate a new FrozenPolicy.
+ */
+Local<Value> FrozenPolicy::NewInstance(Local<String> type,
+									   Local<Object> policy)
+{
+	Nan::EscapableHandleScope scope;
+	const int argc = 2;
+	Local<Value> argv[argc] = {type, policy};
+
+	Local<Function> cons = Nan::New<Function>(constructor());
+	Nan::TryCatch try_catch;
+	Nan::MaybeLocal<Object> instance = Nan::NewInstance(cons, argc, argv);
+	if (try_catch.HasCaught()) {
+		try_catch.ReThrow();
+		return Nan::Undefined();
+	}
+
+	return scope.Escape(instance.ToLocalChecked());
+}
+
+/**
+ *  Copies the frozen policy wrapped by obj into policy. The copy shares the
+ *  frozen policy's filter expression, which the command releases as usual.
+ */
+int FrozenPolicy::CopyTo(void *policy, size_t size, Type type,
+						 Local<Object> obj, const LogInfo *log)
+{
+	FrozenPolicy *frozen = Nan::ObjectWrap::Unwrap<FrozenPolicy>(obj);
+
+	if (frozen->type != type) {
+		as_v8_error(log, "Frozen policy type does not match command (%d != %d)",
+					frozen->type, type);
+		return AS_NODE_PARAM_ERR;
+	}
+
+	memcpy(policy, &frozen->policy, size);
+	if (frozen->filter_exp) {
+		CompiledExpression::Retain(frozen->filter_exp);
+	}
+
+	as_v8_detail(log, "Copied frozen policy (type=%d)", type);
+	return AS_NODE_PARAM_OK;
+}
+
+int FrozenPolicy::Copy(as_policy_read *policy, Local<Object> obj,
+					   const LogInfo *log)
+{
+	return CopyTo(policy, sizeof(*policy), READ, obj, log);
+}
+
+int FrozenPolicy::Copy(as_policy_write *policy, Local<Object> obj,
+					   const LogInfo *log)
+{
+	return CopyTo(policy, sizeof(*policy), WRITE, obj, log);
+}
+
+int FrozenPolicy::Copy(as_policy_apply *policy, Local<Object> obj,
+					   const LogInfo *log)
+{
+	return CopyTo(policy, sizeof(*policy), APPLY, obj, log);
+}
+
+int FrozenPolicy::Copy(as_policy_operate *policy, Local<Object> obj,
+					   const LogInfo *log)
+{
+	return CopyTo(policy, sizeof(*policy), OPERATE, obj, log);
+}
+
+int FrozenPolicy::Copy(as_policy_remove *policy, Local<Object> obj,
+					   const LogInfo *log)
+{
+	return CopyTo(policy, sizeof(*policy), REMOVE, obj, log);
+}
+
+int FrozenPolicy::Copy(as_policy_batch *policy, Local<Object> obj,
+					   const LogInfo *log)
+{
+	return CopyTo(policy, sizeof(*policy), BATCH, obj, log);
+}
+
+int FrozenPolicy::Copy(as_policy_batch_read *policy, Local<Object> obj,
+					   const LogInfo *log)
+{
+	return CopyTo(policy, sizeof(*policy), BATCH_READ, obj, log);
+}
+
+int FrozenPolicy::Copy(as_policy_batch_write *policy, Local<Object> obj,
+					   const LogInfo *log)
+{
+	return CopyTo(policy, sizeof(*policy), BATCH_WRITE, obj, log);
+}
+
+int FrozenPolicy::Copy(as_policy_batch_apply *policy, Local<Object> obj,
+					   const LogInfo *log)
+{
+	return CopyTo(policy, sizeof(*policy), BATCH_APPLY, obj, log);
+}
+
+int FrozenPolicy::Copy(as_policy_batch_remove *policy, Local<Object> obj,
+					   const LogInfo *log)
+{
+	return CopyTo(policy, sizeof(*policy), BATCH_REMOVE, obj, log);
+}
+
+/**
+ *  Initialize a FrozenPolicy object.
+ *  This creates a constructor function, and sets up the prototype.
+ */
+void FrozenPolicy::Init()
+{
+	Local<FunctionTemplate> tpl =
+		Nan::New<FunctionTemplate>(native_entry<FrozenPolicy::New>);
+
+	tpl->SetClassName(Nan::New("FrozenPolicy").ToLocalChecked());
+
+	tpl->InstanceTemplate()->SetInternalFieldCount(1);
+
+	constructor().Reset(Nan::GetFunction(tpl).ToLocalChecked());
+	function_template().Reset(tpl);
+
+	node::AddEnvironmentCleanupHook(
+		Isolate::GetCurrent(),
+		[](void *) {
+			constructor().Reset();
+			function_template().Reset();
+		},
+		NULL);
+}
+
+/**
+ *  Checks whether value was created by this class's constructor, using the
+ *  brand V8 stamps on every instance of the function template.
+ */
+bool FrozenPolicy::HasInstance(Local<Value> value)
+{
+	if (function_template().IsEmpty()) {
+		return false;
+	}
+	return Nan::New(function_template())->HasInstance(value);
+}
@@ -20,6 +20,8 @@
 #include "policy.h"
 #include "conversions.h"
 #include "expressions.h"
+#include "frozen_policy.h"
+#include "property_names.h"
 
 extern "C" {
 #include <aerospike/as_policy.h>
@@ -61,47 +63,36 @@ int basepolicy_from_jsobject(as_policy_base *policy, Local<Object> obj,
 {
 	int rc = 0;
 	if ((rc = get_optional_uint32_property(&policy->socket_timeout, NULL, obj,
-										   "socketTimeout", log)) !=
+										   AS_V8_NAME(socketTimeout), log)) !=
 		AS_NODE_PARAM_OK) {
 		return rc;
 	}
 	if ((rc = get_optional_uint32_property(&policy->total_timeout, NULL, obj,
-										   "totalTimeout", log)) !=
+										   AS_V8_NAME(totalTimeout), log)) !=
 		AS_NODE_PARAM_OK) {
 		return rc;
 	}
 	if ((rc = get_optional_uint32_property(&policy->max_retries, NULL, obj,
-										   "maxRetries", log)) !=
+										   AS_V8_NAME(maxRetries), log)) !=
 		AS_NODE_PARAM_OK) {
 		return rc;
 	}
 	
 	Local<Value> exp_val =
-		Nan::Get(obj, Nan::New("filterExpression").ToLocalChecked())
-			.ToLocalChecked();
-	if (exp_val->IsArray()) {
-		Local<Array> exp_ary = Local<Array>::Cast(exp_val);
-		if ((rc = compile_expression(exp_ary, &policy->filter_exp, log)) !=
-			AS_NODE_PARAM_OK) {
-			return rc;
-		}
-	}
-	else if (exp_val->IsNull() || exp_val->IsUndefined()) {
-		// no-op
-	}
-	else {
-		as_v8_error(log, "Invalid filter expression value");
-		return AS_NODE_PARAM_ERR;
+		Nan::Get(obj, AS_V8_NAME(filterExpression)).ToLocalChecked();
+	if ((rc = filter_expression_from_jsvalue(&policy->filter_exp, exp_val,
+											 log)) != AS_NODE_PARAM_OK) {
+		return rc;
 	}
 
 	if ((rc = get_optional_bool_property(&policy->compress, NULL, obj,
-										 "compress", log)) !=
+										 AS_V8_NAME(compress), log)) !=
 		AS_NODE_PARAM_OK) {
 		return rc;
 	}
 
 	if ((rc = get_optional_transaction_property(&policy->txn, NULL, obj,
-										 "txn", log)) !=
+										 AS_V8_NAME(txn), log)) !=
 		AS_NODE_PARAM_OK) {
 		return rc;
 	}
@@ -112,6 +103,10 @@ int basepolicy_from_jsobject(as_policy_base *policy, Local<Object> obj,
 int readpolicy_from_jsobject(as_policy_read *policy, Local<Object> obj,
 							 const LogInfo *log)
 {
+	if (is_frozen_policy_value(obj)) {
+		return FrozenPolicy::Copy(policy, obj, log);
+	}
+
 	int rc = 0;
 	as_policy_read_init(policy);
 	if ((rc = basepolicy_from_jsobject(&policy->base, obj, log)) !=
@@ -154,6 +149,10 @@ int readpolicy_from_jsobject(as_policy_read *policy, Local<Object> obj,
 int writepolicy_from_jsobject(as_policy_write *policy, Local<Object> obj,
 							  const LogInfo *log)
 {
+	if (is_frozen_policy_value(obj)) {
+		return FrozenPolicy::Copy(policy, obj, log);
+	}
+
 	int rc = 0;
 	as_policy_write_init(policy);
 	if ((rc = basepolicy_from_jsobject(&policy->base, obj, log)) !=
@@ -205,6 +204,10 @@ int writepolicy_from_jsobject(as_policy_write *policy, Local<Object> obj,
 int applypolicy_from_jsobject(as_policy_apply *policy, Local<Object> obj,
 							  const LogInfo *log)
 {
+	if (is_frozen_policy_value(obj)) {
+		return FrozenPolicy::Copy(policy, obj, log);
+	}
+
 	int rc = 0;
 	as_policy_apply_init(policy);
 	if ((rc = basepolicy_from_jsobject(&policy->base, obj, log)) !=
@@ -246,6 +249,10 @@ int applypolicy_from_jsobject(as_policy_apply *policy, Local<Object> obj,
 int operatepolicy_from_jsobject(as_policy_operate *policy, Local<Object> obj,
 								const LogInfo *log)
 {
+	if (is_frozen_policy_value(obj)) {
+		return FrozenPolicy::Copy(policy, obj, log);
+	}
+
 	int rc = 0;
 	as_policy_operate_init(policy);
 	if ((rc = basepolicy_from_jsobject(&policy->base, obj, log)) !=
@@ -307,6 +314,10 @@ int operatepolicy_from_jsobject(as_policy_operate *policy, Local<Object> obj,
 int removepolicy_from_jsobject(as_policy_remove *policy, Local<Object> obj,
 							   const LogInfo *log)
 {
+	if (is_frozen_policy_value(obj)) {
+		return FrozenPolicy::Copy(policy, obj, log);
+	}
+
 	int rc = 0;
 	as_policy_remove_init(policy);
 	if ((rc = basepolicy_from_jsobject(&policy->base, obj, log)) !=
@@ -348,6 +359,10 @@ int removepolicy_from_jsobject(as_policy_remove *policy, Local<Object> obj,
 int batchpolicy_from_jsobject(as_policy_batch *policy, Local<Object> obj,
 							  const LogInfo *log)
 {
+	if (is_frozen_policy_value(obj)) {
+		return FrozenPolicy::Copy(policy, obj, log);
+	}
+
 	int rc = 0;
 	as_policy_batch_init(policy);
 	if ((rc = basepolicy_from_jsobject(&policy->base, obj, log)) !=
@@ -412,19 +427,19 @@ int batchread_policy_from_jsobject(as_policy_batch_read *policy,
 								   v8::Local<v8::Object> obj,
 								   const LogInfo *log)
 {
+	if (is_frozen_policy_value(obj)) {
+		return FrozenPolicy::Copy(policy, obj, log);
+	}
+
 	int rc = 0;
 
 	as_policy_batch_read_init(policy);
 
 	Local<Value> exp_val =
-		Nan::Get(obj, Nan::New("filterExpression").ToLocalChecked())
-			.ToLocalChecked();
-	if (exp_val->IsArray()) {
-		Local<Array> exp_ary = Local<Array>::Cast(exp_val);
-		if (compile_expression(exp_ary, &policy->filter_exp, log) !=
-			AS_NODE_PARAM_OK) {
-			return AS_NODE_PARAM_ERR;
-		}
+		Nan::Get(obj, AS_V8_NAME(filterExpression)).ToLocalChecked();
+	if (filter_expression_from_jsvalue(&policy->filter_exp, exp_val, log) !=
+		AS_NODE_PARAM_OK) {
+		return AS_NODE_PARAM_ERR;
 	}
 
 	if ((rc = get_optional_uint32_property((uint32_t *)&policy->read_mode_ap,
@@ -449,19 +464,19 @@ int batchwrite_policy_from_jsobject(as_policy_batch_write *policy,
 									v8::Local<v8::Object> obj,
 									const LogInfo *log)
 {
+	if (is_frozen_policy_value(obj)) {
+		return FrozenPolicy::Copy(policy, obj, log);
+	}
+
 	int rc = 0;
 
 	as_policy_batch_write_init(policy);
 
 	Local<Value> exp_val =
-		Nan::Get(obj, Nan::New("filterExpression").ToLocalChecked())
-			.ToLocalChecked();
-	if (exp_val->IsArray()) {
-		Local<Array> exp_ary = Local<Array>::Cast(exp_val);
-		if (compile_expression(exp_ary, &policy->filter_exp, log) !=
-			AS_NODE_PARAM_OK) {
-			return AS_NODE_PARAM_ERR;
-		}
+		Nan::Get(obj, AS_V8_NAME(filterExpression)).ToLocalChecked();
+	if (filter_expression_from_jsvalue(&policy->filter_exp, exp_val, log) !=
+		AS_NODE_PARAM_OK) {
+		return AS_NODE_PARAM_ERR;
 	}
 	if ((rc = get_optional_uint32_property((uint32_t *)&policy->key, NULL, obj,
 										   "key", log)) != AS_NODE_PARAM_OK) {
@@ -508,19 +523,19 @@ int batchapply_policy_from_jsobject(as_policy_batch_apply *policy,
 									v8::Local<v8::Object> obj,
 									const LogInfo *log)
 {
+	if (is_frozen_policy_value(obj)) {
+		return FrozenPolicy::Copy(policy, obj, log);
+	}
+
 	int rc = 0;
 
 	as_policy_batch_apply_init(policy);
 
 	Local<Value> exp_val =
-		Nan::Get(obj, Nan::New("filterExpression").ToLocalChecked())
-			.ToLocalChecked();
-	if (exp_val->IsArray()) {
-		Local<Array> exp_ary = Local<Array>::Cast(exp_val);
-		if (compile_expression(exp_ary, &policy->filter_exp, log) !=
-			AS_NODE_PARAM_OK) {
-			return AS_NODE_PARAM_ERR;
-		}
+		Nan::Get(obj, AS_V8_NAME(filterExpression)).ToLocalChecked();
+	if (filter_expression_from_jsvalue(&policy->filter_exp, exp_val, log) !=
+		AS_NODE_PARAM_OK) {
+		return AS_NODE_PARAM_ERR;
 	}
 	if ((rc = get_optional_uint32_property((uint32_t *)&policy->key, NULL, obj,
 										   "key", log)) != AS_NODE_PARAM_OK) {
@@ -553,19 +568,19 @@ int batchremove_policy_from_jsobject(as_policy_batch_remove *policy,
 									 v8::Local<v8::Object> obj,
 									 const LogInfo *log)
 {
+	if (is_frozen_policy_value(obj)) {
+		return FrozenPolicy::Copy(policy, obj, log);
+	}
+
 	int rc = 0;
 
 	as_policy_batch_remove_init(policy);
 
 	Local<Value> exp_val =
-		Nan::Get(obj, Nan::New("filterExpression").ToLocalChecked())
-			.ToLocalChecked();
-	if (exp_val->IsArray()) {
-		Local<Array> exp_ary = Local<Array>::Cast(exp_val);
-		if (compile_expression(exp_ary, &policy->filter_exp, log) !=
-			AS_NODE_PARAM_OK) {
-			return AS_NODE_PARAM_ERR;
-		}
+		Nan::Get(obj, AS_V8_NAME(filterExpression)).ToLocalChecked();
+	if (filter_expression_from_jsvalue(&policy->filter_exp, exp_val, log) !=
+		AS_NODE_PARAM_OK) {
+		return AS_NODE_PARAM_ERR;
 	}
 	if ((rc = get_optional_uint32_property((uint32_t *)&policy->key, NULL, obj,
 										   "key", log)) != AS_NODE_PARAM_OK) {
@@ -0,0 +1,374 @@
+/*******************************************************************************
+ * Copyright 2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+
+#include <node.h>
+#include "prepared_operations.h"
+#include "arena.h"
+#include "conversions.h"
+#include "memory_accounting.h"
+#include "operations.h"
+#include "log.h"
+
+extern "C" {
+#include <aerospike/as_boolean.h>
+#include <aerospike/as_bytes.h>
+#include <aerospike/as_double.h>
+#include <aerospike/as_geojson.h>
+#include <aerospike/as_integer.h>
+#include <aerospike/as_msgpack.h>
+#include <aerospike/as_nil.h>
+#include <aerospike/as_operations.h>
+#include <aerospike/as_serializer.h>
+#include <aerospike/as_string.h>
+#include <citrusleaf/alloc.h>
+}
+
+using namespace v8;
+
+/*******************************************************************************
+ *  Helpers
+ ******************************************************************************/
+
+/**
+ *  Packs a value the way CDT operations pack their arguments.
+ */
+static void pack_value(as_val *val, as_buffer *buffer)
+{
+	as_serializer ser;
+	as_msgpack_init(&ser);
+	as_buffer_init(buffer);
+	as_serializer_serialize(&ser, val, buffer);
+	as_serializer_destroy(&ser);
+}
+
+/*******************************************************************************
+ *  Constructor and Destructor
+ ******************************************************************************/
+
+PreparedOperations::PreparedOperations(uint16_t n_ops)
+	: n_params(0), size(0)
+{
+	as_operations_init(&ops, n_ops);
+}
+
+/**
+ *  Bound operations hold their own references to the template's values, so
+ *  the template can be destroyed while commands using it are in flight.
+ */
+PreparedOperations::~PreparedOperations()
+{
+	if (size > 0) {
+		memory_track_free(MEMORY_CONVERSION, size);
+	}
+	as_operations_destroy(&ops);
+}
+
+/**
+ *  Constructor for PreparedOperations. Takes the operations, with every
+ *  parameter replaced by a placeholder value, and the slots as an array of
+ *  [operation index, parameter index, placeholder] entries. The placeholder
+ *  is null for parameters that are the whole value of a scalar operation.
+ */
+NAN_METHOD(PreparedOperations::New)
+{
+	if (!info[0]->IsArray()) {
+		return Nan::ThrowTypeError("Operations must be an array");
+	}
+	if (!info[1]->IsArray()) {
+		return Nan::ThrowTypeError("Parameter slots must be an array");
+	}
+
+	Local<Array> ops = info[0].As<Array>();
+	Local<Array> slots = info[1].As<Array>();
+	LogInfo *log = &g_log_info;
+	PreparedOperations *prepared = new PreparedOperations(ops->Length());
+
+	if (operations_from_jsarray(&prepared->ops, ops, log) != AS_NODE_PARAM_OK) {
+		delete prepared;
+		return Nan::ThrowTypeError("Invalid operations");
+	}
+
+	for (uint16_t i = 0; i < prepared->ops.binops.size; i++) {
+		as_bin *bin = &prepared->ops.binops.entries[i].bin;
+		if (bin->valuep != &bin->value) {
+			continue;
+		}
+		as_val *copy = asval_copy_inline((as_val *)&bin->value);
+		if (!copy) {
+			delete prepared;
+			return Nan::ThrowTypeError("Operation value cannot be prepared");
+		}
+		as_val_destroy((as_val *)&bin->value);
+		bin->valuep = (as_bin_value *)copy;
+	}
+
+	for (uint32_t i = 0; i < slots->Length(); i++) {
+		Local<Value> slot = Nan::Get(slots, i).ToLocalChecked();
+		if (!slot->IsArray()) {
+			delete prepared;
+			return Nan::ThrowTypeError("Invalid parameter slot");
+		}
+		Local<Array> entry = slot.As<Array>();
+		uint32_t op = Nan::To<uint32_t>(Nan::Get(entry, 0).ToLocalChecked())
+						  .FromJust();
+		uint32_t param =
+			Nan::To<uint32_t>(Nan::Get(entry, 1).ToLocalChecked()).FromJust();
+		Local<Value> placeholder = Nan::Get(entry, 2).ToLocalChecked();
+		if (prepared->AddSlot(op, param, placeholder, log) !=
+			AS_NODE_PARAM_OK) {
+			delete prepared;
+			return Nan::ThrowTypeError(
+				"Parameter cannot be used in this operation");
+		}
+	}
+
+	std::sort(prepared->slots.begin(), prepared->slots.end(),
+			  [](const Slot &a, const Slot &b) {
+				  return a.op < b.op || (a.op == b.op && a.offset < b.offset);
+			  });
+
+	prepared->size = prepared->ops.binops.capacity * sizeof(as_binop);
+	for (uint16_t i = 0; i < prepared->ops.binops.size; i++) {
+		as_bin *bin = &prepared->ops.binops.entries[i].bin;
+		prepared->size += memory_val_size((as_val *)bin->valuep);
+	}
+	memory_track_alloc(MEMORY_CONVERSION, prepared->size);
+
+	prepared->Wrap(info.This());
+
+	info.GetReturnValue().Set(info.This());
+}
+
+/**
+ *  Records where the placeholder of a parameter ended up in the converted
+ *  operation: a CDT operation packs its arguments into a single byte array,
+ *  so the slot is the placeholder's packed representation within it.
+ */
+int PreparedOperations::AddSlot(uint32_t op, uint32_t param,
+								Local<Value> placeholder, const LogInfo *log)
+{
+	if (op >= ops.binops.size) {
+		as_v8_error(log, "Invalid operation index %u for parameter %u", op,
+					param);
+		return AS_NODE_PARAM_ERR;
+	}
+
+	if (param + 1 > n_params) {
+		n_params = param + 1;
+	}
+
+	if (!placeholder->IsString()) {
+		slots.push_back({op, param, 0, 0});
+		return AS_NODE_PARAM_OK;
+	}
+
+	as_val *val = (as_val *)ops.binops.entries[op].bin.valuep;
+	if (!val || as_val_type(val) != AS_BYTES) {
+		as_v8_error(log, "Operation %u has no packed arguments", op);
+		return AS_NODE_PARAM_ERR;
+	}
+	as_bytes *packed = (as_bytes *)val;
+	const uint8_t *data = as_bytes_get(packed);
+	uint32_t size = as_bytes_size(packed);
+
+	Nan::Utf8String text(placeholder);
+	as_string str;
+	as_string_init(&str, *text, false);
+	as_buffer buffer;
+	pack_value((as_val *)&str, &buffer);
+
+	const uint8_t *found = std::search(data, data + size, buffer.data,
+									   buffer.data + buffer.size);
+	int rc = AS_NODE_PARAM_OK;
+	if (found == data + size) {
+		as_v8_error(log, "Parameter %u not found in operation %u", param, op);
+		rc = AS_NODE_PARAM_ERR;
+	}
+	else {
+		slots.push_back(
+			{op, param, (uint32_t)(found - data), (uint32_t)buffer.size});
+	}
+
+	as_buffer_destroy(&buffer);
+	return rc;
+}
+
+/**
+ *  Instantiate a new PreparedOperations.
+ */
+Local<Value> PreparedOperations::NewInstance(Local<Array> ops,
+											 Local<Array> slots)
+{
+	Nan::EscapableHandleScope scope;
+	const int argc = 2;
+	Local<Value> argv[argc] = {ops, slots};
+
+	Local<Function> cons = Nan::New<Function>(constructor());
+	Nan::TryCatch try_catch;
+	Nan::MaybeLocal<Object> instance = Nan::NewInstance(cons, argc, argv);
+	if (try_catch.HasCaught()) {
+		try_catch.ReThrow();
+		return Nan::Undefined();
+	}
+
+	return scope.Escape(instance.ToLocalChecked());
+}
+
+/**
+ *  Copies the prepared operations wrapped by obj into ops. Operations without
+ *  slots share the template's values; scalar slots take the converted value,
+ *  and CDT operations get a copy of their packed arguments with the packed
+ *  values spliced in at their slots.
+ */
+int PreparedOperations::Bind(as_operations *ops, Local<Object> obj,
+							 Local<Array> values, const LogInfo *log)
+{
+	PreparedOperations *prepared =
+		Nan::ObjectWrap::Unwrap<PreparedOperations>(obj);
+
+	if (values->Length() < prepared->n_params) {
+		as_v8_error(log, "Expected %u parameter values, got %u",
+					prepared->n_params, values->Length());
+		return AS_NODE_PARAM_ERR;
+	}
+
+	uint16_t n_ops = prepared->ops.binops.size;
+	auto slot = prepared->slots.cbegin();
+	auto end = prepared->slots.cend();
+
+	as_operations_init(ops, n_ops);
+	for (uint16_t i = 0; i < n_ops; i++) {
+		const as_binop *src = &prepared->ops.binops.entries[i];
+		as_binop *dst = &ops->binops.entries[ops->binops.size++];
+		dst->op = src->op;
+		strcpy(dst->bin.name, src->bin.name);
+		dst->bin.valuep = NULL;
+
+		as_val *template_val = (as_val *)src->bin.valuep;
+		if (slot == end || slot->op != i) {
+			if (template_val && template_val->free) {
+				as_val_reserve(template_val);
+			}
+			dst->bin.valuep = (as_bin_value *)template_val;
+			continue;
+		}
+
+		if (slot->size == 0) {
+			Local<Value> value = Nan::Get(values, slot->param).ToLocalChecked();
+			as_val *val = NULL;
+			if (asval_from_jsvalue(&val, value, log) != AS_NODE_PARAM_OK) {
+				as_operations_destroy(ops);
+				return AS_NODE_PARAM_ERR;
+			}
+			dst->bin.valuep = (as_bin_value *)val;
+			slot++;
+			continue;
+		}
+
+		as_bytes *packed = (as_bytes *)template_val;
+		const uint8_t *data = as_bytes_get(packed);
+		uint32_t size = as_bytes_size(packed);
+
+		std::vector<as_buffer> buffers;
+		auto first = slot;
+		bool valid = true;
+		for (; slot != end && slot->op == i; slot++) {
+			Local<Value> value = Nan::Get(values, slot->param).ToLocalChecked();
+			as_val *val = NULL;
+			if (asval_from_jsvalue(&val, value, log) != AS_NODE_PARAM_OK) {
+				valid = false;
+				break;
+			}
+			as_buffer buffer;
+			pack_value(val, &buffer);
+			as_val_destroy(val);
+			buffers.push_back(buffer);
+			size = size - slot->size + buffer.size;
+		}
+
+		if (valid) {
+			uint8_t *bytes = (uint8_t *)cf_malloc(size);
+			uint32_t pos = 0;
+			uint32_t len = 0;
+			auto it = first;
+			for (as_buffer &buffer : buffers) {
+				memcpy(bytes + len, data + pos, it->offset - pos);
+				len += it->offset - pos;
+				memcpy(bytes + len, buffer.data, buffer.size);
+				len += buffer.size;
+				pos = it->offset + it->size;
+				it++;
+			}
+			memcpy(bytes + len, data + pos, as_bytes_size(packed) - pos);
+
+			as_bytes *spliced = as_bytes_new_wrap(bytes, size, true);
+			as_bytes_set_type(spliced, as_bytes_get_type(packed));
+			dst->bin.valuep = (as_bin_value *)spliced;
+		}
+
+		for (as_buffer &buffer : buffers) {
+			as_buffer_destroy(&buffer);
+		}
+		if (!valid) {
+			as_operations_destroy(ops);
+			return AS_NODE_PARAM_ERR;
+		}
+	}
+
+	as_v8_detail(log, "Bound %u parameters to %u prepared operations",
+				 prepared->n_params, n_ops);
+	return AS_NODE_PARAM_OK;
+}
+
+/**
+ *  Initialize a PreparedOperations object.
+ *  This creates a constructor function, and sets up the prototype.
+ */
+void PreparedOperations::Init()
+{
+	Local<FunctionTemplate> tpl =
+		Nan::New<FunctionTemplate>(native_entry<PreparedOperations::New>);
+
+	tpl->SetClassName(Nan::New("PreparedOperations").ToLocalChecked());
+
+	tpl->InstanceTemplate()->SetInternalFieldCount(1);
+
+	constructor().Reset(Nan::GetFunction(tpl).ToLocalChecked());
+	function_template().Reset(tpl);
+
+	node::AddEnvironmentCleanupHook(
+		Isolate::GetCurrent(),
+		[](void *) {
+			constructor().Reset();
+			function_template().Reset();
+		},
+		NULL);
+}
+
+/**
+ *  Checks whether value was created by this class's constructor, using the
+ *  brand V8 stamps on every instance of the function template.
+ */
+bool PreparedOperations::HasInstance(Local<Value> value)
+{
+	if (function_template().IsEmpty()) {
+		return false;
+	}
+	return Nan::New(function_template())->HasInstance(value);
+}
@@ -452,7 +452,7 @@ void free_query(as_query *query, as_policy_query *policy, as_exp *exp)
 
 	if (policy) {
 		if (policy->base.filter_exp) {
-			as_exp_destroy(policy->base.filter_exp);
+			release_expression(policy->base.filter_exp);
 		}
 	}
 
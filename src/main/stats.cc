@@ -21,6 +21,8 @@
 #include <node.h>
 
 #include "client.h"
+#include "latency.h"
+#include "memory_accounting.h"
 
 extern "C" {
 #include <aerospike/aerospike_stats.h>
@@ -65,9 +67,31 @@ NAN_METHOD(AerospikeClient::GetStats)
 	aerospike_stats(client->as, &cluster_stats);
 	Local<Object> stats = build_cluster_stats(&cluster_stats);
 	aerospike_stats_destroy(&cluster_stats);
+	Local<Object> commands =
+		Nan::Get(stats, Nan::New("commands").ToLocalChecked())
+			.ToLocalChecked()
+			.As<Object>();
+	Nan::Set(commands, Nan::New("pipelined").ToLocalChecked(),
+			 Nan::New<Uint32>(client->pipeline->in_flight));
+	Nan::Set(stats, Nan::New("latency").ToLocalChecked(),
+			 client->latency->ToJSObject());
+	if (client->cache) {
+		Nan::Set(stats, Nan::New("cache").ToLocalChecked(),
+				 client->cache->ToJSObject());
+	}
+	Nan::Set(stats, Nan::New("memory").ToLocalChecked(),
+			 memory_stats_to_jsobject());
 	info.GetReturnValue().Set(stats);
 }
 
+NAN_METHOD(AerospikeClient::ResetStats)
+{
+	Nan::HandleScope scope;
+	AerospikeClient *client =
+		Nan::ObjectWrap::Unwrap<AerospikeClient>(info.This());
+	client->latency->Reset();
+}
+
 //==========================================================
 // Local helpers.
 //
@@ -122,6 +146,8 @@ static Local<Object> build_cluster_stats(as_cluster_stats *cluster)
 	Local<Object> stats = Nan::New<Object>();
 	Nan::Set(stats, Nan::New("commands").ToLocalChecked(),
 			 build_event_loop_stats(&cluster->event_loops[0]));
+	Nan::Set(stats, Nan::New("eventLoops").ToLocalChecked(),
+			 Nan::New<Uint32>(cluster->event_loops_size));
 	Local<Array> nodes = Nan::New<Array>();
 	for (uint32_t i = 0; i < cluster->nodes_size; i++) {
 		Nan::Set(nodes, i, build_node_stats(&cluster->nodes[i]));
@@ -1,6 +1,8 @@
 #include <node.h>
 #include "transaction.h"
+#include "arena.h"
 #include "conversions.h"
+#include "memory_accounting.h"
 
 extern "C" {
 #include <aerospike/as_txn.h>
@@ -9,6 +11,15 @@ extern "C" {
 
 using namespace v8;
 
+// Estimated size of a row of a transaction's read or write hash table.
+#define TXN_ROW_SIZE 40
+
+static size_t txn_size(uint32_t reads_capacity, uint32_t writes_capacity)
+{
+	return sizeof(as_txn) +
+		   ((size_t)reads_capacity + writes_capacity) * TXN_ROW_SIZE;
+}
+
 /*******************************************************************************
  *  Constructor and Destructor
  ******************************************************************************/
@@ -42,12 +53,16 @@ NAN_METHOD(Transaction::New)
 		txn = as_txn_create_capacity(reads_capacity, writes_capacity);
 	}
 	else {
+		reads_capacity = AS_TXN_READ_CAPACITY_DEFAULT;
+		writes_capacity = AS_TXN_WRITE_CAPACITY_DEFAULT;
 		txn = as_txn_create();
 	}
 
 
 	Transaction *transaction = new Transaction();
 	transaction->txn = txn;
+	transaction->size = txn_size(reads_capacity, writes_capacity);
+	memory_track_alloc(MEMORY_TXN, transaction->size);
 	transaction->Wrap(info.This());
 
 	info.GetReturnValue().Set(info.This());
@@ -62,6 +77,7 @@ NAN_METHOD(Transaction::Close)
 		Nan::ObjectWrap::Unwrap<Transaction>(info.This());
 
 	as_txn_destroy(transaction->txn);
+	memory_track_free(MEMORY_TXN, transaction->size);
 
 	delete transaction;
 }
@@ -156,21 +172,42 @@ Local<Value> Transaction::NewInstance(Local<Object> capacity_obj)
 void Transaction::Init()
 {
 	Local<FunctionTemplate> tpl =
-		Nan::New<FunctionTemplate>(Transaction::New);
+		Nan::New<FunctionTemplate>(native_entry<Transaction::New>);
 
 	tpl->SetClassName(Nan::New("Transaction").ToLocalChecked());
 
 	tpl->InstanceTemplate()->SetInternalFieldCount(1);
 
-	Nan::SetPrototypeMethod(tpl, "getId", GetId);
-	Nan::SetPrototypeMethod(tpl, "getInDoubt", GetInDoubt);
-	Nan::SetPrototypeMethod(tpl, "getTimeout", GetTimeout);
-	Nan::SetPrototypeMethod(tpl, "getState", GetState);
+	Nan::SetPrototypeMethod(tpl, "getId", native_entry<GetId>);
+	Nan::SetPrototypeMethod(tpl, "getInDoubt", native_entry<GetInDoubt>);
+	Nan::SetPrototypeMethod(tpl, "getTimeout", native_entry<GetTimeout>);
+	Nan::SetPrototypeMethod(tpl, "getState", native_entry<GetState>);
 
-	Nan::SetPrototypeMethod(tpl, "setTimeout", SetTimeout);
+	Nan::SetPrototypeMethod(tpl, "setTimeout", native_entry<SetTimeout>);
 
-	Nan::SetPrototypeMethod(tpl, "close", Close);
+	Nan::SetPrototypeMethod(tpl, "close", native_entry<Close>);
 
 
 	constructor().Reset(Nan::GetFunction(tpl).ToLocalChecked());
+	function_template().Reset(tpl);
+
+	node::AddEnvironmentCleanupHook(
+		Isolate::GetCurrent(),
+		[](void *) {
+			constructor().Reset();
+			function_template().Reset();
+		},
+		NULL);
+}
+
+/**
+ *  Checks whether value was created by this class's constructor, using the
+ *  brand V8 stamps on every instance of the function template.
+ */
+bool Transaction::HasInstance(Local<Value> value)
+{
+	if (function_template().IsEmpty()) {
+		return false;
+	}
+	return Nan::New(function_template())->HasInstance(value);
 }
\ No newline at end of file
@@ -0,0 +1,151 @@
+/*******************************************************************************
+ * Copyright 2013-2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "arena.h"
+#include "memory_accounting.h"
+
+extern "C" {
+#include <citrusleaf/alloc.h>
+}
+
+// Size of an arena's first chunk; later chunks double in size.
+#define ARENA_CHUNK_SIZE (16 * 1024)
+
+// Arenas that grew beyond this size while converting an unusually large
+// command give their memory back instead of keeping it for the next one.
+#define ARENA_MAX_RETAINED_SIZE (1024 * 1024)
+
+// Maximum number of idle arenas kept per thread; more than one is only
+// needed while scopes are nested.
+#define ARENA_POOL_SIZE 4
+
+#define ARENA_ALIGN(__size) (((__size) + 7) & ~((size_t)7))
+
+Arena::Arena() {}
+
+Arena::~Arena() { FreeChunks(); }
+
+void Arena::AddChunk(size_t min_size)
+{
+	size_t size = chunks ? chunks->size * 2 : ARENA_CHUNK_SIZE;
+	size_t header = ARENA_ALIGN(sizeof(Chunk));
+	while (size < min_size + header) {
+		size *= 2;
+	}
+
+	Chunk *chunk = (Chunk *)cf_malloc(size);
+	memory_track_alloc(MEMORY_CONVERSION, size);
+	chunk->next = chunks;
+	chunk->size = size;
+	chunks = chunk;
+	allocated += size;
+
+	cursor = (char *)chunk + header;
+	limit = (char *)chunk + size;
+}
+
+void *Arena::Alloc(size_t size)
+{
+	size = ARENA_ALIGN(size);
+	if (cursor == NULL || (size_t)(limit - cursor) < size) {
+		AddChunk(size);
+	}
+
+	void *ptr = cursor;
+	cursor += size;
+	return ptr;
+}
+
+char *Arena::Strdup(const char *str, size_t len)
+{
+	char *copy = (char *)Alloc(len + 1);
+	memcpy(copy, str, len);
+	copy[len] = '\0';
+	return copy;
+}
+
+void Arena::FreeChunks()
+{
+	while (chunks) {
+		Chunk *next = chunks->next;
+		memory_track_free(MEMORY_CONVERSION, chunks->size);
+		cf_free(chunks);
+		chunks = next;
+	}
+	cursor = limit = NULL;
+	allocated = 0;
+}
+
+/**
+ *  Releases all allocations. An arena that needed several chunks is
+ *  coalesced into a single chunk of the combined size, so that a command of
+ *  the same size fits into one chunk next time.
+ */
+void Arena::Reset()
+{
+	if (chunks == NULL) {
+		return;
+	}
+
+	size_t total = allocated;
+	if (chunks->next != NULL || total > ARENA_MAX_RETAINED_SIZE) {
+		FreeChunks();
+		if (total <= ARENA_MAX_RETAINED_SIZE) {
+			AddChunk(total - ARENA_ALIGN(sizeof(Chunk)));
+		}
+		return;
+	}
+
+	cursor = (char *)chunks + ARENA_ALIGN(sizeof(Chunk));
+}
+
+static thread_local std::vector<std::unique_ptr<Arena>> g_arena_pool;
+static thread_local Arena *g_current_arena = NULL;
+
+ArenaScope::ArenaScope() : previous(g_current_arena)
+{
+	if (g_arena_pool.empty()) {
+		arena = new Arena();
+	}
+	else {
+		arena = g_arena_pool.back().release();
+		g_arena_pool.pop_back();
+	}
+	g_current_arena = arena;
+}
+
+ArenaScope::~ArenaScope()
+{
+	g_current_arena = previous;
+	arena->Reset();
+	if (g_arena_pool.size() < ARENA_POOL_SIZE) {
+		g_arena_pool.emplace_back(arena);
+	}
+	else {
+		delete arena;
+	}
+}
+
+HeapScope::HeapScope() : previous(g_current_arena) { g_current_arena = NULL; }
+
+HeapScope::~HeapScope() { g_current_arena = previous; }
+
+Arena *arena_current() { return g_current_arena; }
@@ -15,6 +15,7 @@
  ******************************************************************************/
 
 #include <cstdint>
+#include <cmath>
 #include <complex>
 #include <node.h>
 #include <node_buffer.h>
@@ -58,37 +59,50 @@ extern "C" {
 #include "enums.h"
 #include "string.h"
 #include "transaction.h"
+#include "property_names.h"
+#include "arena.h"
+#include "value_classes.h"
+#include "compiled_expression.h"
+#include "frozen_policy.h"
 
 using namespace node;
 using namespace v8;
 
-const char *DoubleType = "Double";
-const char *GeoJSONType = "GeoJSON";
-const char *BinType = "Bin";
-const char *TransactionType = "Transaction";
-
 const int64_t MIN_SAFE_INTEGER = -1 * (std::pow(2, 53) - 1);
 const int64_t MAX_SAFE_INTEGER = std::pow(2, 53) - 1;
 const uint64_t UMAX_SAFE_INTEGER = std::pow(2, 53) - 1;
+
+// Bytes values of at least this size are passed between JS Buffers and the C
+// client without copying; below it, copying is cheaper than the Buffer
+// finalizer.
+const uint32_t ZERO_COPY_MIN_SIZE = 4096;
 /*******************************************************************************
  *  FUNCTIONS
  ******************************************************************************/
 
-int get_string_property(char **strp, Local<Object> obj, char const *prop,
+int get_string_property(char **strp, Local<Object> obj, Local<String> prop,
 						const LogInfo *log)
 {
 	Nan::HandleScope scope;
-	Local<Value> value =
-		Nan::Get(obj, Nan::New(prop).ToLocalChecked()).ToLocalChecked();
+	Local<Value> value = Nan::Get(obj, prop).ToLocalChecked();
 	if (!value->IsString()) {
-		as_v8_error(log, "Type error: %s property should be string", prop);
+		as_v8_error(log, "Type error: %s property should be string",
+					*Nan::Utf8String(prop));
 		return AS_NODE_PARAM_ERR;
 	}
 	(*strp) = strdup(*Nan::Utf8String(value));
-	as_v8_detail(log, "%s => \"%s\"", prop, *strp);
+	as_v8_detail(log, "%s => \"%s\"", *Nan::Utf8String(prop), *strp);
 	return AS_NODE_PARAM_OK;
 }
 
+int get_string_property(char **strp, Local<Object> obj, char const *prop,
+						const LogInfo *log)
+{
+	Nan::HandleScope scope;
+	Local<String> name = Nan::New(prop).ToLocalChecked();
+	return get_string_property(strp, obj, name, log);
+}
+
 int get_optional_string_property(char **strp, bool *defined, Local<Object> obj,
 								 char const *prop, const LogInfo *log)
 {
@@ -113,21 +127,29 @@ int get_optional_string_property(char **strp, bool *defined, Local<Object> obj,
 	return AS_NODE_PARAM_OK;
 }
 
-int get_int_property(int *intp, Local<Object> obj, char const *prop,
+int get_int_property(int *intp, Local<Object> obj, Local<String> prop,
 					 const LogInfo *log)
 {
 	Nan::HandleScope scope;
-	Local<Value> value =
-		Nan::Get(obj, Nan::New(prop).ToLocalChecked()).ToLocalChecked();
+	Local<Value> value = Nan::Get(obj, prop).ToLocalChecked();
 	if (!value->IsNumber()) {
-		as_v8_error(log, "Type error: %s property should be integer", prop);
+		as_v8_error(log, "Type error: %s property should be integer",
+					*Nan::Utf8String(prop));
 		return AS_NODE_PARAM_ERR;
 	}
 	(*intp) = Nan::To<int>(value).FromJust();
-	as_v8_detail(log, "%s => (int) %d", prop, *intp);
+	as_v8_detail(log, "%s => (int) %d", *Nan::Utf8String(prop), *intp);
 	return AS_NODE_PARAM_OK;
 }
 
+int get_int_property(int *intp, Local<Object> obj, char const *prop,
+					 const LogInfo *log)
+{
+	Nan::HandleScope scope;
+	Local<String> name = Nan::New(prop).ToLocalChecked();
+	return get_int_property(intp, obj, name, log);
+}
+
 int get_optional_int_property(int *intp, bool *defined, Local<Object> obj,
 							  char const *prop, const LogInfo *log)
 {
@@ -195,37 +217,53 @@ int get_optional_rack_ids_property(as_config *config, bool *defined, Local<Objec
 	return AS_NODE_PARAM_OK;
 }
 
-int get_int64_property(int64_t *intp, Local<Object> obj, char const *prop,
+int get_int64_property(int64_t *intp, Local<Object> obj, Local<String> prop,
 					   const LogInfo *log)
 {
 	Nan::HandleScope scope;
-	Local<Value> value =
-		Nan::Get(obj, Nan::New(prop).ToLocalChecked()).ToLocalChecked();
+	Local<Value> value = Nan::Get(obj, prop).ToLocalChecked();
 	if (!value->IsNumber()) {
-		as_v8_error(log, "Type error: %s property should be integer", prop);
-		as_v8_detail(log, "%s => (int64) %d", prop, *intp);
+		as_v8_error(log, "Type error: %s property should be integer",
+					*Nan::Utf8String(prop));
+		as_v8_detail(log, "%s => (int64) %d", *Nan::Utf8String(prop), *intp);
 		return AS_NODE_PARAM_ERR;
 	}
 	(*intp) = Nan::To<int64_t>(value).FromJust();
-	as_v8_detail(log, "%s => (int64) %d", prop, *intp);
+	as_v8_detail(log, "%s => (int64) %d", *Nan::Utf8String(prop), *intp);
 	return AS_NODE_PARAM_OK;
 }
 
-int get_uint64_property(uint64_t *intp, Local<Object> obj, char const *prop,
+int get_int64_property(int64_t *intp, Local<Object> obj, char const *prop,
+					   const LogInfo *log)
+{
+	Nan::HandleScope scope;
+	Local<String> name = Nan::New(prop).ToLocalChecked();
+	return get_int64_property(intp, obj, name, log);
+}
+
+int get_uint64_property(uint64_t *intp, Local<Object> obj, Local<String> prop,
 						const LogInfo *log)
 {
 	Nan::HandleScope scope;
-	Local<Value> value =
-		Nan::Get(obj, Nan::New(prop).ToLocalChecked()).ToLocalChecked();
+	Local<Value> value = Nan::Get(obj, prop).ToLocalChecked();
 	if (!value->IsNumber()) {
-		as_v8_error(log, "Type error: %s property should be integer", prop);
+		as_v8_error(log, "Type error: %s property should be integer",
+					*Nan::Utf8String(prop));
 		return AS_NODE_PARAM_ERR;
 	}
 	(*intp) = Nan::To<int64_t>(value).FromJust();
-	as_v8_detail(log, "%s => (uint64) %d", prop, *intp);
+	as_v8_detail(log, "%s => (uint64) %d", *Nan::Utf8String(prop), *intp);
 	return AS_NODE_PARAM_OK;
 }
 
+int get_uint64_property(uint64_t *intp, Local<Object> obj, char const *prop,
+						const LogInfo *log)
+{
+	Nan::HandleScope scope;
+	Local<String> name = Nan::New(prop).ToLocalChecked();
+	return get_uint64_property(intp, obj, name, log);
+}
+
 int get_uint32_property(uint32_t *uintp, Local<Object> obj, char const *prop,
 						const LogInfo *log)
 {
@@ -318,31 +356,39 @@ int get_optional_uint64_property(uint64_t *intp, bool *defined, Local<Object> ob
 }
 
 int get_optional_uint32_property(uint32_t *intp, bool *defined,
-								 Local<Object> obj, char const *prop,
+								 Local<Object> obj, Local<String> prop,
 								 const LogInfo *log)
 {
 	Nan::HandleScope scope;
-	Local<Value> value =
-		Nan::Get(obj, Nan::New(prop).ToLocalChecked()).ToLocalChecked();
+	Local<Value> value = Nan::Get(obj, prop).ToLocalChecked();
 	if (value->IsNumber()) {
 		if (defined != NULL)
 			(*defined) = true;
 		(*intp) = Nan::To<uint32_t>(value).FromJust();
-		as_v8_detail(log, "%s => (uint32) %d", prop, *intp);
+		as_v8_detail(log, "%s => (uint32) %d", *Nan::Utf8String(prop), *intp);
 	}
 	else if (value->IsUndefined() || value->IsNull()) {
 		if (defined != NULL)
 			(*defined) = false;
-		as_v8_detail(log, "%s => undefined", prop);
+		as_v8_detail(log, "%s => undefined", *Nan::Utf8String(prop));
 	}
 	else {
 		as_v8_error(log, "Type error: %s property should be integer (uint32)",
-					prop);
+					*Nan::Utf8String(prop));
 		return AS_NODE_PARAM_ERR;
 	}
 	return AS_NODE_PARAM_OK;
 }
 
+int get_optional_uint32_property(uint32_t *intp, bool *defined,
+								 Local<Object> obj, char const *prop,
+								 const LogInfo *log)
+{
+	Nan::HandleScope scope;
+	Local<String> name = Nan::New(prop).ToLocalChecked();
+	return get_optional_uint32_property(intp, defined, obj, name, log);
+}
+
 int get_optional_uint16_property(uint16_t *intp, bool *defined,
 								 Local<Object> obj, char const *prop,
 								 const LogInfo *log)
@@ -395,58 +441,73 @@ int get_optional_uint8_property(uint8_t *intp, bool *defined,
 	return AS_NODE_PARAM_OK;
 }
 
-int get_float_property(double *floatp, Local<Object> obj, char const *prop,
+int get_float_property(double *floatp, Local<Object> obj, Local<String> prop,
 					   const LogInfo *log)
 {
 	Nan::HandleScope scope;
-	Local<Value> value =
-		Nan::Get(obj, Nan::New(prop).ToLocalChecked()).ToLocalChecked();
-	if (value->IsNumber() || instanceof (value, DoubleType)) {
+	Local<Value> value = Nan::Get(obj, prop).ToLocalChecked();
+	if (value->IsNumber() ||
+		is_value_class_instance(value, VALUE_CLASS_DOUBLE)) {
 		(*floatp) = double_value(value);
-		as_v8_detail(log, "%s => (double) %g", prop, *floatp);
+		as_v8_detail(log, "%s => (double) %g", *Nan::Utf8String(prop), *floatp);
 	}
 	else {
 		as_v8_error(log,
 					"Type error: %s property should be a floating point number",
-					prop);
+					*Nan::Utf8String(prop));
 		return AS_NODE_PARAM_ERR;
 	}
 	return AS_NODE_PARAM_OK;
 }
 
+int get_float_property(double *floatp, Local<Object> obj, char const *prop,
+					   const LogInfo *log)
+{
+	Nan::HandleScope scope;
+	Local<String> name = Nan::New(prop).ToLocalChecked();
+	return get_float_property(floatp, obj, name, log);
+}
+
 int get_optional_bool_property(bool *boolp, bool *defined, Local<Object> obj,
-							   char const *prop, const LogInfo *log)
+							   Local<String> prop, const LogInfo *log)
 {
 	Nan::HandleScope scope;
-	Local<Value> value =
-		Nan::Get(obj, Nan::New(prop).ToLocalChecked()).ToLocalChecked();
+	Local<Value> value = Nan::Get(obj, prop).ToLocalChecked();
 	if (value->IsBoolean()) {
 		if (defined != NULL)
 			(*defined) = true;
 		(*boolp) = Nan::To<bool>(value).FromJust();
-		as_v8_detail(log, "%s => (bool) %d", prop, *boolp);
+		as_v8_detail(log, "%s => (bool) %d", *Nan::Utf8String(prop), *boolp);
 	}
 	else if (value->IsUndefined() || value->IsNull()) {
 		if (defined != NULL)
 			(*defined) = false;
-		as_v8_detail(log, "%s => undefined", prop);
+		as_v8_detail(log, "%s => undefined", *Nan::Utf8String(prop));
 	}
 	else {
-		as_v8_error(log, "Type error: %s property should be boolean", prop);
+		as_v8_error(log, "Type error: %s property should be boolean",
+					*Nan::Utf8String(prop));
 		return AS_NODE_PARAM_ERR;
 	}
 	return AS_NODE_PARAM_OK;
 }
 
+int get_optional_bool_property(bool *boolp, bool *defined, Local<Object> obj,
+							   char const *prop, const LogInfo *log)
+{
+	Nan::HandleScope scope;
+	Local<String> name = Nan::New(prop).ToLocalChecked();
+	return get_optional_bool_property(boolp, defined, obj, name, log);
+}
+
 
 
 int get_optional_transaction_property(as_txn **txn, bool *defined,
-								Local<Object> obj, char const *prop,
+								Local<Object> obj, Local<String> prop,
 								const LogInfo *log)
 {
 	Nan::HandleScope scope;
-	Local<Value> js_wrapper_value =
-		Nan::Get(obj, Nan::New(prop).ToLocalChecked()).ToLocalChecked();
+	Local<Value> js_wrapper_value = Nan::Get(obj, prop).ToLocalChecked();
 
 	if (js_wrapper_value->IsObject()) {
 		Local<Value> value =
@@ -458,39 +519,59 @@ int get_optional_transaction_property(as_txn **txn, bool *defined,
 
 			(*txn) = transaction->txn;
 
-			as_v8_detail(log, "%s => (transaction) %d", prop, (*txn)->id);
+			as_v8_detail(log, "%s => (transaction) %d", *Nan::Utf8String(prop),
+						 (*txn)->id);
 		}
 		else if (value->IsUndefined() || value->IsNull()) {
 			if (defined != NULL)
 				(*defined) = false;
 
-			as_v8_detail(log, "%s => undefined", prop);
+			as_v8_detail(log, "%s => undefined", *Nan::Utf8String(prop));
 		}
 		else {
-			as_v8_error(log, "Type error: %s property should be a Transaction type", prop);
+			as_v8_error(log,
+						"Type error: %s property should be a Transaction type",
+						*Nan::Utf8String(prop));
 			return AS_NODE_PARAM_ERR;
 		}
 	}
 	return AS_NODE_PARAM_OK;
 }
 
-int get_bool_property(bool *boolp, Local<Object> obj, char const *prop,
+int get_optional_transaction_property(as_txn **txn, bool *defined,
+								Local<Object> obj, char const *prop,
+								const LogInfo *log)
+{
+	Nan::HandleScope scope;
+	Local<String> name = Nan::New(prop).ToLocalChecked();
+	return get_optional_transaction_property(txn, defined, obj, name, log);
+}
+
+int get_bool_property(bool *boolp, Local<Object> obj, Local<String> prop,
 					  const LogInfo *log)
 {
 	Nan::HandleScope scope;
-	Local<Value> value =
-		Nan::Get(obj, Nan::New(prop).ToLocalChecked()).ToLocalChecked();
+	Local<Value> value = Nan::Get(obj, prop).ToLocalChecked();
 	if (value->IsBoolean()) {
 		(*boolp) = Nan::To<bool>(value).FromJust();
-		as_v8_detail(log, "%s => (bool) %d", prop, *boolp);
+		as_v8_detail(log, "%s => (bool) %d", *Nan::Utf8String(prop), *boolp);
 	}
 	else {
-		as_v8_error(log, "Type error: %s property should be boolean", prop);
+		as_v8_error(log, "Type error: %s property should be boolean",
+					*Nan::Utf8String(prop));
 		return AS_NODE_PARAM_ERR;
 	}
 	return AS_NODE_PARAM_OK;
 }
 
+int get_bool_property(bool *boolp, Local<Object> obj, char const *prop,
+					  const LogInfo *log)
+{
+	Nan::HandleScope scope;
+	Local<String> name = Nan::New(prop).ToLocalChecked();
+	return get_bool_property(boolp, obj, name, log);
+}
+
 int get_list_property(as_list **list, Local<Object> obj, char const *prop,
 					  const LogInfo *log)
 {
@@ -506,13 +587,13 @@ int get_list_property(as_list **list, Local<Object> obj, char const *prop,
 
 
 int get_bytes_property(uint8_t **bytes, int *size, Local<Object> obj,
-					   char const *prop, const LogInfo *log)
+					   Local<String> prop, const LogInfo *log)
 {
 	Nan::HandleScope scope;
-	Local<Value> value =
-		Nan::Get(obj, Nan::New(prop).ToLocalChecked()).ToLocalChecked();
+	Local<Value> value = Nan::Get(obj, prop).ToLocalChecked();
 	if (!node::Buffer::HasInstance(value)) {
-		as_v8_error(log, "Type error: %s property should be Buffer", prop);
+		as_v8_error(log, "Type error: %s property should be Buffer",
+					*Nan::Utf8String(prop));
 		return AS_NODE_PARAM_ERR;
 	}
 
@@ -525,6 +606,14 @@ int get_bytes_property(uint8_t **bytes, int *size, Local<Object> obj,
 	return AS_NODE_PARAM_OK;
 }
 
+int get_bytes_property(uint8_t **bytes, int *size, Local<Object> obj,
+					   char const *prop, const LogInfo *log)
+{
+	Nan::HandleScope scope;
+	Local<String> name = Nan::New(prop).ToLocalChecked();
+	return get_bytes_property(bytes, size, obj, name, log);
+}
+
 int get_optional_bytes_property(uint8_t **bytes, int *size, bool *defined,
 								Local<Object> obj, char const *prop,
 								const LogInfo *log)
@@ -568,20 +657,27 @@ void get_wildcard_property(as_val **value, const LogInfo *log)
 	*value = (as_val *)&as_cmp_wildcard;
 }
 
-int get_asval_property(as_val **value, Local<Object> obj, const char *prop,
+int get_asval_property(as_val **value, Local<Object> obj, Local<String> prop,
 					   const LogInfo *log)
 {
 	Nan::HandleScope scope;
-	Local<Value> v8value =
-		Nan::Get(obj, Nan::New(prop).ToLocalChecked()).ToLocalChecked();
+	Local<Value> v8value = Nan::Get(obj, prop).ToLocalChecked();
 	if (v8value->IsUndefined()) {
 		as_v8_error(log, "Type error: %s property should not be undefined",
-					prop);
+					*Nan::Utf8String(prop));
 		return AS_NODE_PARAM_ERR;
 	}
 	return asval_from_jsvalue(value, v8value, log);
 }
 
+int get_asval_property(as_val **value, Local<Object> obj, const char *prop,
+					   const LogInfo *log)
+{
+	Nan::HandleScope scope;
+	Local<String> name = Nan::New(prop).ToLocalChecked();
+	return get_asval_property(value, obj, name, log);
+}
+
 int get_optional_asval_property(as_val **value, bool *defined,
 								Local<Object> obj, const char *prop,
 								const LogInfo *log)
@@ -882,6 +978,39 @@ as_val *asval_clone(const as_val *val, const LogInfo *log)
 	return clone_val;
 }
 
+/**
+ *  Copies a value stored inline in its bin to the heap, so that it can be
+ *  shared by reference beyond the lifetime of the bin.
+ */
+as_val *asval_copy_inline(const as_val *val)
+{
+	switch (as_val_type((as_val *)val)) {
+	case AS_NIL:
+		return (as_val *)&as_nil;
+	case AS_BOOLEAN:
+		return (as_val *)as_boolean_new(as_boolean_get((as_boolean *)val));
+	case AS_INTEGER:
+		return (as_val *)as_integer_new(as_integer_get((as_integer *)val));
+	case AS_DOUBLE:
+		return (as_val *)as_double_new(as_double_get((as_double *)val));
+	case AS_STRING:
+		return (as_val *)as_string_new_strdup(as_string_get((as_string *)val));
+	case AS_GEOJSON:
+		return (as_val *)as_geojson_new_strdup(
+			as_geojson_get((as_geojson *)val));
+	case AS_BYTES: {
+		as_bytes *bytes = (as_bytes *)val;
+		uint32_t size = as_bytes_size(bytes);
+		as_bytes *copy = as_bytes_new(size);
+		as_bytes_set(copy, 0, as_bytes_get(bytes), size);
+		as_bytes_set_type(copy, as_bytes_get_type(bytes));
+		return (as_val *)copy;
+	}
+	default:
+		return NULL;
+	}
+}
+
 bool key_clone(const as_key *src, as_key **dest, const LogInfo *log,
 			   bool alloc_key)
 {
@@ -982,6 +1111,11 @@ Local<Object> error_to_jsobject(as_error *error, const LogInfo *log)
 	return scope.Escape(err);
 }
 
+static void free_bytes_value(char *data, void *hint)
+{
+	cf_free(data);
+}
+
 Local<Value> val_to_jsvalue(as_val *val, const LogInfo *log)
 {
 	Nan::EscapableHandleScope scope;
@@ -1047,6 +1181,19 @@ Local<Value> val_to_jsvalue(as_val *val, const LogInfo *log)
 			as_v8_detail(log, "bytes value = <%x %x %x%s>",
 						 size > 0 ? data[0] : 0, size > 1 ? data[1] : 0,
 						 size > 2 ? data[2] : 0, size > 3 ? " ..." : "");
+
+			// Large values the C client allocated for this as_bytes alone
+			// are handed over to the Buffer instead of being copied; the
+			// as_bytes no longer frees them once the Buffer owns them.
+			if (size >= ZERO_COPY_MIN_SIZE && bval->free &&
+				bval->_.count == 1) {
+				bval->free = false;
+				Local<Object> buff =
+					Nan::NewBuffer((char *)data, size, free_bytes_value, NULL)
+						.ToLocalChecked();
+				return scope.Escape(buff);
+			}
+
 			// this constructor actually copies data into the new Buffer
 			Local<Object> buff =
 				Nan::CopyBuffer((char *)data, size).ToLocalChecked();
@@ -1139,22 +1286,24 @@ Local<Object> recordmeta_to_jsobject(const as_record *record,
 	}
 
 	meta = Nan::New<Object>();
-	Local<Number> ttl;
-	switch (record->ttl) {
-	case AS_RECORD_NO_EXPIRE_TTL:
-		ttl = Nan::New<Number>(TTL_NEVER_EXPIRE);
-		break;
-	default:
-		ttl = Nan::New<Number>(record->ttl);
-	}
-	Nan::Set(meta, Nan::New("ttl").ToLocalChecked(), ttl);
+	Nan::Set(meta, AS_V8_NAME(ttl), recordttl_to_jsnumber(record));
 	as_v8_detail(log, "TTL of the record %d", record->ttl);
-	Nan::Set(meta, Nan::New("gen").ToLocalChecked(), Nan::New(record->gen));
+	Nan::Set(meta, AS_V8_NAME(gen), Nan::New(record->gen));
 	as_v8_detail(log, "Gen of the record %d", record->gen);
 
 	return scope.Escape(meta);
 }
 
+Local<Number> recordttl_to_jsnumber(const as_record *record)
+{
+	switch (record->ttl) {
+	case AS_RECORD_NO_EXPIRE_TTL:
+		return Nan::New<Number>(TTL_NEVER_EXPIRE);
+	default:
+		return Nan::New<Number>(record->ttl);
+	}
+}
+
 Local<Object> record_to_jsobject(const as_record *record, const as_key *key,
 								 const LogInfo *log)
 {
@@ -1199,10 +1348,9 @@ bool instanceof (Local<Value> value, const char *type)
 
 /**
  * Node.js stores all number values > 2^31 in the class Number and
- * values < 2^31 are stored in the class SMI (Small Integers). To distinguish
- * between a double and int64_t value in Node.js, retrieve the value as double
- * and also as int64_t. If the values are same, then store it as int64_t. Else
- * store it as double.
+ * values < 2^31 are stored in the class SMI (Small Integers). A number is
+ * stored as int64_t if it has no fraction and fits into an int64_t, and as
+ * double otherwise.
  * The problem with this implementation is var 123.00 will be treated as int64_t.
  * Applications can enforce double type by using the `Aerospike.Double` data type,
  * e.g.
@@ -1213,17 +1361,23 @@ bool instanceof (Local<Value> value, const char *type)
  */
 bool is_double_value(Local<Value> value)
 {
+	if (value->IsInt32()) {
+		return false;
+	}
 	if (value->IsNumber()) {
-		int64_t i = Nan::To<int64_t>(value).FromJust();
-		double d = Nan::To<double>(value).FromJust();
-		return d != (double)i;
+		double d = value.As<Number>()->Value();
+		return !(d >= -9223372036854775808.0 && d < 9223372036854775808.0 &&
+				 d == std::trunc(d));
 	}
-	return instanceof (value, DoubleType);
+	return is_value_class_instance(value, VALUE_CLASS_DOUBLE);
 }
 
 double double_value(Local<Value> value)
 {
-	if (instanceof (value, DoubleType)) {
+	if (value->IsNumber()) {
+		return value.As<Number>()->Value();
+	}
+	if (is_value_class_instance(value, VALUE_CLASS_DOUBLE)) {
 		value = Nan::Get(value.As<Object>(),
 						 Nan::New<String>("Double").ToLocalChecked())
 					.ToLocalChecked();
@@ -1233,17 +1387,27 @@ double double_value(Local<Value> value)
 
 bool is_geojson_value(Local<Value> value)
 {
-	return instanceof (value, GeoJSONType);
+	return is_value_class_instance(value, VALUE_CLASS_GEOJSON);
 }
 
 bool is_transaction_value(Local<Value> value)
 {
-	return instanceof (value, TransactionType);
+	return Transaction::HasInstance(value);
+}
+
+bool is_compiled_expression_value(Local<Value> value)
+{
+	return CompiledExpression::HasInstance(value);
+}
+
+bool is_frozen_policy_value(Local<Value> value)
+{
+	return FrozenPolicy::HasInstance(value);
 }
 
 bool is_bin_value(Local<Value> value)
 {
-	return instanceof (value, BinType);
+	return is_value_class_instance(value, VALUE_CLASS_BIN);
 }
 
 char *geojson_as_string(Local<Value> value)
@@ -1254,11 +1418,118 @@ char *geojson_as_string(Local<Value> value)
 	return strdup(*Nan::Utf8String(strval));
 }
 
+/**
+ *  Value constructors used by the conversions below. While an ArenaScope is
+ *  active, the values and their data are allocated from its arena, with all
+ *  free flags cleared, instead of from the heap.
+ */
+static char *new_cstring(const Nan::Utf8String &str)
+{
+	Arena *arena = arena_current();
+	if (arena) {
+		return arena->Strdup(*str, str.length());
+	}
+	return strdup(*str);
+}
+
+static as_val *new_string_val(Local<Value> v8value)
+{
+	Nan::Utf8String str(v8value);
+	Arena *arena = arena_current();
+	if (arena) {
+		as_string *val = (as_string *)arena->Alloc(sizeof(as_string));
+		return (as_val *)as_string_init(val, new_cstring(str), false);
+	}
+	return (as_val *)as_string_new(new_cstring(str), true);
+}
+
+static as_val *new_integer_val(int64_t value)
+{
+	Arena *arena = arena_current();
+	if (arena) {
+		as_integer *val = (as_integer *)arena->Alloc(sizeof(as_integer));
+		return (as_val *)as_integer_init(val, value);
+	}
+	return (as_val *)as_integer_new(value);
+}
+
+static as_val *new_double_val(double value)
+{
+	Arena *arena = arena_current();
+	if (arena) {
+		as_double *val = (as_double *)arena->Alloc(sizeof(as_double));
+		return (as_val *)as_double_init(val, value);
+	}
+	return (as_val *)as_double_new(value);
+}
+
+static as_val *new_boolean_val(bool value)
+{
+	Arena *arena = arena_current();
+	if (arena) {
+		as_boolean *val = (as_boolean *)arena->Alloc(sizeof(as_boolean));
+		return (as_val *)as_boolean_init(val, value);
+	}
+	return (as_val *)as_boolean_new(value);
+}
+
+static as_val *new_bytes_val(Local<Object> buffer)
+{
+	uint32_t size = (uint32_t)node::Buffer::Length(buffer);
+	Arena *arena = arena_current();
+	if (arena) {
+		as_bytes *val = (as_bytes *)arena->Alloc(sizeof(as_bytes));
+		uint8_t *data = (uint8_t *)arena->Alloc(size);
+		memcpy(data, node::Buffer::Data(buffer), size);
+		return (as_val *)as_bytes_init_wrap(val, data, size, false);
+	}
+	uint8_t *data = (uint8_t *)cf_malloc(size);
+	memcpy(data, node::Buffer::Data(buffer), size);
+	return (as_val *)as_bytes_new_wrap(data, size, true);
+}
+
+static as_val *new_geojson_val(Local<Value> v8value)
+{
+	Local<Value> strval =
+		Nan::Get(v8value.As<Object>(), Nan::New("str").ToLocalChecked())
+			.ToLocalChecked();
+	Nan::Utf8String str(strval);
+	Arena *arena = arena_current();
+	if (arena) {
+		as_geojson *val = (as_geojson *)arena->Alloc(sizeof(as_geojson));
+		return (as_val *)as_geojson_init(val, new_cstring(str), false);
+	}
+	return (as_val *)as_geojson_new(new_cstring(str), true);
+}
+
+// The element storage of lists and maps is always allocated by the C client.
+static as_arraylist *new_arraylist(uint32_t capacity)
+{
+	Arena *arena = arena_current();
+	if (arena) {
+		as_arraylist *list =
+			(as_arraylist *)arena->Alloc(sizeof(as_arraylist));
+		return as_arraylist_init(list, capacity, 0);
+	}
+	return as_arraylist_new(capacity, 0);
+}
+
+static as_orderedmap *new_orderedmap(uint32_t capacity)
+{
+	Arena *arena = arena_current();
+	if (arena) {
+		as_orderedmap *map =
+			(as_orderedmap *)arena->Alloc(sizeof(as_orderedmap));
+		return as_orderedmap_init(map, capacity);
+	}
+	return as_orderedmap_new(capacity);
+}
+
 int list_from_jsarray(as_list **list, Local<Array> array, const LogInfo *log)
 {
 	const uint32_t capacity = array->Length();
 	as_v8_detail(log, "Creating new as_arraylist with capacity %d", capacity);
-	as_arraylist *arraylist = as_arraylist_new(capacity, 0);
+	as_arraylist *arraylist = new_arraylist(capacity);
 	if (arraylist == NULL) {
 		as_v8_error(log, "List allocation failed");
 		Nan::ThrowError("List allocation failed");
@@ -1282,7 +1553,7 @@ int map_from_jsobject(as_map **map, Local<Object> obj, const LogInfo *log)
 		Nan::GetOwnPropertyNames(obj.As<Object>()).ToLocalChecked();
 	const uint32_t capacity = props->Length();
 	as_v8_detail(log, "Creating new as_orderedmap with capacity %d", capacity);
-	as_orderedmap *orderedmap = as_orderedmap_new(capacity);
+	as_orderedmap *orderedmap = new_orderedmap(capacity);
 	if (orderedmap == NULL) {
 		as_v8_error(log, "Map allocation failed");
 		Nan::ThrowError("Map allocation failed");
@@ -1296,7 +1567,7 @@ int map_from_jsobject(as_map **map, Local<Object> obj, const LogInfo *log)
 		if (asval_from_jsvalue(&val, value, log) != AS_NODE_PARAM_OK) {
 			return AS_NODE_PARAM_ERR;
 		}
-		as_stringmap_set(*map, *Nan::Utf8String(name), val);
+		as_map_set(*map, new_string_val(name), val);
 	}
 	return AS_NODE_PARAM_OK;
 }
@@ -1306,7 +1577,7 @@ int map_from_jsmap(as_map **map, Local<Map> obj, const LogInfo *log)
 	const Local<Array> data = obj->AsArray();
 	const uint32_t capacity = data->Length();
 	as_v8_detail(log, "Creating new as_orderedmap with capacity %d", capacity);
-	as_orderedmap *orderedmap = as_orderedmap_new(capacity);
+	as_orderedmap *orderedmap = new_orderedmap(capacity);
 	if (orderedmap == NULL) {
 		as_v8_error(log, "Map allocation failed");
 		Nan::ThrowError("Map allocation failed");
@@ -1345,24 +1616,22 @@ int asval_from_jsvalue(as_val **value, Local<Value> v8value, const LogInfo *log)
 		*value = (as_val *)&as_nil;
 	}
 	else if (v8value->IsBoolean()) {
-		*value = (as_val *)as_boolean_new(Nan::To<bool>(v8value).FromJust());
+		*value = new_boolean_val(Nan::To<bool>(v8value).FromJust());
 	}
 	else if (v8value->IsString()) {
-		*value =
-			(as_val *)as_string_new(strdup(*Nan::Utf8String(v8value)), true);
+		*value = new_string_val(v8value);
 	}
 	else if (v8value->IsInt32()) {
-		*value = (as_val *)as_integer_new(Nan::To<int32_t>(v8value).FromJust());
+		*value = new_integer_val(Nan::To<int32_t>(v8value).FromJust());
 	}
 	else if (v8value->IsUint32()) {
-		*value =
-			(as_val *)as_integer_new(Nan::To<uint32_t>(v8value).FromJust());
+		*value = new_integer_val(Nan::To<uint32_t>(v8value).FromJust());
 	}
 	else if (is_double_value(v8value)) {
-		*value = (as_val *)as_double_new(double_value(v8value));
+		*value = new_double_val(double_value(v8value));
 	}
 	else if (v8value->IsNumber()) {
-		*value = (as_val *)as_integer_new(Nan::To<int64_t>(v8value).FromJust());
+		*value = new_integer_val(Nan::To<int64_t>(v8value).FromJust());
 #if (NODE_MAJOR_VERSION > 10) ||                                               \
 	(NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 4)
 	}
@@ -1375,18 +1644,11 @@ int asval_from_jsvalue(as_val **value, Local<Value> v8value, const LogInfo *log)
 							 "converted to int64_t losslessly");
 			return AS_NODE_PARAM_ERR;
 		}
-		*value = (as_val *)as_integer_new(int64_value);
+		*value = new_integer_val(int64_value);
 #endif
 	}
 	else if (node::Buffer::HasInstance(v8value)) {
-		int size = 0;
-		uint8_t *data = NULL;
-		if (extract_blob_from_jsobject(&data, &size, v8value.As<Object>(),
-									   log) != AS_NODE_PARAM_OK) {
-			as_v8_error(log, "Extracting blob from a js object failed");
-			return AS_NODE_PARAM_ERR;
-		}
-		*value = (as_val *)as_bytes_new_wrap(data, size, true);
+		*value = new_bytes_val(v8value.As<Object>());
 	}
 	else if (v8value->IsArray()) {
 		if (list_from_jsarray((as_list **)value, Local<Array>::Cast(v8value),
@@ -1401,8 +1663,7 @@ int asval_from_jsvalue(as_val **value, Local<Value> v8value, const LogInfo *log)
 		}
 	}
 	else if (is_geojson_value(v8value)) {
-		char *jsonstr = geojson_as_string(v8value);
-		*value = (as_val *)as_geojson_new(jsonstr, true);
+		*value = new_geojson_val(v8value);
 	}
 	else { // generic object - treat as map
 		if (map_from_jsobject((as_map **)value, v8value.As<Object>(), log) !=
@@ -1537,7 +1798,8 @@ int recordbins_from_jsobject(as_record *rec, Local<Object> obj,
 			continue;
 		}
 		if (value->IsString()) {
-			as_record_set_strp(rec, *n, strdup(*Nan::Utf8String(value)), true);
+			as_record_set_strp(rec, *n, new_cstring(Nan::Utf8String(value)),
+							   arena_current() == NULL);
 			continue;
 		}
 		if (is_double_value(value)) {
@@ -1564,18 +1826,23 @@ int recordbins_from_jsobject(as_record *rec, Local<Object> obj,
 		}
 #endif
 		if (node::Buffer::HasInstance(value)) {
-			int size = 0;
+			int size = (int)node::Buffer::Length(value);
 			uint8_t *data = NULL;
-			if (extract_blob_from_jsobject(&data, &size, value.As<Object>(),
-										   log) != AS_NODE_PARAM_OK) {
-				as_v8_error(log, "Extractingb blob from a js object failed");
-				return AS_NODE_PARAM_ERR;
+			if (size >= (int)ZERO_COPY_MIN_SIZE) {
+				// The record is serialized while the command is submitted,
+				// i.e. while the bins object still references the Buffer, so
+				// its contents can be used without copying them.
+				data = (uint8_t *)node::Buffer::Data(value);
+				as_record_set_rawp(rec, *n, data, size, false);
+				continue;
 			}
-			as_record_set_rawp(rec, *n, data, size, true);
+			as_record_set_bytes(rec, *n,
+								(as_bytes *)new_bytes_val(value.As<Object>()));
 			continue;
 		}
 		if (is_geojson_value(value)) {
-			as_record_set_geojson_strp(rec, *n, geojson_as_string(value), true);
+			as_record_set_geojson(rec, *n,
+								  (as_geojson *)new_geojson_val(value));
 			continue;
 		}
 		if (value->IsArray()) {
@@ -2082,7 +2349,7 @@ Local<Object> key_to_jsobject(const as_key *key, const LogInfo *log)
 	obj = Nan::New<Object>();
 	if (strlen(key->ns) > 0) {
 		as_v8_detail(log, "key.ns = \"%s\"", key->ns);
-		Nan::Set(obj, Nan::New("ns").ToLocalChecked(),
+		Nan::Set(obj, AS_V8_NAME(ns),
 				 Nan::New(key->ns).ToLocalChecked());
 	}
 	else {
@@ -2091,7 +2358,7 @@ Local<Object> key_to_jsobject(const as_key *key, const LogInfo *log)
 
 	if (strlen(key->set) > 0) {
 		as_v8_detail(log, "key.set = \"%s\"", key->set);
-		Nan::Set(obj, Nan::New("set").ToLocalChecked(),
+		Nan::Set(obj, AS_V8_NAME(set),
 				 Nan::New(key->set).ToLocalChecked());
 	}
 	else {
@@ -2105,14 +2372,14 @@ Local<Object> key_to_jsobject(const as_key *key, const LogInfo *log)
 		case AS_INTEGER: {
 			as_integer *ival = as_integer_fromval(val);
 			as_v8_detail(log, "key.key = %d", as_integer_get(ival));
-			Nan::Set(obj, Nan::New("key").ToLocalChecked(),
+			Nan::Set(obj, AS_V8_NAME(key),
 					 Nan::New((double)as_integer_get(ival)));
 			break;
 		}
 		case AS_STRING: {
 			as_string *sval = as_string_fromval(val);
 			as_v8_detail(log, "key.key = \"%s\"", as_string_get(sval));
-			Nan::Set(obj, Nan::New("key").ToLocalChecked(),
+			Nan::Set(obj, AS_V8_NAME(key),
 					 Nan::New(as_string_get(sval)).ToLocalChecked());
 			break;
 		}
@@ -2123,7 +2390,7 @@ Local<Object> key_to_jsobject(const as_key *key, const LogInfo *log)
 				as_v8_detail(log, "key.key = \"%u\"", bval->value);
 				Local<Object> buff =
 					Nan::CopyBuffer((char *)bval->value, size).ToLocalChecked();
-				Nan::Set(obj, Nan::New("key").ToLocalChecked(), buff);
+				Nan::Set(obj, AS_V8_NAME(key), buff);
 				break;
 			}
 		}
@@ -2139,7 +2406,7 @@ Local<Object> key_to_jsobject(const as_key *key, const LogInfo *log)
 		Local<Object> buff =
 			Nan::CopyBuffer((char *)key->digest.value, AS_DIGEST_VALUE_SIZE)
 				.ToLocalChecked();
-		Nan::Set(obj, Nan::New("digest").ToLocalChecked(), buff);
+		Nan::Set(obj, AS_V8_NAME(digest), buff);
 	}
 
 	return scope.Escape(obj);
@@ -51,9 +51,13 @@ extern "C" {
 #include "conversions.h"
 #include "operations.h"
 #include "log.h"
+#include "memory_accounting.h"
 #include "enums.h"
 #include "string.h"
+#include "expressions.h"
 #include "policy.h"
+#include "property_names.h"
+#include "result_classes.h"
 
 using namespace node;
 using namespace v8;
@@ -62,7 +66,7 @@ void batch_read_record_free(as_batch_read_record *record, const LogInfo *log)
 {
 	if (record->policy) {
 		if (record->policy->filter_exp) {
-			as_exp_destroy(record->policy->filter_exp);
+			release_expression(record->policy->filter_exp);
 		}
 		cf_free((void *)record->policy);
 	}
@@ -151,7 +155,7 @@ void batch_write_record_free(as_batch_write_record *record, const LogInfo *log)
 {
 	if (record->policy) {
 		if (record->policy->filter_exp) {
-			as_exp_destroy(record->policy->filter_exp);
+			release_expression(record->policy->filter_exp);
 		}
 		cf_free((void *)record->policy);
 	}
@@ -213,7 +217,7 @@ void batch_apply_record_free(as_batch_apply_record *record, const LogInfo *log)
 {
 	if (record->policy) {
 		if (record->policy->filter_exp) {
-			as_exp_destroy(record->policy->filter_exp);
+			release_expression(record->policy->filter_exp);
 		}
 		cf_free((void *)record->policy);
 	}
@@ -276,7 +280,7 @@ void batch_remove_record_free(as_batch_remove_record *record,
 {
 	if (record->policy) {
 		if (record->policy->filter_exp) {
-			as_exp_destroy(record->policy->filter_exp);
+			release_expression(record->policy->filter_exp);
 		}
 		cf_free((void *)record->policy);
 	}
@@ -315,6 +319,25 @@ int batch_remove_record_from_jsobject(as_batch_records *batch_records,
 	return rc;
 }
 
+static inline size_t batch_records_size(const as_batch_records *records)
+{
+	return sizeof(as_batch_records) +
+		   (size_t)records->list.capacity * records->list.item_size;
+}
+
+as_batch_records *batch_records_create(uint32_t capacity)
+{
+	as_batch_records *records = as_batch_records_create(capacity);
+	memory_track_alloc(MEMORY_BATCH, batch_records_size(records));
+	return records;
+}
+
+void batch_records_destroy(as_batch_records *records)
+{
+	memory_track_free(MEMORY_BATCH, batch_records_size(records));
+	as_batch_records_destroy(records);
+}
+
 void batch_records_free(as_batch_records *records, const LogInfo *log)
 {
 	const as_vector *list = &records->list;
@@ -338,7 +361,7 @@ void batch_records_free(as_batch_records *records, const LogInfo *log)
 		}
 	}
 
-	as_batch_records_destroy(records);
+	batch_records_destroy(records);
 
 	return;
 }
@@ -350,7 +373,7 @@ int batch_records_from_jsarray(as_batch_records **records, Local<Array> arr,
 	uint32_t no_records = arr->Length();
 	uint32_t type = 0;
 
-	*records = as_batch_records_create(no_records);
+	*records = batch_records_create(no_records);
 
 	for (uint32_t i = 0; i < no_records; i++) {
 		Local<Object> obj = Nan::Get(arr, i).ToLocalChecked().As<Object>();
@@ -398,7 +421,7 @@ int batch_read_records_from_jsarray(as_batch_read_records **records,
 	int rc = AS_NODE_PARAM_OK;
 	uint32_t no_records = arr->Length();
 
-	*records = as_batch_read_create(no_records);
+	*records = batch_records_create(no_records);
 
 	for (uint32_t i = 0; i < no_records; i++) {
 		Local<Object> obj = Nan::Get(arr, i).ToLocalChecked().As<Object>();
@@ -416,32 +439,155 @@ int batch_read_records_from_jsarray(as_batch_read_records **records,
 	return rc;
 }
 
+int batch_read_records_from_keys(as_batch_records **records,
+								 Local<Array> keys, char **bin_names,
+								 uint32_t n_bin_names, bool read_all_bins,
+								 as_operations *ops,
+								 const as_policy_batch_read *policy,
+								 const LogInfo *log)
+{
+	int rc = AS_NODE_PARAM_OK;
+	uint32_t no_records = keys->Length();
+
+	*records = batch_records_create(no_records);
+
+	for (uint32_t i = 0; i < no_records; i++) {
+		as_batch_read_record *record = as_batch_read_reserve(*records);
+		Local<Object> key = Nan::Get(keys, i).ToLocalChecked().As<Object>();
+		if (key_from_jsobject(&record->key, key, log) != AS_NODE_PARAM_OK) {
+			as_v8_error(log, "Parsing batch key [%d] failed", i);
+			rc = AS_NODE_PARAM_ERR;
+			break;
+		}
+		// Bin names, operations and policy are shared by all records and owned
+		// by the caller.
+		record->bin_names = bin_names;
+		record->n_bin_names = n_bin_names;
+		record->read_all_bins = read_all_bins;
+		record->ops = ops;
+		record->policy = policy;
+	}
+
+	if (rc != AS_NODE_PARAM_OK) {
+		batch_records_destroy(*records);
+		*records = NULL;
+	}
+
+	return rc;
+}
+
+int batch_read_records_from_digests(as_batch_records **records,
+									const char *ns, const char *set,
+									const uint8_t *digests, uint32_t n_keys,
+									char **bin_names, uint32_t n_bin_names,
+									bool read_all_bins, as_operations *ops,
+									const as_policy_batch_read *policy,
+									const LogInfo *log)
+{
+	*records = batch_records_create(n_keys);
+
+	for (uint32_t i = 0; i < n_keys; i++) {
+		as_batch_read_record *record = as_batch_read_reserve(*records);
+		as_key_init_digest(&record->key, ns, set,
+						   digests + i * AS_DIGEST_VALUE_SIZE);
+		record->bin_names = bin_names;
+		record->n_bin_names = n_bin_names;
+		record->read_all_bins = read_all_bins;
+		record->ops = ops;
+		record->policy = policy;
+	}
+
+	as_v8_debug(log, "Built %u batch records from digests", n_keys);
+	return AS_NODE_PARAM_OK;
+}
+
+int batch_apply_records_from_keys(as_batch_records **records,
+								  Local<Array> keys,
+								  const as_policy_batch_apply *policy,
+								  const char *module, const char *function,
+								  as_list *arglist, const LogInfo *log)
+{
+	int rc = AS_NODE_PARAM_OK;
+	uint32_t no_records = keys->Length();
+
+	*records = batch_records_create(no_records);
+
+	for (uint32_t i = 0; i < no_records; i++) {
+		as_batch_apply_record *record = as_batch_apply_reserve(*records);
+		Local<Object> key = Nan::Get(keys, i).ToLocalChecked().As<Object>();
+		if (key_from_jsobject(&record->key, key, log) != AS_NODE_PARAM_OK) {
+			as_v8_error(log, "Parsing batch key [%d] failed", i);
+			rc = AS_NODE_PARAM_ERR;
+			break;
+		}
+		// Policy and UDF arguments are shared by all records and owned by the
+		// caller.
+		record->policy = policy;
+		record->module = module;
+		record->function = function;
+		record->arglist = arglist;
+	}
+
+	if (rc != AS_NODE_PARAM_OK) {
+		batch_records_destroy(*records);
+		*records = NULL;
+	}
+
+	return rc;
+}
+
+int batch_remove_records_from_keys(as_batch_records **records,
+								   Local<Array> keys,
+								   const as_policy_batch_remove *policy,
+								   const LogInfo *log)
+{
+	int rc = AS_NODE_PARAM_OK;
+	uint32_t no_records = keys->Length();
+
+	*records = batch_records_create(no_records);
+
+	for (uint32_t i = 0; i < no_records; i++) {
+		as_batch_remove_record *record = as_batch_remove_reserve(*records);
+		Local<Object> key = Nan::Get(keys, i).ToLocalChecked().As<Object>();
+		if (key_from_jsobject(&record->key, key, log) != AS_NODE_PARAM_OK) {
+			as_v8_error(log, "Parsing batch key [%d] failed", i);
+			rc = AS_NODE_PARAM_ERR;
+			break;
+		}
+		// Policy is shared by all records and owned by the caller.
+		record->policy = policy;
+	}
+
+	if (rc != AS_NODE_PARAM_OK) {
+		batch_records_destroy(*records);
+		*records = NULL;
+	}
+
+	return rc;
+}
+
 Local<Array> batch_records_to_jsarray(const as_batch_records *records,
-									  const LogInfo *log)
+									  const LogInfo *log, bool with_keys)
 {
 	Nan::EscapableHandleScope scope;
 	const as_vector *list = &records->list;
 	Local<Array> results = Nan::New<Array>(list->size);
 
 	for (uint32_t i = 0; i < list->size; i++) {
+		Nan::HandleScope record_scope;
 		as_batch_base_record *batch_record =
 			(as_batch_base_record *)as_vector_get((as_vector *)list, i);
 		as_status status = batch_record->result;
 		as_record *record = &batch_record->record;
 		as_key *key = &batch_record->key;
 
-		Local<Object> result = Nan::New<Object>();
-		Nan::Set(result, Nan::New("status").ToLocalChecked(), Nan::New(status));
-		Nan::Set(result, Nan::New("key").ToLocalChecked(),
-				 key_to_jsobject(key ? key : &record->key, log));
-		if (status == AEROSPIKE_OK) {
-			Nan::Set(result, Nan::New("meta").ToLocalChecked(),
-					 recordmeta_to_jsobject(record, log));
-			Nan::Set(result, Nan::New("bins").ToLocalChecked(),
-					 recordbins_to_jsobject(record, log));
-		}
-		Nan::Set(result, Nan::New("inDoubt").ToLocalChecked(),
-				batch_record->in_doubt ? Nan::True() : Nan::False());
+		Local<Value> jskey =
+			with_keys ? key_to_jskey(key ? key : &record->key, log)
+					  : Nan::Undefined().As<Value>();
+		Local<Value> jsrecord = record_to_jsrecord(
+			status == AEROSPIKE_OK ? record : NULL, jskey, log);
+		Local<Value> result =
+			batch_result_to_jsobject(status, jsrecord, batch_record->in_doubt);
 
 		Nan::Set(results, i, result);
 	}
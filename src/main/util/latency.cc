@@ -0,0 +1,296 @@
+/*******************************************************************************
+ * Copyright 2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <cstring>
+
+#include "latency.h"
+
+using namespace v8;
+
+//==========================================================
+// Local helpers.
+//
+
+static inline uint32_t highest_bit(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return 63 - __builtin_clzll(value);
+#else
+	uint32_t bit = 0;
+	while (value >>= 1) {
+		bit++;
+	}
+	return bit;
+#endif
+}
+
+static inline uint32_t bucket_index(uint64_t us)
+{
+	if (us < (1 << LATENCY_SUB_BITS)) {
+		return (uint32_t)us;
+	}
+	if (us >= ((uint64_t)1 << LATENCY_MAX_EXPONENT)) {
+		return LATENCY_BUCKETS - 1;
+	}
+	uint32_t exp = highest_bit(us);
+	uint32_t sub = (uint32_t)(us >> (exp - LATENCY_SUB_BITS)) &
+				   ((1 << LATENCY_SUB_BITS) - 1);
+	return (1 << LATENCY_SUB_BITS) +
+		   ((exp - LATENCY_SUB_BITS) << LATENCY_SUB_BITS) + sub;
+}
+
+// Returns the highest value recorded in the given bucket.
+static inline uint64_t bucket_value(uint32_t index)
+{
+	if (index < (1 << LATENCY_SUB_BITS)) {
+		return index;
+	}
+	uint32_t offset = index - (1 << LATENCY_SUB_BITS);
+	uint32_t shift = offset >> LATENCY_SUB_BITS;
+	uint64_t sub = offset & ((1 << LATENCY_SUB_BITS) - 1);
+	uint64_t low = ((1 << LATENCY_SUB_BITS) + sub) << shift;
+	return low + ((uint64_t)1 << shift) - 1;
+}
+
+static const char *latency_type_names[LATENCY_TYPE_COUNT] = {
+	"get", "put", "remove", "operate", "apply",
+	"batch", "scan", "query", "info"};
+
+static const char *latency_phase_names[LATENCY_PHASE_COUNT] = {
+	"request", "roundTrip", "response", "total"};
+
+//==========================================================
+// LatencyHistogram.
+//
+
+LatencyHistogram::LatencyHistogram() { Reset(); }
+
+void LatencyHistogram::Record(uint64_t us)
+{
+	buckets[bucket_index(us)].fetch_add(1, std::memory_order_relaxed);
+	count.fetch_add(1, std::memory_order_relaxed);
+	sum.fetch_add(us, std::memory_order_relaxed);
+
+	uint64_t current = max.load(std::memory_order_relaxed);
+	while (us > current &&
+		   !max.compare_exchange_weak(current, us, std::memory_order_relaxed)) {
+	}
+}
+
+void LatencyHistogram::Reset()
+{
+	for (uint32_t i = 0; i < LATENCY_BUCKETS; i++) {
+		buckets[i].store(0, std::memory_order_relaxed);
+	}
+	count.store(0, std::memory_order_relaxed);
+	sum.store(0, std::memory_order_relaxed);
+	max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::Percentile(uint64_t total, double percentile) const
+{
+	uint64_t rank = (uint64_t)(total * percentile);
+	if (rank >= total) {
+		rank = total - 1;
+	}
+
+	uint64_t seen = 0;
+	for (uint32_t i = 0; i < LATENCY_BUCKETS; i++) {
+		seen += buckets[i].load(std::memory_order_relaxed);
+		if (seen > rank) {
+			uint64_t value = bucket_value(i);
+			uint64_t highest = max.load(std::memory_order_relaxed);
+			return value < highest ? value : highest;
+		}
+	}
+	return max.load(std::memory_order_relaxed);
+}
+
+Local<Object> LatencyHistogram::ToJSObject() const
+{
+	Nan::EscapableHandleScope scope;
+	Local<Object> obj = Nan::New<Object>();
+	uint64_t total = count.load(std::memory_order_relaxed);
+
+	Nan::Set(obj, Nan::New("count").ToLocalChecked(),
+			 Nan::New((double)total));
+	if (total == 0) {
+		return scope.Escape(obj);
+	}
+
+	Nan::Set(obj, Nan::New("mean").ToLocalChecked(),
+			 Nan::New((double)sum.load(std::memory_order_relaxed) / total));
+	Nan::Set(obj, Nan::New("p50").ToLocalChecked(),
+			 Nan::New((double)Percentile(total, 0.5)));
+	Nan::Set(obj, Nan::New("p90").ToLocalChecked(),
+			 Nan::New((double)Percentile(total, 0.9)));
+	Nan::Set(obj, Nan::New("p99").ToLocalChecked(),
+			 Nan::New((double)Percentile(total, 0.99)));
+	Nan::Set(obj, Nan::New("p999").ToLocalChecked(),
+			 Nan::New((double)Percentile(total, 0.999)));
+	Nan::Set(obj, Nan::New("max").ToLocalChecked(),
+			 Nan::New((double)max.load(std::memory_order_relaxed)));
+	return scope.Escape(obj);
+}
+
+//==========================================================
+// LatencyStats.
+//
+
+LatencyStats::~LatencyStats()
+{
+	for (uint32_t i = 0; i < LATENCY_MAX_NAMESPACES; i++) {
+		delete namespaces[i].load();
+	}
+}
+
+LatencyStats::NamespaceStats *LatencyStats::Namespace(const char *ns)
+{
+	uint32_t size = namespaces_size.load(std::memory_order_acquire);
+	for (uint32_t i = 0; i < size; i++) {
+		NamespaceStats *stats = namespaces[i].load(std::memory_order_relaxed);
+		if (stats->ns == ns) {
+			return stats;
+		}
+	}
+
+	std::lock_guard<std::mutex> guard(namespaces_lock);
+	size = namespaces_size.load(std::memory_order_relaxed);
+	for (uint32_t i = 0; i < size; i++) {
+		NamespaceStats *stats = namespaces[i].load(std::memory_order_relaxed);
+		if (stats->ns == ns) {
+			return stats;
+		}
+	}
+	if (size == LATENCY_MAX_NAMESPACES) {
+		return NULL;
+	}
+
+	NamespaceStats *stats = new NamespaceStats();
+	stats->ns = ns;
+	namespaces[size].store(stats, std::memory_order_relaxed);
+	namespaces_size.store(size + 1, std::memory_order_release);
+	return stats;
+}
+
+void LatencyStats::Record(LatencyType type, const char *ns,
+						  const uint64_t *phases_us)
+{
+	if (type >= LATENCY_TYPE_COUNT) {
+		return;
+	}
+
+	for (int phase = 0; phase < LATENCY_PHASE_COUNT; phase++) {
+		histograms[type][phase].Record(phases_us[phase]);
+	}
+
+	if (ns && ns[0] != '\0') {
+		NamespaceStats *stats = Namespace(ns);
+		if (stats) {
+			stats->histograms[type].Record(phases_us[LATENCY_PHASE_TOTAL]);
+		}
+	}
+}
+
+void LatencyStats::Reset()
+{
+	for (int type = 0; type < LATENCY_TYPE_COUNT; type++) {
+		for (int phase = 0; phase < LATENCY_PHASE_COUNT; phase++) {
+			histograms[type][phase].Reset();
+		}
+	}
+
+	uint32_t size = namespaces_size.load(std::memory_order_acquire);
+	for (uint32_t i = 0; i < size; i++) {
+		NamespaceStats *stats = namespaces[i].load(std::memory_order_relaxed);
+		for (int type = 0; type < LATENCY_TYPE_COUNT; type++) {
+			stats->histograms[type].Reset();
+		}
+	}
+}
+
+Local<Object> LatencyStats::ToJSObject()
+{
+	Nan::EscapableHandleScope scope;
+	Local<Object> obj = Nan::New<Object>();
+
+	for (int type = 0; type < LATENCY_TYPE_COUNT; type++) {
+		Local<Object> phases = Nan::New<Object>();
+		for (int phase = 0; phase < LATENCY_PHASE_COUNT; phase++) {
+			Nan::Set(phases,
+					 Nan::New(latency_phase_names[phase]).ToLocalChecked(),
+					 histograms[type][phase].ToJSObject());
+		}
+		Nan::Set(obj, Nan::New(latency_type_names[type]).ToLocalChecked(),
+				 phases);
+	}
+
+	Local<Object> by_namespace = Nan::New<Object>();
+	uint32_t size = namespaces_size.load(std::memory_order_acquire);
+	for (uint32_t i = 0; i < size; i++) {
+		NamespaceStats *stats = namespaces[i].load(std::memory_order_relaxed);
+		Local<Object> types = Nan::New<Object>();
+		for (int type = 0; type < LATENCY_TYPE_COUNT; type++) {
+			Nan::Set(types, Nan::New(latency_type_names[type]).ToLocalChecked(),
+					 stats->histograms[type].ToJSObject());
+		}
+		Nan::Set(by_namespace, Nan::New(stats->ns).ToLocalChecked(), types);
+	}
+	Nan::Set(obj, Nan::New("namespaces").ToLocalChecked(), by_namespace);
+
+	return scope.Escape(obj);
+}
+
+//==========================================================
+// Public API.
+//
+
+LatencyType latency_type_from_name(const char *name)
+{
+	if (strcmp(name, "Get") == 0 || strcmp(name, "Select") == 0 ||
+		strcmp(name, "Exists") == 0) {
+		return LATENCY_GET;
+	}
+	if (strcmp(name, "Put") == 0) {
+		return LATENCY_PUT;
+	}
+	if (strcmp(name, "Remove") == 0) {
+		return LATENCY_REMOVE;
+	}
+	if (strcmp(name, "Operate") == 0) {
+		return LATENCY_OPERATE;
+	}
+	if (strcmp(name, "Apply") == 0) {
+		return LATENCY_APPLY;
+	}
+	if (strncmp(name, "Batch", 5) == 0) {
+		return LATENCY_BATCH;
+	}
+	if (strcmp(name, "Scan") == 0 || strcmp(name, "ScanBackground") == 0) {
+		return LATENCY_SCAN;
+	}
+	if (strcmp(name, "Query") == 0 || strcmp(name, "QueryApply") == 0 ||
+		strcmp(name, "QueryBackground") == 0 ||
+		strcmp(name, "QueryForeach") == 0) {
+		return LATENCY_QUERY;
+	}
+	if (strncmp(name, "Info", 4) == 0 || strcmp(name, "Truncate") == 0 ||
+		strcmp(name, "UdfRegister") == 0 || strcmp(name, "UdfRemove") == 0 ||
+		strcmp(name, "JobInfo") == 0) {
+		return LATENCY_INFO;
+	}
+	return LATENCY_NONE;
+}
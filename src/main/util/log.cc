@@ -18,6 +18,14 @@
 // Includes.
 //
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
 #include "time.h"
 
 extern "C" {
@@ -46,6 +54,31 @@ extern "C" {
 const char log_level_names[7][10] = {"OFF",	  "ERROR", "WARN", "INFO",
 									 "DEBUG", "TRACE", {0}};
 
+// Maximum length of a formatted log line, incl. the prefix.
+#define LOG_LINE_SIZE 1280
+
+// Size of the buffer the writer thread collects lines in before writing them.
+#define LOG_WRITE_BUFFER_SIZE (64 * 1024)
+
+typedef struct LogSlot {
+	std::atomic<size_t> seq;
+	FILE *fd;
+	uint32_t len;
+	char line[LOG_LINE_SIZE];
+} LogSlot;
+
+/**
+ * Bounded MPSC ring buffer of formatted log lines. Producers claim a slot by
+ * advancing tail and publish it by setting the slot's sequence number; the
+ * writer thread consumes slots in order starting at head.
+ */
+typedef struct LogRing {
+	LogSlot *slots;
+	size_t mask;
+	std::atomic<size_t> tail;
+	size_t head;
+} LogRing;
+
 //==========================================================
 // Forward declarations.
 //
@@ -53,12 +86,30 @@ const char log_level_names[7][10] = {"OFF",	  "ERROR", "WARN", "INFO",
 void _as_v8_log_function(const LogInfo *log, as_log_level level,
 						 const char *func, const char *file, uint32_t line,
 						 const char *fmt, va_list args);
+static void log_writer_run();
+static void log_writer_shutdown();
 
 //==========================================================
 // Globals.
 //
 
-LogInfo g_log_info = {stderr, AS_LOG_LEVEL_ERROR};
+thread_local LogInfo g_log_info = {stderr, AS_LOG_LEVEL_ERROR};
+
+// Log settings for messages logged by the C client. These are logged from the
+// C client's own threads and are not bound to any isolate.
+static LogInfo g_client_log_info = {stderr, AS_LOG_LEVEL_ERROR};
+
+// Async logging is process-wide: the ring and the writer thread are created
+// the first time it is enabled and live until the process exits.
+static std::atomic<bool> g_async_enabled(false);
+static std::atomic<bool> g_async_block(false);
+static std::atomic<uint64_t> g_async_dropped(0);
+static LogRing *g_log_ring = NULL;
+static std::thread *g_log_writer = NULL;
+static std::mutex g_log_writer_lock;
+static std::condition_variable g_log_writer_cond;
+static std::atomic<bool> g_log_writer_idle(false);
+static std::atomic<bool> g_log_writer_stop(false);
 
 //==========================================================
 // Inlines and macros.
@@ -73,11 +124,53 @@ bool as_log_callback_fnct(as_log_level level, const char *func,
 {
 	va_list args;
 	va_start(args, fmt);
-	_as_v8_log_function(&g_log_info, level, func, file, line, fmt, args);
+	_as_v8_log_function(&g_client_log_info, level, func, file, line, fmt,
+						args);
 	va_end(args);
 	return true;
 }
 
+void as_log_callback_set_log_info(const LogInfo *log)
+{
+	g_client_log_info = *log;
+}
+
+void as_v8_log_set_async(bool enabled, uint32_t buffer_size, bool block)
+{
+	std::lock_guard<std::mutex> guard(g_log_writer_lock);
+
+	if (enabled && g_log_ring == NULL) {
+		size_t capacity = 1;
+		while (capacity < buffer_size) {
+			capacity <<= 1;
+		}
+		if (capacity < 2) {
+			capacity = 2;
+		}
+
+		LogRing *ring = new LogRing();
+		ring->slots = new LogSlot[capacity];
+		for (size_t i = 0; i < capacity; i++) {
+			ring->slots[i].seq.store(i, std::memory_order_relaxed);
+		}
+		ring->mask = capacity - 1;
+		ring->tail.store(0, std::memory_order_relaxed);
+		ring->head = 0;
+		g_log_ring = ring;
+
+		g_log_writer = new std::thread(log_writer_run);
+		atexit(log_writer_shutdown);
+	}
+
+	g_async_block.store(block);
+	g_async_enabled.store(enabled);
+}
+
+uint64_t as_v8_log_dropped()
+{
+	return g_async_dropped.load(std::memory_order_relaxed);
+}
+
 void as_v8_log_function(const LogInfo *log, as_log_level level,
 						const char *func, const char *file, uint32_t line,
 						const char *fmt, ...)
@@ -97,6 +190,181 @@ const char *log_level_name(as_log_level level)
 	return log_level_names[level + 1];
 }
 
+/**
+ * Returns the formatted current time; it is only re-formatted once a second.
+ */
+static const char *log_timestamp()
+{
+	static thread_local time_t cached_time = 0;
+	static thread_local char cached_ts[64];
+
+	time_t now = time(NULL);
+	if (now != cached_time) {
+		struct tm nowtm;
+		as_gmtime(&now, &nowtm);
+		strftime(cached_ts, sizeof(cached_ts), "%b %d %Y %T %Z", &nowtm);
+		cached_time = now;
+	}
+	return cached_ts;
+}
+
+static uint32_t log_format(char *buf, size_t size, as_log_level level,
+						   const char *func, const char *file, uint32_t line,
+						   const char *fmt, va_list args)
+{
+	as_string file_string;
+	const char *filename = as_basename(&file_string, file);
+
+	int len = snprintf(buf, size, "%s: %-5s(%d) [%s:%u] [%s] - ",
+					   log_timestamp(), log_level_name(level), as_getpid(),
+					   filename, line, func);
+	if (len < 0) {
+		len = 0;
+	}
+	if ((size_t)len < size - 1) {
+		int msg_len = vsnprintf(buf + len, size - len - 1, fmt, args);
+		if (msg_len > 0) {
+			len += msg_len;
+		}
+	}
+	if ((size_t)len > size - 2) {
+		len = (int)size - 2;
+	}
+	buf[len++] = '\n';
+	buf[len] = '\0';
+	return (uint32_t)len;
+}
+
+static void log_writer_wakeup()
+{
+	if (g_log_writer_idle.load()) {
+		std::lock_guard<std::mutex> guard(g_log_writer_lock);
+		g_log_writer_cond.notify_one();
+	}
+}
+
+/**
+ * Formats the line into a free slot of the ring. Returns false if the ring is
+ * full and lines are to be dropped rather than waiting for the writer, which
+ * is always the case once the writer has been stopped at exit.
+ */
+static bool log_enqueue(LogRing *ring, FILE *fd, as_log_level level,
+						const char *func, const char *file, uint32_t line,
+						const char *fmt, va_list args)
+{
+	size_t pos = ring->tail.load(std::memory_order_relaxed);
+	LogSlot *slot;
+
+	while (true) {
+		slot = &ring->slots[pos & ring->mask];
+		size_t seq = slot->seq.load(std::memory_order_acquire);
+		intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+		if (diff == 0) {
+			if (ring->tail.compare_exchange_weak(pos, pos + 1,
+												 std::memory_order_relaxed)) {
+				break;
+			}
+		}
+		else if (diff < 0) {
+			if (!g_async_block.load(std::memory_order_relaxed) ||
+				g_log_writer_stop.load()) {
+				return false;
+			}
+			log_writer_wakeup();
+			std::this_thread::yield();
+			pos = ring->tail.load(std::memory_order_relaxed);
+		}
+		else {
+			pos = ring->tail.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->fd = fd;
+	slot->len = log_format(slot->line, LOG_LINE_SIZE, level, func, file, line,
+						   fmt, args);
+	slot->seq.store(pos + 1, std::memory_order_release);
+	log_writer_wakeup();
+	return true;
+}
+
+/**
+ * Writes all lines published so far, batching consecutive lines for the same
+ * file into a single write. Returns the number of lines written.
+ */
+static size_t log_writer_drain(LogRing *ring, char *buf)
+{
+	size_t count = 0;
+	size_t buf_len = 0;
+	FILE *buf_fd = NULL;
+
+	while (true) {
+		LogSlot *slot = &ring->slots[ring->head & ring->mask];
+		if (slot->seq.load(std::memory_order_acquire) != ring->head + 1) {
+			break;
+		}
+
+		if (buf_len > 0 && (slot->fd != buf_fd ||
+							buf_len + slot->len > LOG_WRITE_BUFFER_SIZE)) {
+			fwrite(buf, 1, buf_len, buf_fd);
+			fflush(buf_fd);
+			buf_len = 0;
+		}
+		buf_fd = slot->fd;
+		memcpy(buf + buf_len, slot->line, slot->len);
+		buf_len += slot->len;
+
+		slot->seq.store(ring->head + ring->mask + 1,
+						std::memory_order_release);
+		ring->head++;
+		count++;
+	}
+
+	if (buf_len > 0) {
+		fwrite(buf, 1, buf_len, buf_fd);
+		fflush(buf_fd);
+	}
+	return count;
+}
+
+static void log_writer_run()
+{
+	LogRing *ring = g_log_ring;
+	char *buf = (char *)malloc(LOG_WRITE_BUFFER_SIZE);
+
+	while (true) {
+		if (log_writer_drain(ring, buf) > 0) {
+			continue;
+		}
+
+		std::unique_lock<std::mutex> guard(g_log_writer_lock);
+		if (g_log_writer_stop.load()) {
+			break;
+		}
+		g_log_writer_idle.store(true);
+		// The timeout covers a line published between the check below and
+		// the idle flag becoming visible to its producer.
+		LogSlot *next = &ring->slots[ring->head & ring->mask];
+		if (next->seq.load(std::memory_order_acquire) != ring->head + 1) {
+			g_log_writer_cond.wait_for(guard, std::chrono::milliseconds(100));
+		}
+		g_log_writer_idle.store(false);
+	}
+
+	log_writer_drain(ring, buf);
+	free(buf);
+}
+
+static void log_writer_shutdown()
+{
+	{
+		std::lock_guard<std::mutex> guard(g_log_writer_lock);
+		g_log_writer_stop.store(true);
+		g_log_writer_cond.notify_one();
+	}
+	g_async_enabled.store(false);
+	g_log_writer->join();
+}
+
 void _as_v8_log_function(const LogInfo *log, as_log_level level,
 						 const char *func, const char *file, uint32_t line,
 						 const char *fmt, va_list args)
@@ -105,19 +373,17 @@ void _as_v8_log_function(const LogInfo *log, as_log_level level,
 		return;
 	}
 
-	char ts[64];
-	struct tm nowtm;
-	time_t now = time(NULL);
-	as_gmtime(&now, &nowtm);
-	strftime(ts, 64, "%b %d %Y %T %Z", &nowtm);
-
-	as_string file_string;
-	const char *filename = as_basename(&file_string, file);
-
-	char msg[1024];
-	vsnprintf(msg, 1024, fmt, args);
+	if (g_async_enabled.load(std::memory_order_relaxed)) {
+		if (!log_enqueue(g_log_ring, log->fd, level, func, file, line, fmt,
+						 args)) {
+			g_async_dropped.fetch_add(1, std::memory_order_relaxed);
+		}
+		return;
+	}
 
-	fprintf(log->fd, "%s: %-5s(%d) [%s:%u] [%s] - %s\n", ts,
-			log_level_name(level), as_getpid(), filename, line, func, msg);
+	char buf[LOG_LINE_SIZE];
+	uint32_t len =
+		log_format(buf, sizeof(buf), level, func, file, line, fmt, args);
+	fwrite(buf, 1, len, log->fd);
 	fflush(log->fd);
 }
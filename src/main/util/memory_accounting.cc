@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * Copyright 2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <atomic>
+#include <cstdint>
+
+#include "memory_accounting.h"
+
+extern "C" {
+#include <aerospike/as_bytes.h>
+#include <aerospike/as_geojson.h>
+#include <aerospike/as_list.h>
+#include <aerospike/as_map.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_string.h>
+}
+
+using namespace v8;
+
+// Estimated overhead of a value, in addition to its data.
+#define VALUE_OVERHEAD 16
+
+//==========================================================
+// Globals.
+//
+
+struct subsystem_info {
+	const char *name;
+	// Whether allocations are reported to V8 as external memory.
+	bool external;
+};
+
+static const subsystem_info g_subsystems[MEMORY_SUBSYSTEMS] = {
+	{"conversion", true},
+	{"batch", false},
+	{"scanQueue", false},
+	{"txn", true},
+	{"expression", true},
+	{"cache", true}};
+
+struct subsystem_counters {
+	std::atomic<int64_t> bytes{0};
+	std::atomic<int64_t> count{0};
+};
+
+static subsystem_counters g_counters[MEMORY_SUBSYSTEMS];
+
+//==========================================================
+// Local helpers.
+//
+
+// Reports a change of external memory to the isolate of the calling thread,
+// if it has one; there is none on C client threads, or once the isolate has
+// been torn down.
+static void adjust_external_memory(int64_t change)
+{
+	if (Isolate::GetCurrent() == NULL) {
+		return;
+	}
+	Nan::AdjustExternalMemory((int)change);
+}
+
+static bool add_list_value_size(as_val *val, void *udata)
+{
+	*(size_t *)udata += memory_val_size(val);
+	return true;
+}
+
+static bool add_map_value_size(const as_val *key, const as_val *val,
+							   void *udata)
+{
+	*(size_t *)udata += memory_val_size(key) + memory_val_size(val);
+	return true;
+}
+
+//==========================================================
+// Public API.
+//
+
+void memory_track_alloc(memory_subsystem subsystem, size_t size)
+{
+	subsystem_counters &counters = g_counters[subsystem];
+	counters.bytes.fetch_add((int64_t)size, std::memory_order_relaxed);
+	counters.count.fetch_add(1, std::memory_order_relaxed);
+	if (g_subsystems[subsystem].external) {
+		adjust_external_memory((int64_t)size);
+	}
+}
+
+void memory_track_free(memory_subsystem subsystem, size_t size)
+{
+	subsystem_counters &counters = g_counters[subsystem];
+	counters.bytes.fetch_sub((int64_t)size, std::memory_order_relaxed);
+	counters.count.fetch_sub(1, std::memory_order_relaxed);
+	if (g_subsystems[subsystem].external) {
+		adjust_external_memory(-(int64_t)size);
+	}
+}
+
+size_t memory_val_size(const as_val *val)
+{
+	size_t size = VALUE_OVERHEAD;
+	if (!val) {
+		return size;
+	}
+	switch (as_val_type(val)) {
+	case AS_STRING:
+		size += as_string_len((as_string *)val);
+		break;
+	case AS_BYTES:
+		size += as_bytes_size((as_bytes *)val);
+		break;
+	case AS_GEOJSON:
+		size += as_geojson_len((as_geojson *)val);
+		break;
+	case AS_LIST:
+		as_list_foreach((as_list *)val, add_list_value_size, &size);
+		break;
+	case AS_MAP:
+		as_map_foreach((as_map *)val, add_map_value_size, &size);
+		break;
+	case AS_REC: {
+		as_record *record = (as_record *)val;
+		size += sizeof(as_record);
+		for (uint16_t i = 0; i < record->bins.size; i++) {
+			as_bin *bin = &record->bins.entries[i];
+			size += sizeof(as_bin) + memory_val_size((as_val *)bin->valuep);
+		}
+		break;
+	}
+	default:
+		break;
+	}
+	return size;
+}
+
+Local<Object> memory_stats_to_jsobject()
+{
+	Nan::EscapableHandleScope scope;
+	Local<Object> obj = Nan::New<Object>();
+
+	for (int i = 0; i < MEMORY_SUBSYSTEMS; i++) {
+		Local<Object> subsystem = Nan::New<Object>();
+		Nan::Set(subsystem, Nan::New("bytes").ToLocalChecked(),
+				 Nan::New((double)g_counters[i].bytes.load(
+					 std::memory_order_relaxed)));
+		Nan::Set(subsystem, Nan::New("count").ToLocalChecked(),
+				 Nan::New((double)g_counters[i].count.load(
+					 std::memory_order_relaxed)));
+		Nan::Set(obj, Nan::New(g_subsystems[i].name).ToLocalChecked(),
+				 subsystem);
+	}
+	return scope.Escape(obj);
+}
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ * Copyright 2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <node.h>
+#include <nan.h>
+
+#include "property_names.h"
+
+using namespace v8;
+
+// Every isolate runs on its own thread, so a thread-local table gives each
+// isolate (main thread or worker thread) its own set of handles.
+static thread_local PropertyNames *g_property_names = NULL;
+
+static Local<String> internalize(Isolate *isolate, const char *name)
+{
+	return String::NewFromUtf8(isolate, name, NewStringType::kInternalized)
+		.ToLocalChecked();
+}
+
+static void property_names_cleanup(void *arg)
+{
+	PropertyNames *names = reinterpret_cast<PropertyNames *>(arg);
+#define AS_V8_PROPERTY_NAME_RESET(__name) names->__name.Reset();
+	AS_V8_PROPERTY_NAMES(AS_V8_PROPERTY_NAME_RESET)
+#undef AS_V8_PROPERTY_NAME_RESET
+	if (g_property_names == names) {
+		g_property_names = NULL;
+	}
+	delete names;
+}
+
+void property_names_init()
+{
+	Nan::HandleScope scope;
+	Isolate *isolate = Isolate::GetCurrent();
+
+	if (g_property_names != NULL) {
+		return;
+	}
+
+	PropertyNames *names = new PropertyNames();
+#define AS_V8_PROPERTY_NAME_INIT(__name)                                       \
+	names->__name.Reset(internalize(isolate, #__name));
+	AS_V8_PROPERTY_NAMES(AS_V8_PROPERTY_NAME_INIT)
+#undef AS_V8_PROPERTY_NAME_INIT
+
+	g_property_names = names;
+	node::AddEnvironmentCleanupHook(isolate, property_names_cleanup, names);
+}
+
+const PropertyNames *property_names() { return g_property_names; }
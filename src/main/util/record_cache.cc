@@ -0,0 +1,394 @@
+/*******************************************************************************
+ * Copyright 2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <cstring>
+#include <iterator>
+#include <uv.h>
+
+#include "record_cache.h"
+#include "conversions.h"
+#include "memory_accounting.h"
+
+extern "C" {
+#include <aerospike/as_bytes.h>
+#include <aerospike/as_geojson.h>
+#include <aerospike/as_list.h>
+#include <aerospike/as_map.h>
+#include <aerospike/as_string.h>
+}
+
+using namespace v8;
+
+// Estimated overhead of an entry and of a bin, in addition to their values.
+#define ENTRY_OVERHEAD 128
+#define BIN_OVERHEAD 32
+#define VALUE_OVERHEAD 16
+
+//==========================================================
+// Local helpers.
+//
+
+static size_t retain_value(const as_val *val, bool nested);
+
+static bool retain_list_value(as_val *val, void *udata)
+{
+	*(size_t *)udata += retain_value(val, true);
+	return true;
+}
+
+static bool retain_map_value(const as_val *key, const as_val *val,
+							 void *udata)
+{
+	*(size_t *)udata += retain_value(key, true) + retain_value(val, true);
+	return true;
+}
+
+/**
+ *  Estimates the memory held by a value, and takes an additional reference to
+ *  the byte values nested in lists and maps: the conversion to JS hands the
+ *  memory of a byte value over to a Buffer if it holds the only reference,
+ *  which must not happen to values shared with the cache.
+ */
+static size_t retain_value(const as_val *val, bool nested)
+{
+	size_t size = VALUE_OVERHEAD;
+	if (!val) {
+		return size;
+	}
+	switch (as_val_type(val)) {
+	case AS_STRING:
+		size += as_string_len((as_string *)val);
+		break;
+	case AS_BYTES:
+		size += as_bytes_size((as_bytes *)val);
+		if (nested) {
+			as_val_reserve((as_val *)val);
+		}
+		break;
+	case AS_GEOJSON:
+		size += as_geojson_len((as_geojson *)val);
+		break;
+	case AS_LIST:
+		as_list_foreach((as_list *)val, retain_list_value, &size);
+		break;
+	case AS_MAP:
+		as_map_foreach((as_map *)val, retain_map_value, &size);
+		break;
+	default:
+		break;
+	}
+	return size;
+}
+
+static bool release_list_value(as_val *val, void *udata);
+static bool release_map_value(const as_val *key, const as_val *val,
+							  void *udata);
+
+// Releases the references taken by retain_value on nested byte values.
+static void release_value(const as_val *val, bool nested)
+{
+	if (!val) {
+		return;
+	}
+	switch (as_val_type(val)) {
+	case AS_BYTES:
+		if (nested) {
+			as_val_destroy((as_val *)val);
+		}
+		break;
+	case AS_LIST:
+		as_list_foreach((as_list *)val, release_list_value, NULL);
+		break;
+	case AS_MAP:
+		as_map_foreach((as_map *)val, release_map_value, NULL);
+		break;
+	default:
+		break;
+	}
+}
+
+static bool release_list_value(as_val *val, void *udata)
+{
+	release_value(val, true);
+	return true;
+}
+
+static bool release_map_value(const as_val *key, const as_val *val,
+							  void *udata)
+{
+	release_value(key, true);
+	release_value(val, true);
+	return true;
+}
+
+static void destroy_record(as_record *record)
+{
+	for (uint16_t i = 0; i < record->bins.size; i++) {
+		release_value((as_val *)record->bins.entries[i].valuep, false);
+	}
+	as_record_destroy(record);
+}
+
+static inline void record_set(as_record *record, const char *name,
+							  as_bin_value *value)
+{
+	as_val_reserve((as_val *)value);
+	as_record_set(record, name, value);
+}
+
+//==========================================================
+// RecordCache.
+//
+
+RecordCache::RecordCache(uint64_t max_memory, uint32_t max_staleness_ms,
+						 uint32_t n_shards)
+	: shards(n_shards > 0 ? n_shards : 1),
+	  shard_max_memory(max_memory / shards.size()),
+	  max_staleness_ns((uint64_t)max_staleness_ms * 1000000)
+{
+}
+
+RecordCache::~RecordCache()
+{
+	for (Shard &shard : shards) {
+		for (Entry &entry : shard.lru) {
+			memory_track_free(MEMORY_CACHE, entry.size);
+			destroy_record(entry.record);
+		}
+	}
+}
+
+bool RecordCache::Cacheable(const as_policy_read *policy)
+{
+	return !policy->base.filter_exp && !policy->base.txn &&
+		   policy->deserialize && policy->read_touch_ttl_percent == 0;
+}
+
+bool RecordCache::Cacheable(const as_policy_batch *policy)
+{
+	return !policy->base.filter_exp && !policy->base.txn &&
+		   policy->deserialize && policy->read_touch_ttl_percent == 0;
+}
+
+bool RecordCache::Cacheable(const as_batch_read_record *record)
+{
+	return record->type == AS_BATCH_READ && !record->ops &&
+		   (!record->policy || (!record->policy->filter_exp &&
+								record->policy->read_touch_ttl_percent == 0));
+}
+
+bool RecordCache::CacheKey(as_key *key, std::string *out)
+{
+	as_digest *digest = as_key_digest(key);
+	if (!digest) {
+		return false;
+	}
+	out->assign(key->ns);
+	out->push_back('\0');
+	out->append((const char *)digest->value, AS_DIGEST_VALUE_SIZE);
+	return true;
+}
+
+RecordCache::Shard &RecordCache::ShardOf(const std::string &key)
+{
+	// The digest is uniformly distributed; use its last bytes.
+	uint32_t hash;
+	memcpy(&hash, key.data() + key.size() - sizeof(hash), sizeof(hash));
+	return shards[hash % shards.size()];
+}
+
+void RecordCache::Remove(Shard &shard, std::list<Entry>::iterator it)
+{
+	destroy_record(it->record);
+	shard.memory -= it->size;
+	memory_track_free(MEMORY_CACHE, it->size);
+	shard.index.erase(it->key);
+	shard.lru.erase(it);
+}
+
+bool RecordCache::Get(as_key *key, bool all_bins, const char *const *bins,
+					  uint32_t n_bins, as_record *out)
+{
+	std::string cache_key;
+	if (!CacheKey(key, &cache_key)) {
+		return false;
+	}
+
+	Shard &shard = ShardOf(cache_key);
+	std::lock_guard<std::mutex> guard(shard.lock);
+
+	auto found = shard.index.find(cache_key);
+	if (found == shard.index.end()) {
+		misses.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	auto it = found->second;
+	uint64_t now = uv_hrtime();
+	if (now >= it->expires_ns) {
+		Remove(shard, it);
+		misses.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	shard.lru.splice(shard.lru.begin(), shard.lru, it);
+
+	const as_record *record = it->record;
+	if (all_bins) {
+		as_record_init(out, record->bins.size);
+		for (uint16_t i = 0; i < record->bins.size; i++) {
+			as_bin *bin = &record->bins.entries[i];
+			record_set(out, bin->name, bin->valuep);
+		}
+	}
+	else {
+		as_record_init(out, n_bins);
+		for (uint32_t i = 0; i < n_bins; i++) {
+			as_bin_value *value =
+				as_record_get((as_record *)record, bins[i]);
+			if (value) {
+				record_set(out, bins[i], value);
+			}
+		}
+	}
+	out->gen = record->gen;
+	if (it->void_time_ns == 0) {
+		out->ttl = AS_RECORD_NO_EXPIRE_TTL;
+	}
+	else {
+		out->ttl = (uint32_t)((it->void_time_ns - now + 999999999) /
+							  1000000000);
+	}
+
+	hits.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+void RecordCache::Put(as_key *key, const as_record *record, uint64_t since)
+{
+	if (Epoch() != since) {
+		return;
+	}
+
+	std::string cache_key;
+	if (!CacheKey(key, &cache_key)) {
+		return;
+	}
+
+	uint64_t now = uv_hrtime();
+	Entry entry;
+	entry.key = cache_key;
+	entry.expires_ns = now + max_staleness_ns;
+	entry.void_time_ns = 0;
+	if (record->ttl != AS_RECORD_NO_EXPIRE_TTL) {
+		entry.void_time_ns = now + (uint64_t)record->ttl * 1000000000;
+		if (entry.void_time_ns < entry.expires_ns) {
+			entry.expires_ns = entry.void_time_ns;
+		}
+	}
+	entry.record = as_record_new(record->bins.size);
+	entry.size = ENTRY_OVERHEAD;
+	for (uint16_t i = 0; i < record->bins.size; i++) {
+		as_bin *bin = &record->bins.entries[i];
+		as_bin_value *value = bin->valuep;
+		if (value == &bin->value) {
+			// Scalar values of response records are stored inline, in bins
+			// freed with the record once its listener returns.
+			value = (as_bin_value *)asval_copy_inline((as_val *)value);
+			if (!value) {
+				destroy_record(entry.record);
+				return;
+			}
+			as_record_set(entry.record, bin->name, value);
+		}
+		else {
+			record_set(entry.record, bin->name, value);
+		}
+		entry.size += BIN_OVERHEAD + retain_value((as_val *)value, false);
+	}
+	entry.record->gen = record->gen;
+	size_t size = entry.size;
+	if (size > shard_max_memory) {
+		destroy_record(entry.record);
+		return;
+	}
+
+	Shard &shard = ShardOf(cache_key);
+	std::lock_guard<std::mutex> guard(shard.lock);
+
+	// Checked again under the lock, as invalidations take the lock after
+	// incrementing the epoch.
+	if (Epoch() != since) {
+		destroy_record(entry.record);
+		return;
+	}
+
+	auto found = shard.index.find(cache_key);
+	if (found != shard.index.end()) {
+		Remove(shard, found->second);
+	}
+	while (shard.memory + size > shard_max_memory && !shard.lru.empty()) {
+		Remove(shard, std::prev(shard.lru.end()));
+		evictions.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	shard.lru.push_front(std::move(entry));
+	shard.index.emplace(cache_key, shard.lru.begin());
+	shard.memory += size;
+	memory_track_alloc(MEMORY_CACHE, size);
+}
+
+void RecordCache::Invalidate(as_key *key)
+{
+	std::string cache_key;
+	if (!CacheKey(key, &cache_key)) {
+		return;
+	}
+
+	epoch.fetch_add(1, std::memory_order_acq_rel);
+
+	Shard &shard = ShardOf(cache_key);
+	std::lock_guard<std::mutex> guard(shard.lock);
+	auto found = shard.index.find(cache_key);
+	if (found != shard.index.end()) {
+		Remove(shard, found->second);
+	}
+}
+
+Local<Object> RecordCache::ToJSObject()
+{
+	Nan::EscapableHandleScope scope;
+	Local<Object> obj = Nan::New<Object>();
+	size_t entries = 0;
+	size_t memory = 0;
+
+	for (Shard &shard : shards) {
+		std::lock_guard<std::mutex> guard(shard.lock);
+		entries += shard.lru.size();
+		memory += shard.memory;
+	}
+
+	Nan::Set(obj, Nan::New("hits").ToLocalChecked(),
+			 Nan::New((double)hits.load(std::memory_order_relaxed)));
+	Nan::Set(obj, Nan::New("misses").ToLocalChecked(),
+			 Nan::New((double)misses.load(std::memory_order_relaxed)));
+	Nan::Set(obj, Nan::New("evictions").ToLocalChecked(),
+			 Nan::New((double)evictions.load(std::memory_order_relaxed)));
+	Nan::Set(obj, Nan::New("entries").ToLocalChecked(),
+			 Nan::New((double)entries));
+	Nan::Set(obj, Nan::New("memory").ToLocalChecked(),
+			 Nan::New((double)memory));
+	return scope.Escape(obj);
+}
@@ -0,0 +1,207 @@
+/*******************************************************************************
+ * Copyright 2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <cstring>
+#include <node.h>
+#include <nan.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "log.h"
+#include "property_names.h"
+#include "result_classes.h"
+
+extern "C" {
+#include <aerospike/as_bytes.h>
+#include <aerospike/as_integer.h>
+#include <aerospike/as_string.h>
+}
+
+using namespace v8;
+
+typedef struct ResultClasses {
+	Nan::Persistent<Function> key;
+	Nan::Persistent<Function> record;
+	Nan::Persistent<Function> batch_result;
+} ResultClasses;
+
+// Every isolate, i.e. the main thread and each worker thread, loads its own
+// copy of the JS classes.
+static thread_local ResultClasses *g_result_classes = NULL;
+
+static void result_classes_cleanup(void *arg)
+{
+	ResultClasses *classes = reinterpret_cast<ResultClasses *>(arg);
+	classes->key.Reset();
+	classes->record.Reset();
+	classes->batch_result.Reset();
+	if (g_result_classes == classes) {
+		g_result_classes = NULL;
+	}
+	delete classes;
+}
+
+NAN_METHOD(register_result_classes)
+{
+	TYPE_CHECK_REQ(info[0], IsFunction, "Key class must be a function");
+	TYPE_CHECK_REQ(info[1], IsFunction, "Record class must be a function");
+	TYPE_CHECK_REQ(info[2], IsFunction,
+				   "BatchResult class must be a function");
+
+	if (g_result_classes == NULL) {
+		g_result_classes = new ResultClasses();
+		node::AddEnvironmentCleanupHook(
+			Isolate::GetCurrent(), result_classes_cleanup, g_result_classes);
+	}
+
+	g_result_classes->key.Reset(info[0].As<Function>());
+	g_result_classes->record.Reset(info[1].As<Function>());
+	g_result_classes->batch_result.Reset(info[2].As<Function>());
+}
+
+/**
+ * Calls the constructor. If it throws, the exception is reported as uncaught,
+ * the same as an exception thrown by a command callback, and an empty handle
+ * is returned.
+ */
+static Local<Value> construct(const Nan::Persistent<Function> &cons, int argc,
+							  Local<Value> argv[])
+{
+	Nan::EscapableHandleScope scope;
+	Nan::TryCatch try_catch;
+	Nan::MaybeLocal<Object> instance =
+		Nan::NewInstance(Nan::New(cons), argc, argv);
+	if (try_catch.HasCaught()) {
+		Nan::FatalException(try_catch);
+		return scope.Escape(Local<Value>());
+	}
+	if (instance.IsEmpty()) {
+		return scope.Escape(Local<Value>());
+	}
+	return scope.Escape(instance.ToLocalChecked());
+}
+
+static Local<Value> key_value_to_jsvalue(const as_key *key)
+{
+	Nan::EscapableHandleScope scope;
+	as_val *val = (as_val *)key->valuep;
+
+	if (val) {
+		switch (as_val_type(val)) {
+		case AS_INTEGER:
+			return scope.Escape(
+				Nan::New((double)as_integer_get(as_integer_fromval(val))));
+		case AS_STRING:
+			return scope.Escape(
+				Nan::New(as_string_get(as_string_fromval(val)))
+					.ToLocalChecked());
+		case AS_BYTES: {
+			as_bytes *bval = as_bytes_fromval(val);
+			return scope.Escape(Nan::CopyBuffer((char *)bval->value,
+												as_bytes_size(bval))
+									.ToLocalChecked());
+		}
+		default:
+			break;
+		}
+	}
+
+	return scope.Escape(Nan::Undefined());
+}
+
+Local<Value> key_to_jskey(const as_key *key, const LogInfo *log)
+{
+	Nan::EscapableHandleScope scope;
+
+	if (g_result_classes == NULL) {
+		return scope.Escape(key_to_jsobject(key, log));
+	}
+
+	Local<Value> argv[] = {
+		Nan::New(key->ns).ToLocalChecked(),
+		strlen(key->set) > 0
+			? Nan::New(key->set).ToLocalChecked().As<Value>()
+			: Nan::Undefined().As<Value>(),
+		key_value_to_jsvalue(key),
+		key->digest.init
+			? Nan::CopyBuffer((char *)key->digest.value, AS_DIGEST_VALUE_SIZE)
+				  .ToLocalChecked()
+				  .As<Value>()
+			: Nan::Undefined().As<Value>()};
+	Local<Value> jskey = construct(g_result_classes->key, 4, argv);
+	if (jskey.IsEmpty()) {
+		as_v8_error(log, "Key constructor failed, returning plain key object");
+		return scope.Escape(key_to_jsobject(key, log));
+	}
+
+	return scope.Escape(jskey);
+}
+
+Local<Value> record_to_jsrecord(const as_record *record, Local<Value> key,
+								const LogInfo *log)
+{
+	Nan::EscapableHandleScope scope;
+	Local<Value> bins = Nan::Undefined();
+	Local<Value> jsrecord;
+
+	if (record) {
+		bins = recordbins_to_jsobject(record, log);
+	}
+
+	// The metadata is set on the instance, which the constructor initializes
+	// to undefined, instead of being passed in an object of its own.
+	if (g_result_classes) {
+		Local<Value> argv[] = {key, bins};
+		jsrecord = construct(g_result_classes->record, 2, argv);
+	}
+
+	if (jsrecord.IsEmpty()) {
+		Local<Object> obj = Nan::New<Object>();
+		Nan::Set(obj, AS_V8_NAME(key), key);
+		Nan::Set(obj, AS_V8_NAME(bins), bins);
+		jsrecord = obj;
+	}
+
+	if (record) {
+		Local<Object> obj = jsrecord.As<Object>();
+		Nan::Set(obj, AS_V8_NAME(ttl), recordttl_to_jsnumber(record));
+		Nan::Set(obj, AS_V8_NAME(gen), Nan::New(record->gen));
+	}
+
+	return scope.Escape(jsrecord);
+}
+
+Local<Value> batch_result_to_jsobject(as_status status, Local<Value> record,
+									  bool in_doubt)
+{
+	Nan::EscapableHandleScope scope;
+	Local<Value> argv[] = {Nan::New(status), record, Nan::New(in_doubt)};
+	Local<Value> result;
+
+	if (g_result_classes) {
+		result = construct(g_result_classes->batch_result, 3, argv);
+	}
+
+	if (result.IsEmpty()) {
+		Local<Object> obj = Nan::New<Object>();
+		Nan::Set(obj, AS_V8_NAME(status), argv[0]);
+		Nan::Set(obj, AS_V8_NAME(record), record);
+		Nan::Set(obj, AS_V8_NAME(inDoubt), argv[2]);
+		result = obj;
+	}
+
+	return scope.Escape(result);
+}
@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * Copyright 2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <cstring>
+#include <node.h>
+#include <nan.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "value_classes.h"
+
+using namespace v8;
+
+static const char *value_class_names[VALUE_CLASS_COUNT] = {"Double",
+														   "GeoJSON", "Bin"};
+
+typedef struct ValueClasses {
+	Nan::Persistent<Function> classes[VALUE_CLASS_COUNT];
+} ValueClasses;
+
+// Every isolate, i.e. the main thread and each worker thread, loads its own
+// copy of the JS classes.
+static thread_local ValueClasses *g_value_classes = NULL;
+
+static void value_classes_cleanup(void *arg)
+{
+	ValueClasses *classes = reinterpret_cast<ValueClasses *>(arg);
+	for (int i = 0; i < VALUE_CLASS_COUNT; i++) {
+		classes->classes[i].Reset();
+	}
+	if (g_value_classes == classes) {
+		g_value_classes = NULL;
+	}
+	delete classes;
+}
+
+NAN_METHOD(register_value_classes)
+{
+	TYPE_CHECK_REQ(info[0], IsFunction, "Double class must be a function");
+	TYPE_CHECK_REQ(info[1], IsFunction, "GeoJSON class must be a function");
+	TYPE_CHECK_REQ(info[2], IsFunction, "Bin class must be a function");
+
+	if (g_value_classes == NULL) {
+		g_value_classes = new ValueClasses();
+		node::AddEnvironmentCleanupHook(
+			Isolate::GetCurrent(), value_classes_cleanup, g_value_classes);
+	}
+
+	for (int i = 0; i < VALUE_CLASS_COUNT; i++) {
+		g_value_classes->classes[i].Reset(info[i].As<Function>());
+	}
+}
+
+bool is_value_class_instance(Local<Value> value, ValueClass type)
+{
+	if (!value->IsObject()) {
+		return false;
+	}
+
+	if (g_value_classes == NULL) {
+		return instanceof (value, value_class_names[type]);
+	}
+
+	Nan::HandleScope scope;
+	Local<Function> cons = Nan::New(g_value_classes->classes[type]);
+	return value.As<Object>()
+		->InstanceOf(Nan::GetCurrentContext(), cons)
+		.FromMaybe(false);
+}
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * Copyright 2013-2024 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+
+#include "value_queue.h"
+#include "memory_accounting.h"
+
+ValueQueue::ValueQueue(uint32_t capacity) : slots(capacity > 0 ? capacity : 1)
+{
+}
+
+ValueQueue::~ValueQueue()
+{
+	uint32_t capacity = (uint32_t)slots.size();
+	for (uint32_t i = 0; i < count; i++) {
+		Slot &slot = slots[(head + i) % capacity];
+		memory_track_free(MEMORY_SCAN_QUEUE, slot.size);
+		as_val_destroy(slot.val);
+	}
+}
+
+/**
+ *  Appends val to the queue, waiting for the consumer to make room if the
+ *  queue is full. Sets wakeup if the consumer needs to be signalled. Returns
+ *  false if the queue has been closed; val is left to the caller then.
+ */
+bool ValueQueue::Push(as_val *val, bool *wakeup)
+{
+	size_t size = memory_val_size(val);
+	std::unique_lock<std::mutex> guard(lock);
+	uint32_t capacity = (uint32_t)slots.size();
+	not_full.wait(guard, [&] { return count < capacity || closed; });
+	if (closed) {
+		*wakeup = false;
+		return false;
+	}
+
+	slots[(head + count) % capacity] = {val, size};
+	count++;
+	memory_track_alloc(MEMORY_SCAN_QUEUE, size);
+	*wakeup = !wakeup_pending;
+	wakeup_pending = true;
+	return true;
+}
+
+/**
+ *  Moves all queued values to vals, in order, and wakes up any blocked
+ *  producers. Returns the number of values moved.
+ */
+uint32_t ValueQueue::Drain(std::vector<as_val *> &vals)
+{
+	uint32_t drained;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		uint32_t capacity = (uint32_t)slots.size();
+		drained = count;
+		for (uint32_t i = 0; i < drained; i++) {
+			vals.push_back(slots[head].val);
+			memory_track_free(MEMORY_SCAN_QUEUE, slots[head].size);
+			head = (head + 1) % capacity;
+		}
+		count = 0;
+		wakeup_pending = false;
+	}
+	if (drained > 0) {
+		not_full.notify_all();
+	}
+	return drained;
+}
+
+/**
+ *  Rejects any further values and wakes up blocked producers, e.g. after the
+ *  consumer has stopped processing results.
+ */
+void ValueQueue::Close()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		closed = true;
+	}
+	not_full.notify_all();
+}
@@ -16,12 +16,15 @@
 
 'use strict'
 
-/* global expect, describe, it */
+/* global expect, describe, it, before, after */
 
 import Aerospike, { Client } from 'aerospike';
 
 import { expect } from 'chai'; 
 import * as helper from './test_helper';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
 let client: Client
 describe('Aerospike', function () {
   describe('Aerospike.client() #noserver', function () {
@@ -54,4 +57,49 @@ describe('Aerospike', function () {
         .then(client => client.close(false))
     })
   })
+
+  describe('Aerospike.setAsyncLogging()', function () {
+    const logFile = path.join(os.tmpdir(), `aerospike-async-log-${process.pid}.log`)
+    let fd: number
+
+    before(() => { fd = fs.openSync(logFile, 'a') })
+    after(() => {
+      Aerospike.setAsyncLogging({ enabled: false })
+      fs.closeSync(fd)
+      fs.unlinkSync(logFile)
+    })
+
+    it('writes the log lines of a client on a background thread', async function () {
+      Aerospike.setAsyncLogging({ bufferSize: 4096 })
+      const config = Object.assign({}, helper.config, { log: { level: Aerospike.log.DEBUG, file: fd } })
+      const client = await Aerospike.connect(config)
+      await client.infoAny()
+      await client.close(false)
+
+      // Lines are written by the background thread; poll until they arrive,
+      // bounded by the test timeout.
+      while (!fs.readFileSync(logFile, 'utf8').includes('DEBUG')) {
+        await new Promise(resolve => setTimeout(resolve, 10))
+      }
+      expect(Aerospike.getAsyncLoggingStats().dropped).to.be.a('number')
+    })
+  })
+
+  describe('Aerospike.setAsyncResourcesEnabled()', function () {
+    after(() => Aerospike.setAsyncResourcesEnabled(true))
+
+    it('completes commands without an async resource', async function () {
+      const client = await Aerospike.connect(helper.config)
+      const key = new Aerospike.Key(helper.namespace, helper.set, 'asyncResources/1')
+      Aerospike.setAsyncResourcesEnabled(false)
+      await client.put(key, { i: 1 })
+      const record = await new Promise<any>((resolve, reject) => {
+        client.get(key, (error?: Error, record?: any) => error ? reject(error) : resolve(record))
+      })
+      expect(record.bins).to.eql({ i: 1 })
+      Aerospike.setAsyncResourcesEnabled(true)
+      await client.remove(key)
+      await client.close(false)
+    })
+  })
 })
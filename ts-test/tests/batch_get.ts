@@ -54,6 +54,19 @@ describe('client.batchGet()', function () {
       })
   })
 
+  it('returns BatchResult instances with Record and Key instances', async function () {
+    const kgen: any = keygen.string(helper.namespace, helper.set, { prefix: 'test/batch_get/classes/', random: false })
+    const records: AerospikeRecord[] = await putgen.put(2, { keygen: kgen, recgen: recgen.constant({ i: 42 }), metagen: metagen.constant({ ttl: 1000 }) })
+    const results: BatchResult[] = await client.batchGet(records.map((record: AerospikeRecord) => record.key))
+    results.forEach((result: BatchResult) => {
+      expect(result).to.be.instanceof(Aerospike.BatchResult)
+      expect(result.record).to.be.instanceof(Aerospike.Record)
+      expect(result.record.key).to.be.instanceof(Aerospike.Key)
+      expect(result.record.bins).to.eql({ i: 42 })
+      expect(result.record.ttl).to.be.a('number')
+    })
+  })
+
   it('should fail reading 10 records', function (done) {
     const numberOfRecords = 10
     const kgen: any = keygen.string(helper.namespace, helper.set, { prefix: 'test/batch_get/fail/', random: false })
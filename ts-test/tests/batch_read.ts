@@ -304,4 +304,38 @@ describe('client.batchRead()', function () {
         expect(result?.record).to.be.instanceof(Aerospike.Record)
       })
   })
+
+  context('client.batchReadStream()', function () {
+    const batchRecords: BatchReadRecord[] = [...Array(10).keys()].map((i: number) => (
+      { key: new Key(helper.namespace, helper.set, `test/batch_read/${i}`), readAllBins: true }
+    ))
+    batchRecords.push({ key: new Key(helper.namespace, helper.set, 'test/batch_read/no_such_key'), readAllBins: true })
+
+    it('yields the results of every sub-batch with its position', async function () {
+      const results: BatchResult[] = new Array(batchRecords.length)
+      let parts: number = 0
+      for await (const part of client.batchReadStream(batchRecords, null, { chunkSize: 3, concurrency: 2 })) {
+        expect(part.results.length).to.be.at.most(3)
+        part.results.forEach((result: BatchResult, i: number) => { results[part.index + i] = result })
+        parts++
+      }
+
+      expect(parts).to.equal(4)
+      results.forEach((result: BatchResult, i: number) => {
+        expect(result.record.key.key).to.equal(batchRecords[i].key.key)
+      })
+      expect(results.filter((result: BatchResult) => result.status === Aerospike.status.OK).length).to.equal(10)
+      expect(results[10].status).to.equal(Aerospike.status.ERR_RECORD_NOT_FOUND)
+    })
+
+    it('yields nothing for an empty batch', async function () {
+      for await (const part of client.batchReadStream([])) {
+        expect.fail(`unexpected part ${part.index}`)
+      }
+    })
+
+    it('rejects an invalid chunk size', function () {
+      expect(() => client.batchReadStream(batchRecords, null, { chunkSize: -1 })).to.throw(TypeError)
+    })
+  })
 })
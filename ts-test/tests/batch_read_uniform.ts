@@ -0,0 +1,130 @@
+// *****************************************************************************
+// Copyright 2024 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+'use strict'
+
+/* global expect, describe, it */
+/* eslint-disable no-unused-expressions */
+
+import Aerospike, { Client, BatchResult, AerospikeRecord, Key } from 'aerospike';
+
+import { expect } from 'chai'; 
+import * as helper from './test_helper';
+
+const keygen = helper.keygen
+const metagen = helper.metagen
+const recgen = helper.recgen
+const putgen = helper.putgen
+const valgen = helper.valgen
+
+const op = Aerospike.operations
+const lists = Aerospike.lists
+
+describe('client.batchReadUniform()', function () {
+  const client: Client = helper.client
+
+  async function putRecords (prefix: string): Promise<Key[]> {
+    const generators: any = {
+      keygen: keygen.string(helper.namespace, helper.set, { prefix, random: false }),
+      recgen: recgen.record({ i: valgen.integer(), s: valgen.string(), l: valgen.constant([1, 2, 3]) }),
+      metagen: metagen.constant({ ttl: 1000 })
+    }
+    const records: AerospikeRecord[] = await putgen.put(10, generators)
+    return records.map((record: AerospikeRecord) => record.key)
+  }
+
+  it('reads the same bins from every record', async function () {
+    const keys = await putRecords('test/batch_read_uniform/bins')
+    const results: BatchResult[] = await client.batchReadUniform(keys, { bins: ['i', 's'] })
+
+    expect(results.length).to.equal(keys.length)
+    results.forEach((result: BatchResult) => {
+      expect(result.status).to.equal(Aerospike.status.OK)
+      expect(result.record.bins).to.have.all.keys('i', 's')
+    })
+  })
+
+  it('executes the same read operations on every record', async function () {
+    const keys = await putRecords('test/batch_read_uniform/ops')
+    const results: BatchResult[] = await client.batchReadUniform(keys, {
+      ops: [lists.getByIndex('l', -1, lists.returnType.VALUE), op.read('i')]
+    })
+
+    expect(results.length).to.equal(keys.length)
+    results.forEach((result: BatchResult) => {
+      expect(result.status).to.equal(Aerospike.status.OK)
+      expect(result.record.bins.l).to.equal(3)
+      expect(result.record.bins).to.have.property('i')
+    })
+  })
+
+  it('applies the shared read policy to every record', async function () {
+    const keys = await putRecords('test/batch_read_uniform/policy')
+    const policy = new Aerospike.BatchReadPolicy({
+      filterExpression: Aerospike.exp.lt(Aerospike.exp.binInt('i'), Aerospike.exp.int(0))
+    })
+    const results: BatchResult[] = await client.batchReadUniform(keys, { readAllBins: true, policy })
+
+    results.forEach((result: BatchResult) => {
+      expect(result.status).to.equal(Aerospike.status.FILTERED_OUT)
+    })
+  })
+
+  describe('client.batchReadDigests()', function () {
+    it('reads the records positionally, without keys', async function () {
+      const keys = await putRecords('test/batch_read_uniform/digests')
+      const known: BatchResult[] = await client.batchGet(keys)
+      const digests = Buffer.concat(known.map((result: BatchResult) => result.record.key.digest as Buffer))
+
+      const results: BatchResult[] = await client.batchReadDigests(helper.namespace, helper.set, digests)
+      expect(results.length).to.equal(keys.length)
+      results.forEach((result: BatchResult, i: number) => {
+        expect(result.status).to.equal(Aerospike.status.OK)
+        expect(result.record.key).to.be.undefined
+        expect(result.record.bins).to.eql(known[i].record.bins)
+      })
+    })
+
+    it('reads the given bins', async function () {
+      const keys = await putRecords('test/batch_read_uniform/digest_bins')
+      const known: BatchResult[] = await client.batchGet(keys)
+      const digests = Buffer.concat(known.map((result: BatchResult) => result.record.key.digest as Buffer))
+
+      const results: BatchResult[] = await client.batchReadDigests(helper.namespace, helper.set, digests, { bins: ['i'] })
+      results.forEach((result: BatchResult, i: number) => {
+        expect(result.record.bins).to.eql({ i: known[i].record.bins.i })
+      })
+    })
+
+    it('rejects a buffer that is not a multiple of the digest size', async function () {
+      try {
+        await client.batchReadDigests(helper.namespace, helper.set, Buffer.alloc(21))
+        expect.fail('should have thrown')
+      } catch (error: any) {
+        expect(error).to.be.instanceof(Aerospike.AerospikeError).with.property('code', Aerospike.status.ERR_PARAM)
+      }
+    })
+  })
+
+  it('rejects bins combined with operations', async function () {
+    try {
+      await client.batchReadUniform([], { bins: ['i'], ops: [op.read('i')] })
+      expect.fail('should have thrown')
+    } catch (error: any) {
+      expect(error).to.be.instanceof(Aerospike.AerospikeError).with.property('code', Aerospike.status.ERR_PARAM)
+    }
+  })
+})
@@ -22,6 +22,8 @@
 import Aerospike, { Client as Cli, ConfigOptions, cdt, AerospikeError, AerospikeRecord, Node, KeyOptions } from 'aerospike';
 
 import { expect } from 'chai'; 
+import { Worker } from 'worker_threads';
+import * as crypto from 'crypto';
 import * as helper from './test_helper';
 
 const keygen: any = helper.keygen
@@ -58,6 +60,27 @@ describe('Client', function () {
       expect(promise).to.be.instanceof(Promise)
       return promise.then(() => client.close(false))
     })
+
+    it('should not block the event loop while connecting', function () {
+      const client: Cli = new Client(helper.config)
+      let ticked = false
+      setImmediate(() => { ticked = true })
+      return client.connect()
+        .then(() => {
+          expect(ticked).to.be.true
+          client.close(false)
+        })
+    })
+
+    it('closes a client that is closed while connecting', async function () {
+      const client: Cli = new Client(helper.config)
+      const connecting: Promise<Cli> = client.connect()
+      client.close(false)
+      const error: any = await connecting.catch((error: any) => error)
+      expect(error).to.be.instanceof(Aerospike.AerospikeError)
+      expect(error.message).to.equal('Client was closed while connecting')
+      expect(client.isConnected(false)).to.be.false
+    })
   })
 
   describe('#close', function () {
@@ -101,6 +124,77 @@ describe('Client', function () {
     */
   })
 
+  describe('worker threads', function () {
+    function runWorker (key: KeyOptions): Promise<any> {
+      const source = `
+        const { parentPort, workerData } = require('worker_threads')
+        const Aerospike = require('aerospike')
+        const key = new Aerospike.Key(workerData.key.ns, workerData.key.set, workerData.key.key)
+        Aerospike.connect(workerData.config)
+          .then(client => client.put(key, { worker: 1 })
+            .then(() => Promise.all([1, 2, 3, 4].map(() => client.get(key))))
+            .then(records => parentPort.postMessage({
+              bins: records.map(record => record.bins),
+              eventLoops: client.stats().eventLoops
+            }))
+            .finally(() => client.close(true)))
+          .catch(error => parentPort.postMessage({ error: error.message }))
+      `
+      const config = Object.assign({}, helper.config, { sharedCluster: 'worker-test' })
+      const worker = new Worker(source, {
+        eval: true,
+        workerData: { config: JSON.parse(JSON.stringify(config)), key: { ns: key.ns, set: key.set, key: key.key } }
+      })
+      return new Promise((resolve, reject) => {
+        let result: any
+        worker.once('message', message => { result = message })
+        worker.once('error', reject)
+        worker.once('exit', () => resolve(result))
+      })
+    }
+
+    it('executes commands from several worker threads sharing a cluster', async function () {
+      this.timeout(10000)
+      const keys: KeyOptions[] = [keygen.string(helper.namespace, helper.set)(), keygen.string(helper.namespace, helper.set)()]
+      const results = await Promise.all(keys.map(runWorker))
+      results.forEach(result => expect(result.bins).to.eql(Array(4).fill({ worker: 1 })))
+    })
+
+    it('executes commands on the event loop of a worker thread that has exited', async function () {
+      this.timeout(10000)
+      const first = await runWorker(keygen.string(helper.namespace, helper.set)())
+      const second = await runWorker(keygen.string(helper.namespace, helper.set)())
+      expect(first.bins).to.eql(Array(4).fill({ worker: 1 }))
+      expect(second.bins).to.eql(Array(4).fill({ worker: 1 }))
+      expect(first.eventLoops).to.be.a('number')
+      expect(second.eventLoops).to.equal(first.eventLoops)
+    })
+
+    it('reuses the event loops of worker threads that have exited', async function () {
+      this.timeout(10000)
+      for (let i = 0; i < 3; i++) {
+        const result = await runWorker(keygen.string(helper.namespace, helper.set)())
+        expect(result.bins).to.eql(Array(4).fill({ worker: 1 }))
+      }
+
+      const key = keygen.string(helper.namespace, helper.set)()
+      await helper.client.put(key, { main: 1 })
+      const record = await helper.client.get(key)
+      expect(record.bins).to.eql({ main: 1 })
+    })
+
+    it('rejects a client with a different configuration for a shared cluster', async function () {
+      const config = Object.assign({}, helper.config, { sharedCluster: 'config-test' })
+      const client = await Aerospike.connect(config)
+      try {
+        const other = Object.assign({}, config, { maxConnsPerNode: 7 })
+        expect(() => new Client(other)).to.throw('Shared cluster was created with a different configuration')
+      } finally {
+        await client.close(false)
+      }
+    })
+  })
+
   describe('#isConnected', function () {
     context('without tender health check', function () {
       it('returns false if the client is not connected', function () {
@@ -159,6 +253,23 @@ describe('Client', function () {
     })
   })
 
+  describe('Client#infoAny', function () {
+    const client: Cli = helper.client
+
+    it('completes while all libuv worker threads are busy', async function () {
+      const workers = Number(process.env.UV_THREADPOOL_SIZE || 4)
+      let busy = workers
+      for (let i = 0; i < workers; i++) {
+        crypto.pbkdf2('secret', 'salt', 2000000, 64, 'sha512', () => { busy-- })
+      }
+
+      const result = await client.infoAny('status')
+
+      expect(result).to.equal('status\tok\n')
+      expect(busy).to.equal(workers)
+    })
+  })
+
   describe('Client#contextToBase64', function () {
     const client: Cli = helper.client
     const context: cdt.Context = new Context().addMapKey('nested')
@@ -19,7 +19,7 @@
 /* eslint-env mocha */
 /* global expect */
 
-import Aerospike, { AerospikeError, Client as Cli, exp as expr, operations, maps as Maps, GeoJSON as GJ, Key, AerospikeBins, cdt, AerospikeRecord, RecordMetadata, AerospikeExp} from 'aerospike';
+import Aerospike, { AerospikeError, Client as Cli, exp as expr, operations, maps as Maps, GeoJSON as GJ, Key, AerospikeBins, cdt, AerospikeRecord, RecordMetadata, AerospikeExp, CompiledExpression} from 'aerospike';
 
 import { expect } from 'chai'; 
 
@@ -56,7 +56,7 @@ describe('Aerospike.exp', function () {
     return key
   }
 
-  async function testNoMatch (key: Key, filterExpression: AerospikeExp) {
+  async function testNoMatch (key: Key, filterExpression: AerospikeExp | CompiledExpression) {
     const rejectPolicy = { filterExpression }
     let operationSuccessful = false
     try {
@@ -70,7 +70,7 @@ describe('Aerospike.exp', function () {
     }
   }
 
-  async function testMatch (key: Key, filterExpression: AerospikeExp) {
+  async function testMatch (key: Key, filterExpression: AerospikeExp | CompiledExpression) {
     const passPolicy = { filterExpression }
     await client.remove(key, passPolicy)
   }
@@ -316,6 +316,35 @@ describe('Aerospike.exp', function () {
     })
   })
 
+  describe('compile', function () {
+    it('compiles a filter expression for reuse', function () {
+      const filter: CompiledExpression = exp.compile(exp.eq(exp.binInt('intVal'), exp.int(42)))
+      expect(filter.getSize()).to.be.greaterThan(0)
+    })
+
+    it('throws a type error if the expression is not an array', function () {
+      expect(() => exp.compile('intVal' as any)).to.throw(TypeError)
+    })
+
+    it('evaluates a compiled expression in a policy', async function () {
+      const key = await createRecord({ intVal: 42 })
+
+      await testNoMatch(key, exp.compile(exp.eq(exp.binInt('intVal'), exp.int(37))))
+      await testMatch(key, exp.compile(exp.eq(exp.binInt('intVal'), exp.int(42))))
+    })
+
+    it('reuses a compiled expression across commands', async function () {
+      const filter: CompiledExpression = exp.compile(exp.eq(exp.binInt('intVal'), exp.int(42)))
+      const keys: Key[] = await Promise.all([1, 2, 3].map(() => createRecord({ intVal: 42 })))
+      const policy = new Aerospike.ReadPolicy({ filterExpression: filter })
+
+      const records: AerospikeRecord[] = await Promise.all(keys.map(key => client.get(key, policy)))
+      records.forEach(record => expect(record.bins.intVal).to.eq(42))
+      const results = await client.batchRead(keys.map(key => ({ key, readAllBins: true })), new Aerospike.BatchPolicy({ filterExpression: filter }))
+      results.forEach(result => expect(result.status).to.eq(Aerospike.status.OK))
+    })
+  })
+
   describe('arithmetic expressions', function () {
     describe('int bin add expression', function () {
       it('evaluates exp_read op to true if temp bin equals the sum of bin and given value', async function () {
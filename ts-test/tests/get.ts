@@ -59,6 +59,80 @@ describe('client.get()', function () {
     })
   })
 
+  context('with read batching', function () {
+    let batchingClient: Cli
+
+    before(async function () {
+      const config = Object.assign({}, helper.config, { readBatching: { maxKeys: 10 } })
+      batchingClient = await Aerospike.connect(config)
+    })
+
+    after(() => batchingClient.close(false))
+
+    it('coalesces concurrent reads and returns each record', async function () {
+      const keys: K[] = [1, 2, 3, 4, 5].map(i => new Aerospike.Key(helper.namespace, helper.set, `test/get/batching/${i}`))
+      await Promise.all(keys.map((key, i) => client.put(key, { i, s: 'abc' })))
+
+      const missing: K = new Aerospike.Key(helper.namespace, helper.set, 'test/get/batching/missing')
+      const [records, selected, exists, notExists, error] = await Promise.all([
+        Promise.all(keys.map(key => batchingClient.get(key))),
+        batchingClient.select(keys[0], ['i']),
+        batchingClient.exists(keys[1]),
+        batchingClient.exists(missing),
+        batchingClient.get(missing).catch((error: AerospikeError) => error)
+      ])
+
+      records.forEach((record: AerospikeRecord, i: number) => {
+        expect(record.key).to.equal(keys[i])
+        expect(record.bins).to.eql({ i, s: 'abc' })
+      })
+      expect(selected.bins).to.eql({ i: 0 })
+      expect(exists).to.equal(true)
+      expect(notExists).to.equal(false)
+      expect((error as AerospikeError).code).to.equal(status.ERR_RECORD_NOT_FOUND)
+
+      await Promise.all(keys.map(key => client.remove(key)))
+    })
+
+    it('batches reads issued with equal policies of their own', async function () {
+      const keys: K[] = [1, 2, 3, 4].map(i => new Aerospike.Key(helper.namespace, helper.set, `test/get/batching/policy/${i}`))
+      await Promise.all(keys.map((key, i) => client.put(key, { i })))
+
+      const batchRead = batchingClient.batchRead
+      let batches = 0
+      batchingClient.batchRead = function (...args: any[]) {
+        batches++
+        return (batchRead as any).apply(this, args)
+      }
+      try {
+        const records = await Promise.all(keys.map((key, i) => i % 2
+          ? batchingClient.get(key, { totalTimeout: 1000 } as any)
+          : batchingClient.get(key, new Aerospike.ReadPolicy({ totalTimeout: 1000 }))))
+        records.forEach((record: AerospikeRecord, i: number) => expect(record.bins).to.eql({ i }))
+        expect(batches).to.equal(1)
+      } finally {
+        batchingClient.batchRead = batchRead
+      }
+
+      await Promise.all(keys.map(key => client.remove(key)))
+    })
+
+    it('fails only the read of an invalid key', async function () {
+      const key: K = new Aerospike.Key(helper.namespace, helper.set, 'test/get/batching/valid')
+      await client.put(key, { i: 1 })
+
+      const invalid: any = { ns: helper.namespace, set: helper.set, key: 1.5 }
+      const [record, error] = await Promise.all([
+        batchingClient.get(key),
+        batchingClient.get(invalid).catch((error: AerospikeError) => error)
+      ])
+      expect(record.bins).to.eql({ i: 1 })
+      expect((error as AerospikeError).code).to.equal(status.ERR_PARAM)
+
+      await client.remove(key)
+    })
+  })
+
   context('with ReadPolicy', function () {
     context('with deserialize: false', function () {
       it('should return lists and maps as raw bytes', function () {
@@ -170,4 +244,33 @@ describe('client.get()', function () {
           .then((record: AerospikeRecord) => expect(record.bins.foo).to.equal('bar'))
       })
   })
+
+  context('with a frozen policy', function () {
+    it('reads the record using the frozen policy', async function () {
+      const key: K = keygen.string(helper.namespace, helper.set, { prefix: 'test/get/' })()
+      const policy = Aerospike.policy.freeze('read', {
+        totalTimeout: 1000,
+        filterExpression: Aerospike.exp.eq(Aerospike.exp.binInt('i'), Aerospike.exp.int(42))
+      })
+
+      await client.put(key, { i: 42 })
+      const record: AerospikeRecord = await client.get(key, policy)
+      expect(record.bins).to.eql({ i: 42 })
+      const again: AerospikeRecord = await client.get(key, policy)
+      expect(again.bins).to.eql({ i: 42 })
+      await client.remove(key)
+    })
+
+    it('rejects a frozen policy of a different type', async function () {
+      const key: K = keygen.string(helper.namespace, helper.set, { prefix: 'test/get/' })()
+      const policy: any = Aerospike.policy.freeze('write', { totalTimeout: 1000 })
+
+      try {
+        await client.get(key, policy)
+        expect.fail('get should have failed with a parameter error')
+      } catch (error: any) {
+        expect(error.code).to.equal(status.ERR_PARAM)
+      }
+    })
+  })
 })
@@ -385,6 +385,73 @@ context('Operations', function () {
       })
     })
 
+    context('with prepared operations', function () {
+      const lists = Aerospike.lists
+      const maps = Aerospike.maps
+
+      it('executes the operations with the bound values', async function () {
+        const prepared: operations.PreparedOperations = op.prepare([
+          op.incr('int', op.param(0)),
+          op.append('string', op.param(1)),
+          lists.append('list', op.param(2) as any),
+          maps.put('map', op.param(3) as any, op.param(4) as any),
+          op.read('int')
+        ])
+        expect(prepared.params).to.equal(5)
+
+        await client.operate(key, prepared.bind([1, 'd', 4, 'x', 'y']))
+        const record = await client.operate(key, prepared.bind([2, 'e', [5], 'z', { v: 1 }]))
+        expect(record.bins.int).to.equal(126)
+
+        const { bins } = await client.get(key)
+        expect(bins.string).to.equal('abcde')
+        expect(bins.list).to.eql([1, 2, 3, 4, [5]])
+        expect(bins.map).to.eql({ a: 1, b: 2, c: 3, x: 'y', z: { v: 1 } })
+      })
+
+      it('shares unchanged values between executions', async function () {
+        const prepared: operations.PreparedOperations = op.prepare([
+          lists.append('list', 'fixed'),
+          op.write('int', op.param(0))
+        ])
+
+        await client.operate(key, prepared.bind([7]))
+        await client.operate(key, prepared.bind([8]))
+
+        const { bins } = await client.get(key)
+        expect(bins.int).to.equal(8)
+        expect(bins.list).to.eql([1, 2, 3, 'fixed', 'fixed'])
+      })
+
+      it('keeps operations prepared while another command converts its bins', async function () {
+        let prepared: any
+        const bins = {
+          i: 1,
+          get s () {
+            prepared = op.prepare([lists.append('list', 'prepared-in-getter'), op.write('int', op.param(0))])
+            return 'abc'
+          }
+        }
+        await client.put(key, bins)
+        // Reuse the arena of the put command.
+        await client.put(key, { string: 'x'.repeat(64), int: 1 })
+
+        await client.operate(key, prepared.bind([9]))
+        const record = await client.get(key)
+        expect(record.bins.int).to.equal(9)
+        expect(record.bins.list).to.eql([1, 2, 3, 'prepared-in-getter'])
+      })
+
+      it('throws an error if a parameter value is missing', function () {
+        const prepared: operations.PreparedOperations = op.prepare([op.write('int', op.param(1))])
+        expect(() => prepared.bind([1])).to.throw(TypeError)
+      })
+
+      it('throws an error if a parameter replaces a bin name', function () {
+        expect(() => op.prepare([op.read(op.param(0) as any)])).to.throw(TypeError)
+      })
+    })
+
     it('calls the callback function with the results of the operation', function (done) {
       const ops: operations.Operation[] = [
         op.read('int')
@@ -321,4 +321,21 @@ context('Client Policies #noserver', function () {
     })
   })
 
+  describe('policy.freeze', function () {
+    it('freezes a policy from a value object', function () {
+      const frozen = Aerospike.policy.freeze('read', { totalTimeout: 100 })
+      expect(frozen).to.not.be.an.instanceof(ReadPolicy)
+    })
+
+    it('returns a frozen policy unchanged', function () {
+      const frozen = Aerospike.policy.freeze('write', new Aerospike.WritePolicy({ ttl: 100 }))
+      expect(Aerospike.policy.freeze('write', frozen)).to.equal(frozen)
+      expect(Aerospike.policy.createPolicy('write', frozen)).to.equal(frozen)
+    })
+
+    it('throws a type error for policy types that cannot be frozen', function () {
+      expect(() => Aerospike.policy.freeze('query' as any, {})).to.throw(TypeError)
+    })
+  })
+
 })
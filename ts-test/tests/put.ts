@@ -161,6 +161,14 @@ describe('client.put()', function () {
       putGetVerify(record, expected, done)
     })
 
+    it('writes bin with large Buffer value and reads it back', function (done) {
+      const buffer: Buffer = Buffer.alloc(256 * 1024)
+      for (let i = 0; i < buffer.length; i++) buffer[i] = i % 251
+      const record: AerospikeBins = { buffer }
+      const expected: AerospikeBins = { buffer: Buffer.from(buffer) }
+      putGetVerify(record, expected, done)
+    })
+
     it('writes bin with float value as double and reads it back', function (done) {
       const record: AerospikeBins = { double: 3.141592653589793 }
       const expected: AerospikeBins = { double: 3.141592653589793 }
@@ -352,6 +352,23 @@ describe('Queries', function () {
       })
     })
 
+    it('should apply a stream UDF with a minimal result queue', function (done) {
+      const args: QueryOptions = {
+        filters: [filter.equal('name', 'filter')],
+        maxQueueSize: 1
+      }
+      const query: Query = client.query(helper.namespace, testSet, args)
+      query.setUdf('udf', 'even')
+      const stream = query.foreach()
+      const results: AerospikeBins[] = []
+      stream.on('error', (error: ASError) => { throw error })
+      stream.on('data', (record: AerospikeRecord) => results.push(record.bins))
+      stream.on('end', () => {
+        expect(results.sort()).to.eql([2, 4])
+        done()
+      })
+    })
+
     describe('index with cdt context', function () {
       helper.skipUnlessVersion('>= 6.1.0', this)
       it('should apply a stream UDF to the nested context', function (done) {
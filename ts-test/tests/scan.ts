@@ -313,6 +313,75 @@ context('Scans', function () {
       })
     })
 
+    context('with recordsPerCallback', function () {
+      it('delivers all records in batches', function (done) {
+        this.timeout(10000) // 10 second timeout
+        const scan: ScanType = client.scan(helper.namespace, testSet, { recordsPerCallback: 16 })
+        const stream = scan.foreach()
+        const received: AerospikeRecord[] = []
+        stream.on('data', (record: AerospikeRecord) => received.push(record))
+        stream.on('end', () => {
+          expect(received.length).to.equal(numberOfRecords)
+          received.forEach(record => {
+            expect(record.key).to.be.instanceof(Aerospike.Key)
+            expect(record.bins).to.have.all.keys('i', 's')
+          })
+          done()
+        })
+      })
+
+      it('stops emitting records when the stream is aborted', function (done) {
+        const scan: ScanType = client.scan(helper.namespace, testSet, { recordsPerCallback: 16 })
+        const stream = scan.foreach()
+        let recordsReceived = 0
+        stream.on('data', () => {
+          recordsReceived++
+          if (recordsReceived === 5) {
+            stream.abort()
+          }
+        })
+        stream.on('end', () => {
+          expect(recordsReceived).to.equal(5)
+          done()
+        })
+      })
+    })
+
+    context('with highWaterMark', function () {
+      it('delivers all records in pages', function (done) {
+        this.timeout(10000) // 10 second timeout
+        const scan: ScanType = client.scan(helper.namespace, testSet, { highWaterMark: 10 })
+        const stream = scan.foreach()
+        let recordsReceived = 0
+        stream.on('data', () => recordsReceived++)
+        stream.on('end', () => {
+          expect(recordsReceived).to.equal(numberOfRecords)
+          done()
+        })
+      })
+
+      it('does not emit records while the stream is paused', function (done) {
+        this.timeout(10000) // 10 second timeout
+        const scan: ScanType = client.scan(helper.namespace, testSet, { highWaterMark: 10 })
+        const stream = scan.foreach()
+        let recordsReceived = 0
+        stream.on('data', () => {
+          recordsReceived++
+          if (recordsReceived === 5) {
+            stream.pause()
+            setTimeout(() => {
+              expect(recordsReceived).to.equal(5)
+              stream.resume()
+            }, 100)
+          }
+        })
+        stream.on('end', () => {
+          expect(recordsReceived).to.equal(numberOfRecords)
+          done()
+        })
+      })
+    })
+
     context('with max records limit', function () {
       helper.skipUnlessVersion('>= 4.9.0', this)
 
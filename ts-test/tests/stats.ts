@@ -21,6 +21,7 @@
 /* eslint-disable no-unused-expressions */
 
 
+import Aerospike from 'aerospike';
 import { expect } from 'chai'; 
 import * as helper from './test_helper';
 
@@ -61,4 +62,112 @@ describe('Client#stats', function () {
       expect(connStats.closed).to.be.at.least(0)
     }
   })
+
+  it('returns command latency histograms', async function () {
+    const key = new Aerospike.Key(helper.namespace, helper.set, 'test/stats/latency')
+    await client.put(key, { i: 1 })
+    await client.get(key)
+
+    const latency: any = client.stats().latency
+    for (const phase of ['request', 'roundTrip', 'response', 'total']) {
+      expect(latency.get[phase].count).to.be.at.least(1)
+      expect(latency.get[phase].p99).to.be.at.least(0)
+    }
+    expect(latency.get.total.max).to.be.at.least(latency.get.total.p50)
+    expect(latency.namespaces[helper.namespace].put.count).to.be.at.least(1)
+  })
+
+  it('returns pipeline connection stats', async function () {
+    const config = Object.assign({}, helper.config, { pipeline: { maxDepth: 16 } })
+    const pipelineClient = await Aerospike.connect(config)
+    try {
+      const key = new Aerospike.Key(helper.namespace, helper.set, 'test/stats/pipeline')
+      await Promise.all([1, 2, 3, 4].map(i => pipelineClient.put(key, { i })))
+      const record = await pipelineClient.get(key)
+      expect(record.bins.i).to.be.a('number')
+
+      const stats: any = pipelineClient.stats()
+      expect(stats.commands.pipelined).to.equal(0)
+      const opened = stats.nodes.reduce((sum: number, node: any) => sum + node.pipelineConnections.opened, 0)
+      expect(opened).to.be.at.least(1)
+    } finally {
+      await pipelineClient.close(false)
+    }
+  })
+
+  it('returns record cache stats', async function () {
+    const config = Object.assign({}, helper.config, { readCache: { maxStaleness: 10000 } })
+    const cachingClient = await Aerospike.connect(config)
+    try {
+      const key = new Aerospike.Key(helper.namespace, helper.set, 'test/stats/cache')
+      await cachingClient.put(key, { i: 1, l: [Buffer.from('abc')] })
+      await cachingClient.get(key)
+      const record = await cachingClient.get(key)
+      expect(record.bins).to.eql({ i: 1, l: [Buffer.from('abc')] })
+
+      let cache: any = cachingClient.stats().cache
+      expect(cache.misses).to.equal(1)
+      expect(cache.hits).to.equal(1)
+      expect(cache.entries).to.equal(1)
+
+      await cachingClient.put(key, { i: 2 })
+      expect((await cachingClient.get(key)).bins.i).to.equal(2)
+      cache = cachingClient.stats().cache
+      expect(cache.misses).to.equal(2)
+      await cachingClient.remove(key)
+    } finally {
+      await cachingClient.close(false)
+    }
+  })
+
+  it('serves cached scalar bins after the reads that cached them have completed', async function () {
+    const config = Object.assign({}, helper.config, { readCache: { maxStaleness: 10000 } })
+    const cachingClient = await Aerospike.connect(config)
+    try {
+      const bins = { i: 42, d: 1.5, s: 'cached', b: Buffer.from('blob') }
+      const keys = ['test/stats/cache/get', 'test/stats/cache/batch'].map(k => new Aerospike.Key(helper.namespace, helper.set, k))
+      await Promise.all(keys.map(key => cachingClient.put(key, bins)))
+
+      await cachingClient.get(keys[0])
+      await cachingClient.batchRead([{ key: keys[1], readAllBins: true }])
+      // Other reads reuse the memory of the completed ones.
+      const other = new Aerospike.Key(helper.namespace, helper.set, 'test/stats/cache/other')
+      await cachingClient.put(other, { i: 7, s: 'other', b: Buffer.from('other') })
+      await Promise.all([1, 2, 3].map(() => client.get(other)))
+
+      const hits = (cachingClient.stats() as any).cache.hits
+      for (const key of keys) {
+        expect((await cachingClient.get(key)).bins).to.eql(bins)
+      }
+      const results = await cachingClient.batchRead(keys.map(key => ({ key, readAllBins: true })))
+      results.forEach((result: any) => expect(result.record.bins).to.eql(bins))
+      expect((cachingClient.stats() as any).cache.hits).to.be.at.least(hits + 4)
+      await Promise.all(keys.concat(other).map(key => cachingClient.remove(key)))
+    } finally {
+      await cachingClient.close(false)
+    }
+  })
+
+  it('returns native memory stats per subsystem', function () {
+    const before: any = client.stats().memory
+    for (const subsystem of ['conversion', 'batch', 'scanQueue', 'txn', 'expression', 'cache']) {
+      expect(before[subsystem].bytes).to.be.at.least(0)
+      expect(before[subsystem].count).to.be.at.least(0)
+    }
+
+    const compiled = Aerospike.exp.compile(Aerospike.exp.eq(Aerospike.exp.binInt('i'), Aerospike.exp.int(42)))
+    const after: any = client.stats().memory
+    expect(after.expression.count).to.be.at.least(before.expression.count + 1)
+    expect(after.expression.bytes).to.be.at.least(before.expression.bytes + compiled.getSize())
+  })
+
+  it('resets the latency histograms', async function () {
+    const key = new Aerospike.Key(helper.namespace, helper.set, 'test/stats/reset')
+    await client.put(key, { i: 1 })
+
+    client.resetStats()
+    const latency: any = client.stats().latency
+    expect(latency.put.total.count).to.equal(0)
+    expect(latency.namespaces[helper.namespace].put.count).to.equal(0)
+  })
 })
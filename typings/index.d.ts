@@ -60,6 +60,21 @@ export type AerospikeBinValue = PartialAerospikeBinValue | PartialAerospikeBinVa
  */
 export type AerospikeExp = { op: number, [key: string]: any }[]
 
+/**
+ * A filter expression that has been compiled once by {@link exp.compile}.
+ * It can be used as the filterExpression of any number of policies and is
+ * not recompiled by the commands that use it.
+ *
+ * @since v6.4.0
+ */
+export class CompiledExpression {
+    private constructor();
+    /**
+     * Returns the size of the compiled expression in bytes.
+     */
+    public getSize(): number;
+}
+
 
 /**
  * Contains geolocation information releavant to the GEOJSON Aerospike type.
@@ -1033,6 +1048,31 @@ export class Query {
      * If set to `true`, the query will return only meta data, and exclude bins.
      */
     public nobins: boolean;
+    /**
+     * Maximum number of records to pass from the native client to JavaScript
+     * at a time when the query is executed using {@link Query#foreach}.
+     * Not supported by queries that apply a stream UDF.
+     *
+     * @since v6.4.0
+     */
+    public recordsPerCallback?: number;
+    /**
+     * If set, the {@link RecordStream} returned by {@link Query#foreach}
+     * requests the records in pages of at most this many records and only
+     * requests the next page while the stream is not paused.
+     * Not supported for paginated queries or queries that apply a stream UDF.
+     *
+     * @since v6.4.0
+     */
+    public highWaterMark?: number;
+    /**
+     * Maximum number of stream UDF results buffered between the cluster and
+     * the application when the query is executed using {@link Query#foreach}.
+     * Defaults to 10,000.
+     *
+     * @since v6.4.0
+     */
+    public maxQueueSize?: number;
     /**
      * User-defined function parameters to be applied to the query executed using
      * {@link Query#foreach}.
@@ -1942,7 +1982,7 @@ export namespace policy {
          * * {@link Client.remove}
          * * {@link Client.select}
          */
-        public filterExpression?: AerospikeExp;
+        public filterExpression?: AerospikeExp | CompiledExpression;
         /**
          * Maximum number of retries before aborting the current command.
          * The initial attempt is not counted as a retry.
@@ -2036,7 +2076,7 @@ export namespace policy {
          * command is ignored. This can be used to eliminate a client/server roundtrip
          * in some cases.
          */
-        public filterExpression?: AerospikeExp;
+        public filterExpression?: AerospikeExp | CompiledExpression;
         /**
          * Specifies the behavior for the key.
          *
@@ -2189,7 +2229,7 @@ export namespace policy {
          * command is ignored. This can be used to eliminate a client/server roundtrip
          * in some cases.
          */
-        public filterExpression?: AerospikeExp;
+        public filterExpression?: AerospikeExp | CompiledExpression;
         /**
          * Read policy for AP (availability) namespaces.
          *
@@ -2248,7 +2288,7 @@ export namespace policy {
          * in some cases.
          *
          */
-        public filterExpression?: AerospikeExp;
+        public filterExpression?: AerospikeExp | CompiledExpression;
         /**
          * Specifies the behavior for the generation value.
          *
@@ -2307,7 +2347,7 @@ export namespace policy {
          * command is ignored. This can be used to eliminate a client/server roundtrip
          * in some cases.
          */
-        public filterExpression?: AerospikeExp;
+        public filterExpression?: AerospikeExp | CompiledExpression;
         /**
          * Specifies the behavior for the generation value.
          *
@@ -3348,6 +3388,42 @@ export namespace policy {
     }
 
     export function createPolicy(type: string, values: AnyPolicy): AnyPolicy;
+
+    /**
+     * Maps the policy types accepted by {@link policy.freeze} to the policy
+     * they stand in for.
+     */
+    export interface FrozenPolicyTypes {
+        read: ReadPolicy;
+        write: WritePolicy;
+        apply: ApplyPolicy;
+        operate: OperatePolicy;
+        remove: RemovePolicy;
+        batch: BatchPolicy;
+        batchParentWrite: BatchPolicy;
+        txnRoll: BatchPolicy;
+        txnVerify: BatchPolicy;
+        batchRead: BatchReadPolicy;
+        batchWrite: BatchWritePolicy;
+        batchApply: BatchApplyPolicy;
+        batchRemove: BatchRemovePolicy;
+    }
+
+    /**
+     * Converts a policy to its native representation once, so that commands
+     * using it copy the converted policy instead of reading all of its
+     * properties again for every command.
+     *
+     * The returned policy can be passed wherever a policy of the same type is
+     * accepted, but its properties cannot be read or modified. Policies that
+     * reference a {@link Transaction} cannot be frozen.
+     *
+     * @param type - The policy type.
+     * @param values - The policy or policy values to freeze.
+     *
+     * @since v6.4.0
+     */
+    export function freeze<T extends keyof FrozenPolicyTypes>(type: T, values?: AnyPolicy | null): Readonly<FrozenPolicyTypes[T]>;
 }
 
 /**
@@ -3367,6 +3443,14 @@ export class Client extends EventEmitter {
      * Describes connection status.
      */
     private connected: boolean;
+    /**
+     * Whether the connection is being established.
+     */
+    private connecting: boolean;
+    /**
+     * Arguments of a close() call made while connecting.
+     */
+    private pendingClose: any;
     /**
      *
      * Set to <code>true</code> to enable capturing of debug stacktraces for
@@ -3714,6 +3798,118 @@ export class Client extends EventEmitter {
      * the command completes, with the results of the batched command.
      */
     public batchRead(records: BatchReadRecord[], policy?: policy.BatchPolicy | null, callback?: TypedCallback<BatchResult[]>): void;
+    /**
+     * Reads multiple records, delivering the results in parts as they arrive.
+     *
+     * @remarks The batch is split into sub-batches of at most
+     * <code>chunkSize</code> records, which are sent concurrently. The
+     * results of each sub-batch are yielded as soon as it completes.
+     * Sub-batches complete in any order; the <code>index</code> of each part
+     * is the position of its first result in <code>records</code>.
+     *
+     * At most <code>concurrency</code> sub-batches are in flight or waiting
+     * to be consumed at any time. If a sub-batch fails as a whole, iteration
+     * ends with its error.
+     *
+     * This method requires server >= 6.0.0.
+     *
+     * @param records - List of {@link BatchReadRecord} instances which each contain keys and bins to retrieve.
+     * @param policy - The Batch Policy to use for each sub-batch.
+     * @param options - Streaming options.
+     *
+     * @example
+     *
+     * ```typescript
+     * for await (const { index, results } of client.batchReadStream(records, null, { chunkSize: 500 })) {
+     *   console.log('received %d results starting at %d', results.length, index)
+     * }
+     * ```
+     *
+     * @since v6.4.0
+     */
+    public batchReadStream(records: BatchReadRecord[], policy?: policy.BatchPolicy | null, options?: BatchStreamOptions): AsyncIterableIterator<BatchResultPart>;
+    /**
+     * Reads the same bins, or executes the same read operations, for a batch
+     * of records.
+     *
+     * @remarks Unlike {@link Client#batchRead}, which converts the bins,
+     * operations and policy of every batch record separately, this method
+     * converts them once and shares them between all keys.
+     *
+     * This method requires server >= 6.0.0.
+     *
+     * @param keys - An array of {@link Key | Keys}, used to locate the records in the cluster.
+     * @param read - What to read for every key.
+     * @param policy - The Batch Policy to use for this command.
+     *
+     * @example
+     *
+     * ```typescript
+     * const profiles = await client.batchReadUniform(keys, { bins: ['name', 'email'] })
+     * ```
+     *
+     * @since v6.4.0
+     */
+    public batchReadUniform(keys: KeyOptions[], read: BatchReadUniform, policy?: policy.BatchPolicy | null): Promise<BatchResult[]>;
+    /**
+     * @param keys - An array of {@link Key | Keys}, used to locate the records in the cluster.
+     * @param read - What to read for every key.
+     * @param callback - The function to call when
+     * the command completes, with the results of the batched command.
+     */
+    public batchReadUniform(keys: KeyOptions[], read: BatchReadUniform, callback: TypedCallback<BatchResult[]>): void;
+    /**
+     * @param keys - An array of {@link Key | Keys}, used to locate the records in the cluster.
+     * @param read - What to read for every key.
+     * @param policy - The Batch Policy to use for this command.
+     * @param callback - The function to call when
+     * the command completes, with the results of the batched command.
+     */
+    public batchReadUniform(keys: KeyOptions[], read: BatchReadUniform, policy: policy.BatchPolicy | null, callback: TypedCallback<BatchResult[]>): void;
+    /**
+     * Reads a batch of records of one set, identified by their digests.
+     *
+     * @remarks The keys are given as a single Buffer of packed 20-byte
+     * digests instead of as an array of {@link Key} objects. The results are
+     * positional: <code>results[i]</code> is the result for the digest at
+     * offset <code>i * 20</code> of <code>digests</code>, and its record has
+     * no <code>key</code>.
+     *
+     * This method requires server >= 6.0.0.
+     *
+     * @param ns - The namespace of the records.
+     * @param set - The set of the records.
+     * @param digests - The digests of the records, 20 bytes each.
+     * @param read - What to read for every record. Reads all bins by default.
+     * @param policy - The Batch Policy to use for this command.
+     *
+     * @example
+     *
+     * ```typescript
+     * const results = await client.batchReadDigests('test', 'demo', digests, { bins: ['name'] })
+     * ```
+     *
+     * @since v6.4.0
+     */
+    public batchReadDigests(ns: string, set: string | null, digests: Buffer, read?: BatchReadUniform | null, policy?: policy.BatchPolicy | null): Promise<BatchResult[]>;
+    /**
+     * @param ns - The namespace of the records.
+     * @param set - The set of the records.
+     * @param digests - The digests of the records, 20 bytes each.
+     * @param callback - The function to call when
+     * the command completes, with the results of the batched command.
+     */
+    public batchReadDigests(ns: string, set: string | null, digests: Buffer, callback: TypedCallback<BatchResult[]>): void;
+    /**
+     * @param ns - The namespace of the records.
+     * @param set - The set of the records.
+     * @param digests - The digests of the records, 20 bytes each.
+     * @param read - What to read for every record.
+     * @param policy - The Batch Policy to use for this command.
+     * @param callback - The function to call when
+     * the command completes, with the results of the batched command.
+     */
+    public batchReadDigests(ns: string, set: string | null, digests: Buffer, read: BatchReadUniform | null, policy: policy.BatchPolicy | null, callback: TypedCallback<BatchResult[]>): void;
     /**
      *
      * Reads a batch of records from the database cluster.
@@ -5658,7 +5854,7 @@ export class Client extends EventEmitter {
      * })
      *
      */
-    public operate<B extends AerospikeBins = AerospikeBins>(key: KeyOptions, operations: operations.Operation[], metadata?: RecordMetadata | null, policy?: policy.OperatePolicy | null): Promise<AerospikeRecord<B>>;
+    public operate<B extends AerospikeBins = AerospikeBins>(key: KeyOptions, operations: operations.Operation[] | operations.BoundOperations, metadata?: RecordMetadata | null, policy?: policy.OperatePolicy | null): Promise<AerospikeRecord<B>>;
     /**
      * @param key - The key of the record.
      * @param operations - List of {@link operations.Operation | Operations} to perform on the record.
@@ -5666,7 +5862,7 @@ export class Client extends EventEmitter {
      * command completes with the results of the command; if no callback
      * function is provided, the method returns a <code>Promise<code> instead.
      */
-    public operate<B extends AerospikeBins = AerospikeBins>(key: KeyOptions, operations: operations.Operation[], callback: TypedCallback<AerospikeRecord<B>>): void;
+    public operate<B extends AerospikeBins = AerospikeBins>(key: KeyOptions, operations: operations.Operation[] | operations.BoundOperations, callback: TypedCallback<AerospikeRecord<B>>): void;
     /**
      * @param key - The key of the record.
      * @param operations - List of {@link operations.Operation | Operations} to perform on the record.
@@ -5675,7 +5871,7 @@ export class Client extends EventEmitter {
      * command completes with the results of the command; if no callback
      * function is provided, the method returns a <code>Promise<code> instead.
      */
-    public operate<B extends AerospikeBins = AerospikeBins>(key: KeyOptions, operations: operations.Operation[], metadata: RecordMetadata, callback: TypedCallback<AerospikeRecord<B>>): void;
+    public operate<B extends AerospikeBins = AerospikeBins>(key: KeyOptions, operations: operations.Operation[] | operations.BoundOperations, metadata: RecordMetadata, callback: TypedCallback<AerospikeRecord<B>>): void;
     /**
      * @param key - The key of the record.
      * @param operations - List of {@link operations.Operation | Operations} to perform on the record.
@@ -5685,7 +5881,7 @@ export class Client extends EventEmitter {
      * command completes with the results of the command; if no callback
      * function is provided, the method returns a <code>Promise<code> instead.
      */
-    public operate<B extends AerospikeBins = AerospikeBins>(key: KeyOptions, operations: operations.Operation[], metadata: RecordMetadata | null, policy: policy.OperatePolicy | null, callback: TypedCallback<AerospikeRecord<B>>): void;
+    public operate<B extends AerospikeBins = AerospikeBins>(key: KeyOptions, operations: operations.Operation[] | operations.BoundOperations, metadata: RecordMetadata | null, policy: policy.OperatePolicy | null, callback: TypedCallback<AerospikeRecord<B>>): void;
     /**
      * Shortcut for applying the {@link
      * operations.append} operation to one or more record bins.
@@ -6329,6 +6525,12 @@ export class Client extends EventEmitter {
      *
      */
     public stats(): Stats;
+    /**
+     * Resets the latency histograms reported by {@link Client#stats}.
+     *
+     * @since v6.4.0
+     */
+    public resetStats(): void;
     /**
      * Removes a UDF module from the cluster.
      *
@@ -7762,6 +7964,54 @@ export class Config {
      * }
      */
     public sharedMemory?: SharedMemory;
+    /**
+     * Key under which the client's cluster connection is shared with other
+     * clients in the same process, e.g. clients created in worker threads.
+     * Clients with the same key use a single cluster tender and set of
+     * connection pools. All of them must use the same configuration, apart
+     * from log, readCache and readBatching. Clients using a shared cluster do
+     * not emit cluster events.
+     *
+     * @since v6.4.0
+     */
+    public sharedCluster?: string;
+    /**
+     * Pipelining of single-record commands.
+     *
+     * With pipelining enabled, get, select, exists, put, remove, operate and
+     * apply commands share pipeline connections: a command is written to a
+     * connection while earlier commands on it are still waiting for their
+     * response. This needs far fewer connections per node for high volumes
+     * of small commands. Once <code>maxDepth</code> commands per node are in
+     * flight on pipeline connections, further commands are sent on regular
+     * async connections.
+     *
+     * @since v6.4.0
+     */
+    public pipeline?: PipelineConfig;
+    /**
+     * Coalescing of single-key reads into batch reads.
+     *
+     * When set, get, select and exists calls issued within the same window
+     * are sent as a single batch read per read policy, and the results are
+     * returned to the individual callbacks or promises. Reads with a frozen
+     * policy or a transaction are not batched.
+     *
+     * @since v6.4.0
+     */
+    public readBatching?: ReadBatchingConfig;
+    /**
+     * Client-side cache of records read by the client, keyed by namespace and
+     * digest.
+     *
+     * Cached records are served for get and select, and for batchGet and
+     * batchRead if all records are cached. Records expire with their TTL or
+     * after <code>maxStaleness</code> ms. Writes through this client
+     * invalidate the record.
+     *
+     * @since v6.4.0
+     */
+    public readCache?: ReadCacheConfig;
 
     /**
      * Polling interval in milliseconds for cluster tender.
@@ -8522,9 +8772,36 @@ export class RecordStream extends Stream {
      * A {@link Client} instance.
      */
     public client: Client;
+    /**
+     * <code>true</code> if the stream has been paused; <code>false</code> otherwise.
+     *
+     * @since v6.4.0
+     */
+    public paused: boolean;
+    /**
+     * Maximum number of records requested from the cluster ahead of the
+     * consumer, if the stream is flow-controlled.
+     *
+     * @since v6.4.0
+     */
+    public highWaterMark?: number;
     public writable: false;
     public readable: true;
     public _read(): void;
+    /**
+     * Stops emitting <code>data</code> events until the stream is resumed.
+     * Records received in the meantime are buffered. If the stream is
+     * flow-controlled, no further records are requested from the cluster.
+     *
+     * @since v6.4.0
+     */
+    public pause(): this;
+    /**
+     * Resumes emitting <code>data</code> events, starting with any buffered records.
+     *
+     * @since v6.4.0
+     */
+    public resume(): this;
     /**
      * Aborts the query/scan command.
      *
@@ -8567,6 +8844,16 @@ export interface ScanOptions {
      * returned. See {@link Scan#nobins}.
      */
     nobins?: boolean;
+    /**
+     * Number of records to deliver from the native client at a time.
+     * See {@link Scan#recordsPerCallback}.
+     */
+    recordsPerCallback?: number;
+    /**
+     * Maximum number of records to request ahead of the consumer of the
+     * record stream. See {@link Scan#highWaterMark}.
+     */
+    highWaterMark?: number;
     /**
      * Whether all cluster nodes
      * should be scanned concurrently. See {@link Scan#concurrent}.
@@ -8719,6 +9006,22 @@ export class Scan {
      *
      */
     public nobins?: boolean;
+    /**
+     * Maximum number of records to pass from the native client to JavaScript
+     * at a time when the scan is executed using {@link Scan#foreach}.
+     *
+     * @since v6.4.0
+     */
+    public recordsPerCallback?: number;
+    /**
+     * If set, the {@link RecordStream} returned by {@link Scan#foreach}
+     * requests the records in pages of at most this many records and only
+     * requests the next page while the stream is not paused.
+     * Not supported for paginated scans.
+     *
+     * @since v6.4.0
+     */
+    public highWaterMark?: number;
       /**
        * If set to <code>true</code>, all cluster nodes will be scanned in parallel.
        *
@@ -9132,6 +9435,12 @@ export function print(err: Error, result: any): void;
  * then the clients need to be closed with <code>releaseEventLoop</code> set
  * to <code>false</code> and the event loop needs to be released explicitly by
  * calling <code>releaseEventLoop()</code>.
+ *
+ * In a worker thread, releasing the event loop returns it to a pool once the
+ * worker's commands have completed, so that it can be reused by another
+ * worker; this also happens when the worker exits. Up to 256 threads, incl.
+ * the main thread, can use an event loop at the same time. Worker threads are
+ * not supported on Windows.
  */
 export function releaseEventLoop(): void;
 /**
@@ -9261,6 +9570,77 @@ export function connect(config: ConfigOptions, callback: TypedCallback<Client>):
  * })
  */
 export function setDefaultLogging(logInfo: Log): void;
+/**
+ * Options for {@link setAsyncLogging}.
+ *
+ * @since v6.4.0
+ */
+export interface AsyncLoggingOptions {
+    /**
+     * Whether to log asynchronously.
+     *
+     * @default true
+     */
+    enabled?: boolean;
+    /**
+     * Number of log lines the buffer holds. Only used the first time async
+     * logging is enabled.
+     *
+     * @default 1024
+     */
+    bufferSize?: number;
+    /**
+     * Wait for space in a full buffer instead of dropping lines.
+     *
+     * @default false
+     */
+    block?: boolean;
+}
+/**
+ * Statistics returned by {@link getAsyncLoggingStats}.
+ *
+ * @since v6.4.0
+ */
+export interface AsyncLoggingStats {
+    /**
+     * Number of log lines dropped because the buffer was full.
+     */
+    dropped: number;
+}
+/**
+ * Enables or disables asynchronous logging. (Disabled by default.)
+ *
+ * While async logging is enabled, log lines of all clients and of the
+ * Aerospike C client SDK are formatted into an in-memory buffer and written
+ * to their log files by a background thread. If the buffer is full, new
+ * lines are dropped, unless <code>block</code> is set.
+ *
+ * @param options - Async logging options.
+ *
+ * @since v6.4.0
+ */
+export function setAsyncLogging(options?: AsyncLoggingOptions): void;
+/**
+ * Returns statistics about asynchronous logging.
+ *
+ * @since v6.4.0
+ */
+export function getAsyncLoggingStats(): AsyncLoggingStats;
+/**
+ * Enables or disables async resources for client commands. (Enabled by
+ * default.)
+ *
+ * Without an async resource per command, command callbacks are called without
+ * async context, so <code>async_hooks</code> and
+ * <code>AsyncLocalStorage</code> cannot follow them. Promises returned by
+ * client commands are not affected. The setting applies to commands started
+ * afterwards on the current thread.
+ *
+ * @param enabled - Whether to create an async resource per command.
+ *
+ * @since v6.4.0
+ */
+export function setAsyncResourcesEnabled(enabled: boolean): void;
 /**
  * Configures the global command queue. (Disabled by default.)
  *
@@ -9376,7 +9756,7 @@ export interface BasePolicyOptions {
      * * {@link Client.remove}
      * * {@link Client.select}
      */
-    filterExpression?: AerospikeExp;
+    filterExpression?: AerospikeExp | CompiledExpression;
     /**
      * Maximum number of retries before aborting the current command.
      * The initial attempt is not counted as a retry.
@@ -9461,7 +9841,7 @@ export interface BatchApplyPolicyOptions {
      * command is ignored. This can be used to eliminate a client/server roundtrip
      * in some cases.
      */
-    filterExpression?: AerospikeExp;
+    filterExpression?: AerospikeExp | CompiledExpression;
     /**
      * Specifies the behavior for the key.
      *
@@ -9603,7 +9983,7 @@ export interface BatchReadPolicyOptions {
      * command is ignored. This can be used to eliminate a client/server roundtrip
      * in some cases.
      */
-    filterExpression?: AerospikeExp;
+    filterExpression?: AerospikeExp | CompiledExpression;
     /**
      * Read policy for AP (availability) namespaces.
      *
@@ -9663,6 +10043,69 @@ export interface BatchReadRecord {
     readAllBins?: boolean;
 }
 
+/**
+ * Options for {@link Client#batchReadStream}.
+ *
+ * @since v6.4.0
+ */
+export interface BatchStreamOptions {
+    /**
+     * Maximum number of records per sub-batch.
+     *
+     * @default 1000
+     */
+    chunkSize?: number;
+    /**
+     * Maximum number of sub-batches in flight or awaiting consumption.
+     *
+     * @default 4
+     */
+    concurrency?: number;
+}
+
+/**
+ * The results of one sub-batch of {@link Client#batchReadStream}.
+ *
+ * @since v6.4.0
+ */
+export interface BatchResultPart {
+    /**
+     * Position of the first result in the records passed to
+     * {@link Client#batchReadStream}.
+     */
+    index: number;
+    /**
+     * The results of the sub-batch, in the order of its records.
+     */
+    results: BatchResult[];
+}
+
+/**
+ * What {@link Client#batchReadUniform} reads for every key.
+ *
+ * @since v6.4.0
+ */
+export interface BatchReadUniform {
+    /**
+     * List of bins to retrieve.
+     */
+    bins?: string[];
+    /**
+     * List of read {@link operations|operations}; cannot be combined with
+     * <code>bins</code>.
+     */
+    ops?: operations.Operation[];
+    /**
+     * The policy of every read.
+     */
+    policy?: policy.BatchReadPolicy | BatchReadPolicyOptions;
+    /**
+     * Whether to retrieve all bins. If false and neither <code>bins</code>
+     * nor <code>ops</code> are specified, only record meta data is read.
+     */
+    readAllBins?: boolean;
+}
+
 /**
  * Option specification for {@ link AdminPolicy} class values.
  */
@@ -9689,7 +10132,7 @@ export interface BatchRemovePolicyOptions {
      * in some cases.
      *
      */
-    filterExpression?: AerospikeExp;
+    filterExpression?: AerospikeExp | CompiledExpression;
     /**
      * Specifies the behavior for the generation value.
      *
@@ -9739,7 +10182,7 @@ export interface BatchWritePolicyOptions extends BasePolicyOptions {
      * command is ignored. This can be used to eliminate a client/server roundtrip
      * in some cases.
      */
-    filterExpression?: AerospikeExp;
+    filterExpression?: AerospikeExp | CompiledExpression;
     /**
      * Specifies the behavior for the generation value.
      *
@@ -10219,6 +10662,54 @@ export interface ConfigOptions {
      * }
      */
     sharedMemory?: SharedMemory;
+    /**
+     * Key under which the client's cluster connection is shared with other
+     * clients in the same process, e.g. clients created in worker threads.
+     * Clients with the same key use a single cluster tender and set of
+     * connection pools. All of them must use the same configuration, apart
+     * from log, readCache and readBatching. Clients using a shared cluster do
+     * not emit cluster events.
+     *
+     * @since v6.4.0
+     */
+    sharedCluster?: string;
+    /**
+     * Pipelining of single-record commands.
+     *
+     * With pipelining enabled, get, select, exists, put, remove, operate and
+     * apply commands share pipeline connections: a command is written to a
+     * connection while earlier commands on it are still waiting for their
+     * response. This needs far fewer connections per node for high volumes
+     * of small commands. Once <code>maxDepth</code> commands per node are in
+     * flight on pipeline connections, further commands are sent on regular
+     * async connections.
+     *
+     * @since v6.4.0
+     */
+    pipeline?: PipelineConfig;
+    /**
+     * Coalescing of single-key reads into batch reads.
+     *
+     * When set, get, select and exists calls issued within the same window
+     * are sent as a single batch read per read policy, and the results are
+     * returned to the individual callbacks or promises. Reads with a frozen
+     * policy or a transaction are not batched.
+     *
+     * @since v6.4.0
+     */
+    readBatching?: ReadBatchingConfig;
+    /**
+     * Client-side cache of records read by the client, keyed by namespace and
+     * digest.
+     *
+     * Cached records are served for get and select, and for batchGet and
+     * batchRead if all records are cached. Records expire with their TTL or
+     * after <code>maxStaleness</code> ms. Writes through this client
+     * invalidate the record.
+     *
+     * @since v6.4.0
+     */
+    readCache?: ReadCacheConfig;
 
     /**
      * Polling interval in milliseconds for cluster tender.
@@ -10441,6 +10932,13 @@ export interface EventLoopStats {
      * on the global command queue, that have not yet been started.
      */
     queued: number;
+    /**
+     * Number of commands in flight on pipeline connections; see
+     * {@link Config#pipeline}.
+     *
+     * @since v6.4.0
+     */
+    pipelined: number;
 }
 
 /**
@@ -11063,6 +11561,21 @@ export interface QueryOptions {
      * If set to `true`, the query will return only meta data, and exclude bins.
      */
     nobins?: boolean;
+    /**
+     * Number of records to deliver from the native client at a time.
+     * See {@link Query#recordsPerCallback}.
+     */
+    recordsPerCallback?: number;
+    /**
+     * Maximum number of records to request ahead of the consumer of the
+     * record stream. See {@link Query#highWaterMark}.
+     */
+    highWaterMark?: number;
+    /**
+     * Maximum number of stream UDF results to buffer.
+     * See {@link Query#maxQueueSize}.
+     */
+    maxQueueSize?: number;
     /**
      * Approximate number of records to return to client.
      *
@@ -11448,6 +11961,109 @@ export interface ScanPolicyOptions extends BasePolicyOptions {
 /**
  * Interface used to configure shared memory.
  */
+/**
+ * Pipelining settings; see {@link Config#pipeline}.
+ *
+ * @since v6.4.0
+ */
+export interface PipelineConfig {
+    /**
+     * Whether to pipeline single-record commands.
+     *
+     * @default true
+     */
+    enabled?: boolean;
+    /**
+     * Maximum number of pipeline connections per server node.
+     *
+     * @default 64
+     */
+    maxConnsPerNode?: number;
+    /**
+     * Maximum number of pipelined commands in flight per server node; 0 means
+     * no limit.
+     *
+     * @default 0
+     */
+    maxDepth?: number;
+}
+
+/**
+ * Read batching settings; see {@link Config#readBatching}.
+ *
+ * @since v6.4.0
+ */
+export interface ReadBatchingConfig {
+    /**
+     * Time in milliseconds to collect reads for; 0 collects the reads issued
+     * in the same event loop iteration.
+     *
+     * @default 0
+     */
+    window?: number;
+    /**
+     * Maximum number of reads per batch.
+     *
+     * @default 100
+     */
+    maxKeys?: number;
+}
+
+/**
+ * Record cache settings; see {@link Config#readCache}.
+ *
+ * @since v6.4.0
+ */
+export interface ReadCacheConfig {
+    /**
+     * Approximate maximum memory used by cached records, in bytes.
+     *
+     * @default 67108864
+     */
+    maxMemory?: number;
+    /**
+     * Maximum time in milliseconds a record is served from the cache after it
+     * was read.
+     *
+     * @default 1000
+     */
+    maxStaleness?: number;
+    /**
+     * Number of independently locked and evicted cache shards.
+     *
+     * @default 16
+     */
+    shards?: number;
+}
+
+/**
+ * Record cache stats; see {@link Config#readCache}.
+ *
+ * @since v6.4.0
+ */
+export interface ReadCacheStats {
+    /**
+     * Number of reads served from the cache.
+     */
+    hits: number;
+    /**
+     * Number of cacheable reads that were not cached.
+     */
+    misses: number;
+    /**
+     * Number of records evicted to stay within the memory budget.
+     */
+    evictions: number;
+    /**
+     * Number of cached records.
+     */
+    entries: number;
+    /**
+     * Estimated memory held by cached records, in bytes.
+     */
+    memory: number;
+}
+
 export interface SharedMemory {
     /**
      * Whether to enable/disable usage of
@@ -11490,12 +12106,143 @@ export interface Stats {
      * Statistics relating to the event loop.
      */
     commands: EventLoopStats;
+    /**
+     * Number of event loops registered with the client library, incl. the
+     * loops of worker threads that have exited, which later workers reuse.
+     *
+     * @since v6.4.0
+     */
+    eventLoops: number;
     /**
      * Statistics relating to individual Node usage.
      */
     nodes: NodeStats[];
+    /**
+     * Latency histograms of the commands sent by the client, in microseconds.
+     *
+     * @since v6.4.0
+     */
+    latency: LatencyStats;
+    /**
+     * Record cache stats, if the client has a {@link Config#readCache}.
+     *
+     * @since v6.4.0
+     */
+    cache?: ReadCacheStats;
+    /**
+     * Native memory held by the client library, per subsystem. The counters
+     * are shared by all clients of the process.
+     *
+     * @since v6.4.0
+     */
+    memory: MemoryStats;
+}
+
+/**
+ * Estimated native memory currently held by a subsystem of the client.
+ *
+ * @since v6.4.0
+ */
+export interface MemoryUsage {
+    /**
+     * Estimated memory, in bytes.
+     */
+    bytes: number;
+    /**
+     * Number of live allocations.
+     */
+    count: number;
+}
+
+/**
+ * Native memory held by the client library, per subsystem. Memory held by
+ * compiled expressions, prepared operations, transactions, conversion
+ * buffers and the record cache is also reported to V8 as external memory,
+ * so that it is taken into account by the garbage collector.
+ *
+ * @since v6.4.0
+ */
+export interface MemoryStats {
+    /**
+     * Buffers retained for converting command arguments, and prepared
+     * operation lists.
+     */
+    conversion: MemoryUsage;
+    /**
+     * Record lists of batch commands in flight.
+     */
+    batch: MemoryUsage;
+    /**
+     * Query and scan results waiting to be handed to JS.
+     */
+    scanQueue: MemoryUsage;
+    /**
+     * Transactions that have not been closed.
+     */
+    txn: MemoryUsage;
+    /**
+     * Compiled expressions and the filter expressions of frozen policies.
+     */
+    expression: MemoryUsage;
+    /**
+     * Records held by the record cache.
+     */
+    cache: MemoryUsage;
+}
+
+/**
+ * Summary of a latency histogram, in microseconds. Values are recorded with a
+ * precision of 1/8. Only count is set if no command has been recorded.
+ *
+ * @since v6.4.0
+ */
+export interface LatencyHistogram {
+    count: number;
+    mean?: number;
+    p50?: number;
+    p90?: number;
+    p99?: number;
+    p999?: number;
+    max?: number;
+}
+
+/**
+ * Latency histograms of a command type, per phase.
+ *
+ * @since v6.4.0
+ */
+export interface LatencyPhases {
+    /**
+     * Converting the arguments and submitting the command.
+     */
+    request: LatencyHistogram;
+    /**
+     * From submitting the command until the response (for scans and queries,
+     * the first record) has been received, incl. any time spent queued.
+     */
+    roundTrip: LatencyHistogram;
+    /**
+     * Converting the response and passing it to the callback.
+     */
+    response: LatencyHistogram;
+    /**
+     * From the start of the request until the callback has returned.
+     */
+    total: LatencyHistogram;
 }
 
+export type LatencyCommandType = 'get' | 'put' | 'remove' | 'operate' | 'apply' | 'batch' | 'scan' | 'query' | 'info';
+
+/**
+ * Latency histograms per command type and phase, and total latency histograms
+ * per namespace and command type.
+ *
+ * @since v6.4.0
+ */
+export type LatencyStats = Record<LatencyCommandType, LatencyPhases> & {
+    namespaces: Record<string, Record<LatencyCommandType, LatencyHistogram>>;
+};
+
 /**
  * Configure Transport Layer Security (TLS) parameters for secure
  * connections to the database cluster. TLS connections are not supported as
@@ -17142,6 +17889,17 @@ export namespace exp {
  * @return value stored in variable.
  */
     export const _var: (varName: string) => AerospikeExp;
+/**
+ * Compiles a filter expression once so that it can be reused by any number
+ * of policies without being recompiled for every command.
+ *
+ *
+ * @param expr - The filter expression to compile.
+ * @return The compiled filter expression.
+ *
+ * @since v6.4.0
+ */
+    export const compile: (expr: AerospikeExp) => CompiledExpression;
 }
 /**
  * @remarks This module provides functions to easily define operations to
@@ -17235,7 +17993,7 @@ export namespace operations {
      * @param value - The value to set the bin to.
      * @returns Operation that can be passed to the {@link Client#operate} command.
      */
-    export function write(bin: string, value: AerospikeBinValue): Operation;
+    export function write(bin: string, value: AerospikeBinValue | OperationParam): Operation;
     /**
      * Increment the value of the bin by the given value.
      *
@@ -17246,11 +18004,11 @@ export namespace operations {
      * @param value - The <code>number</code>|{@link Double} value to increment the bin by.
      * @returns Operation that can be passed to the {@link Client#operate} command.
      */
-    export function add(bin: string, value: number | Double): Operation;
+    export function add(bin: string, value: number | Double | OperationParam): Operation;
     /**
      * Alias for the {@link operations.add} operation.
      */
-    export function incr(bin: string, value: number | Double): Operation;
+    export function incr(bin: string, value: number | Double | OperationParam): Operation;
     /**
      * Append the value to the bin.
      *
@@ -17261,7 +18019,7 @@ export namespace operations {
      * @param value - The value to append to the bin.
      * @returns Operation that can be passed to the {@link Client#operate} command.
      */
-    export function append(bin: string, value: string | Buffer): Operation;
+    export function append(bin: string, value: string | Buffer | OperationParam): Operation;
     /**
      * Prepend the value to the bin.
      *
@@ -17272,7 +18030,7 @@ export namespace operations {
      * @param value - The value to prepend to the bin.
      * @returns Operation that can be passed to the {@link Client#operate} command.
      */
-    export function prepend(bin: string, value: string | Buffer): Operation;
+    export function prepend(bin: string, value: string | Buffer | OperationParam): Operation;
     /**
      * Update the TTL (time-to-live) for a record.
      *
@@ -17297,6 +18055,89 @@ export namespace operations {
      */
     function deleteOp(): Operation;
     export {deleteOp as delete}
+    /**
+     * A placeholder for a value that is bound when a prepared operation list
+     * is executed.
+     *
+     * @see {@link operations.param}
+     * @since v6.4.0
+     */
+    export class OperationParam {
+        private constructor();
+        /**
+         * The index of the parameter's value in the values passed to
+         * {@link PreparedOperations#bind}.
+         */
+        public index: number;
+    }
+    /**
+     * Prepared operations together with the values of their parameters.
+     *
+     * @since v6.4.0
+     */
+    export class BoundOperations {
+        private constructor();
+    }
+    /**
+     * A list of operations converted once by {@link operations.prepare}.
+     *
+     * @since v6.4.0
+     */
+    export class PreparedOperations {
+        private constructor();
+        /**
+         * The number of parameter values {@link bind} expects.
+         */
+        public readonly params: number;
+        /**
+         * Binds values to the parameters of the prepared operations.
+         *
+         * @param values - The parameter values, by parameter index.
+         * @returns Operations that can be passed to the {@link Client#operate} command.
+         */
+        public bind(values: any[]): BoundOperations;
+    }
+    /**
+     * Creates a parameter for a prepared operation list.
+     *
+     * @remarks A parameter can replace the value of a scalar write, add,
+     * append or prepend operation, or a value argument of a List or Map
+     * operation, e.g. the value of {@link lists.append} or the key and value
+     * of {@link maps.put}. It cannot replace bin names, indexes, ranks,
+     * counts, contexts or policies, which are fixed when the operations are
+     * prepared, nor values nested in other values.
+     *
+     * @param index - The index of the parameter's value in the values passed
+     * to {@link PreparedOperations#bind}.
+     *
+     * @since v6.4.0
+     */
+    export function param(index: number): OperationParam;
+    /**
+     * Converts a list of operations to its native representation once, so
+     * that it can be executed many times with different values.
+     *
+     * @remarks Bin names, CDT contexts and CDT policies of the operations are
+     * converted only once. On each execution, only the values bound to the
+     * parameters are converted.
+     *
+     * @param operations - The operations, with the values that change between
+     * executions replaced by {@link operations.param | parameters}.
+     *
+     * @example
+     *
+     * ```typescript
+     * const visit = op.prepare([
+     *   op.incr('visits', op.param(0)),
+     *   lists.append('pages', op.param(1) as any),
+     *   op.read('visits')
+     * ])
+     * const record = await client.operate(key, visit.bind([1, '/home']))
+     * ```
+     *
+     * @since v6.4.0
+     */
+    export function prepare(operations: Operation[]): PreparedOperations;
 
 }
 